@@ -49,6 +49,11 @@ invalid_mechanism_kind::invalid_mechanism_kind(arb_mechanism_kind kind):
     kind(kind)
 {}
 
+bad_cell_description_count::bad_cell_description_count(std::size_t num_cells, std::size_t num_descriptions):
+    arbor_exception(pprintf("recipe::get_cell_descriptions returned {} descriptions for a group of {} cells", num_descriptions, num_cells)),
+    num_cells(num_cells), num_descriptions(num_descriptions)
+{}
+
 bad_connection_source_gid::bad_connection_source_gid(cell_gid_type gid, cell_gid_type src_gid, cell_size_type num_cells):
     arbor_exception(pprintf("Model building error on cell {}: connection source gid {} is out of range: there are {} cells in the model, in the range [{}:{}].", gid, src_gid, num_cells, 0, num_cells-1)),
     gid(gid), src_gid(src_gid), num_cells(num_cells)
@@ -60,11 +65,21 @@ source_gid_exceeds_limit::source_gid_exceeds_limit(cell_gid_type gid, cell_gid_t
     gid(gid), src_gid(src_gid)
 {}
 
+bad_connection_target_gid::bad_connection_target_gid(cell_gid_type gid):
+    arbor_exception(pprintf("Model building error on cell {}: connection target is not a cell local to this domain.", gid)),
+    gid(gid)
+{}
+
 bad_connection_label::bad_connection_label(cell_gid_type gid, const cell_tag_type& label, const std::string& msg):
     arbor_exception(pprintf("Model building error on cell {}: connection endpoint label \"{}\": {}.", gid, label, msg)),
     gid(gid), label(label)
 {}
 
+bad_connection_columns::bad_connection_columns(cell_gid_type gid_begin, cell_gid_type gid_end, const std::string& msg):
+    arbor_exception(pprintf("Model building error on cells [{}:{}): connection columns {}.", gid_begin, gid_end, msg)),
+    gid_begin(gid_begin), gid_end(gid_end)
+{}
+
 bad_global_property::bad_global_property(cell_kind kind):
     arbor_exception(pprintf("bad global property for cell kind {}", kind)),
     kind(kind)
@@ -194,6 +209,11 @@ bad_catalogue_error::bad_catalogue_error(const std::string& msg, const std::any&
     : arbor_exception(pprintf("Error while opening catalogue '{}'", msg)), platform_error(pe)
 {}
 
+catalogue_compile_error::catalogue_compile_error(const std::string& command, const std::string& log)
+    : arbor_exception(pprintf("Error while compiling catalogue, '{}' failed:\n{}", command, log)),
+      command(command), log(log)
+{}
+
 unsupported_abi_error::unsupported_abi_error(size_t v):
     arbor_exception(pprintf("ABI version is not supported by this version of arbor '{}'", v)),
     version{v} {}
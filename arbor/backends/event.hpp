@@ -76,9 +76,13 @@ inline arb_deliverable_event_stream make_event_stream_state(arb_deliverable_even
 
 using probe_handle = const arb_value_type*;
 
+// Handles are registered once with the back-end in a table of sample handles;
+// a sample event then copies the values of a contiguous run of handles into
+// consecutive entries of the sample buffer.
 struct raw_probe_info {
-    probe_handle handle;      // where the to-be-probed value sits
-    sample_size_type offset;  // offset into array to store raw probed value
+    sample_size_type handle_offset; // index of first handle in the sample handle table
+    sample_size_type n_handle;      // number of handles to sample
+    sample_size_type offset;        // offset into array to store first raw probed value
 };
 
 struct sample_event {
@@ -33,7 +33,7 @@ namespace gpu {
 
 void take_samples_impl(
     const event_stream_state<raw_probe_info>& s,
-    const arb_value_type& time, arb_value_type* sample_time, arb_value_type* sample_value);
+    const arb_value_type& time, const probe_handle* handles, arb_value_type* sample_time, arb_value_type* sample_value);
 
 void add_scalar(std::size_t n, arb_value_type* data, arb_value_type v);
 
@@ -272,7 +272,7 @@ void shared_state::instantiate(mechanism& m,
     // Allocate and initialize state and parameter vectors with default values.
     {
         // Allocate bulk storage
-        std::size_t count = (m.mech_.n_state_vars + m.mech_.n_parameters + 1)*width_padded + m.mech_.n_globals;
+        std::size_t count = (m.mech_.n_state_vars + m.mech_.n_parameters + 1)*width_padded + m.mech_.n_globals + m.mech_.n_table_values;
         store.data_ = array(count, NAN);
         chunk_writer writer(store.data_.data(), width_padded);
 
@@ -309,6 +309,8 @@ void shared_state::instantiate(mechanism& m,
             if (!found) throw arbor_internal_error(util::pprintf("gpu/mechanism: no such mechanism global '{}'", k));
         }
         m.ppack_.globals = writer.append_freely(store.globals_);
+        // Tables are filled by init_mechanism.
+        m.ppack_.tables = writer.end;
     }
 
     // Allocate and initialize index vectors, viz. node_index_ and any ion indices.
@@ -381,11 +383,26 @@ std::pair<arb_value_type, arb_value_type> shared_state::voltage_bounds() const {
     return minmax_value_impl(n_cv, voltage.data());
 }
 
+sample_size_type shared_state::add_sample_handles(const probe_handle* begin, const probe_handle* end) {
+    sample_size_type offset = sample_handles_host.size();
+    sample_handles_host.insert(sample_handles_host.end(), begin, end);
+    return offset;
+}
+
+const arb_value_type* shared_state::add_reduction(const std::vector<probe_handle>&,
+                                                 const std::vector<arb_value_type>&,
+                                                 const std::vector<arb_value_type>&) {
+    throw arbor_exception("reduction probes are not supported on the GPU back-end");
+}
+
 void shared_state::take_samples() {
     sample_events.mark();
     if (!sample_events.empty()) {
+        if (sample_handles.size()!=sample_handles_host.size()) {
+            sample_handles = memory::device_vector<probe_handle>(make_const_view(sample_handles_host));
+        }
         const auto state = sample_events.marked_events();
-        take_samples_impl(state, time, sample_time.data(), sample_value.data());
+        take_samples_impl(state, time, sample_handles.data(), sample_time.data(), sample_value.data());
     }
 }
 
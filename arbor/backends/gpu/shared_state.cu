@@ -28,6 +28,7 @@ __global__ void take_samples_impl(
     const raw_probe_info* __restrict__ const begin_marked,
     const raw_probe_info* __restrict__ const end_marked,
     const arb_value_type time,
+    const probe_handle* __restrict__ const handles,
     arb_value_type* __restrict__ const sample_time,
     arb_value_type* __restrict__ const sample_value)
 {
@@ -35,8 +36,11 @@ __global__ void take_samples_impl(
     const unsigned nsamples = end_marked - begin_marked;
     if (i<nsamples) {
         const auto p = begin_marked+i;
-        sample_time[p->offset] = time;
-        sample_value[p->offset] = p->handle? *p->handle: 0;
+        const auto h = handles+p->handle_offset;
+        for (unsigned k = 0; k<p->n_handle; ++k) {
+            sample_time[p->offset+k] = time;
+            sample_value[p->offset+k] = h[k]? *h[k]: 0;
+        }
     }
 }
 
@@ -48,9 +52,9 @@ void add_scalar(std::size_t n, arb_value_type* data, arb_value_type v) {
 
 void take_samples_impl(
     const event_stream_state<raw_probe_info>& s,
-    const arb_value_type& time, arb_value_type* sample_time, arb_value_type* sample_value)
+    const arb_value_type& time, const probe_handle* handles, arb_value_type* sample_time, arb_value_type* sample_value)
 {
-    launch_1d(s.size(), 128, kernel::take_samples_impl, s.begin_marked, s.end_marked, time, sample_time, sample_value);
+    launch_1d(s.size(), 128, kernel::take_samples_impl, s.begin_marked, s.end_marked, time, handles, sample_time, sample_value);
 }
 
 } // namespace gpu
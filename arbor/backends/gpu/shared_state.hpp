@@ -163,6 +163,8 @@ struct ARB_ARBOR_API shared_state: shared_state_base<shared_state, array, ion_st
     sample_event_stream sample_events;
     array sample_time;
     array sample_value;
+    memory::device_vector<probe_handle> sample_handles; // Handles referred to by sample events.
+    std::vector<probe_handle> sample_handles_host;      // Host copy, uploaded lazily.
     threshold_watcher watcher;
 
     // Host-side views/copies and local state.
@@ -232,6 +234,14 @@ struct ARB_ARBOR_API shared_state: shared_state_base<shared_state, array, ion_st
     // (Used for solution bounds checking.)
     std::pair<arb_value_type, arb_value_type> voltage_bounds() const;
 
+    // Append to the table of sample handles, returning the index of the first.
+    sample_size_type add_sample_handles(const probe_handle* begin, const probe_handle* end);
+
+    // Reductions are only implemented by the multicore back-end; always throws.
+    const arb_value_type* add_reduction(const std::vector<probe_handle>& handles,
+                                        const std::vector<arb_value_type>& weights,
+                                        const std::vector<arb_value_type>& edges = {});
+
     // Take samples according to marked events in a sample_event_stream.
     void take_samples();
 
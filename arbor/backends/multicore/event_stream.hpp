@@ -14,6 +14,7 @@ class event_stream : public event_stream_base<Event, util::range<::arb::event_da
 public:
     using base = event_stream_base<Event, util::range<::arb::event_data_type<Event>*>>;
     using size_type = typename base::size_type;
+    using event_data_type = typename base::event_data_type;
 
     event_stream() = default;
 
@@ -43,6 +44,12 @@ public:
             for (const auto& ev : v) {
                 base::ev_data_.push_back(event_data(ev));
             }
+            // sort by target, keeping time order per target, so that mechanisms
+            // can aggregate events for the same instance
+            if constexpr (has_event_index<Event>::value) {
+                util::stable_sort_by(util::make_range(ptr, ptr + v.size()),
+                                     [](const event_data_type& ed) { return event_index(ed); });
+            }
         }
 
         arb_assert(num_events == base::ev_data_.size());
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <unordered_map>
@@ -257,14 +258,60 @@ std::pair<arb_value_type, arb_value_type> shared_state::voltage_bounds() const {
     return util::minmax_value(voltage);
 }
 
+sample_size_type shared_state::add_sample_handles(const probe_handle* begin, const probe_handle* end) {
+    sample_size_type offset = sample_handles.size();
+    sample_handles.insert(sample_handles.end(), begin, end);
+    reduction_index.add_handles(begin, end);
+    return offset;
+}
+
+const arb_value_type* shared_state::add_reduction(const std::vector<probe_handle>& handles,
+                                                 const std::vector<arb_value_type>& weights,
+                                                 const std::vector<arb_value_type>& edges) {
+    auto r = reductions.add(handles, weights, edges);
+    reduction_value.emplace_back(reductions.width(r), 0.);
+    reduction_index.add_results(reduction_value.back().data(), reductions.width(r), r);
+    return reduction_value.back().data();
+}
+
 void shared_state::take_samples() {
     sample_events.mark();
     if (!sample_events.empty()) {
         const auto [begin, end] = sample_events.marked_events();
+
+        // Reduce first, as sample events may refer to reduction results. Only
+        // the reductions read by the marked events are evaluated.
+        const auto& R = reductions;
+        if (R.size()) reduction_index.collect(begin, end, active_reductions);
+        for (auto r: active_reductions) {
+            arb_value_type* out = reduction_value[r].data();
+            const auto t_begin = R.term_divs[r], t_end = R.term_divs[r+1];
+            const arb_value_type* lo = R.edge.data()+R.edge_divs[r];
+            const arb_value_type* hi = R.edge.data()+R.edge_divs[r+1];
+
+            if (lo==hi) {
+                arb_value_type sum = 0;
+                for (auto i = t_begin; i<t_end; ++i) sum += R.weight[i]*(*R.handle[i]);
+                out[0] = sum;
+            }
+            else {
+                std::fill(out, out+(hi-lo-1), 0.);
+                for (auto i = t_begin; i<t_end; ++i) {
+                    auto b = std::upper_bound(lo, hi, *R.handle[i])-lo;
+                    if (b>0 && lo+b<hi) out[b-1] += R.weight[i];
+                }
+            }
+        }
+
         // Null handles are explicitly permitted, and always give a sample of zero.
         for (auto p = begin; p<end; ++p) {
-            sample_time[p->offset] = time;
-            sample_value[p->offset] = p->handle? *p->handle: 0;
+            const probe_handle* handle = sample_handles.data()+p->handle_offset;
+            arb_value_type* t = sample_time.data()+p->offset;
+            arb_value_type* v = sample_value.data()+p->offset;
+            for (sample_size_type i = 0; i<p->n_handle; ++i) {
+                t[i] = time;
+                v[i] = handle[i]? *handle[i]: 0;
+            }
         }
     }
 }
@@ -321,6 +368,11 @@ struct chunk_writer {
     }
 };
 
+// All values equal, NaN being different from everything.
+bool is_uniform(const std::vector<arb_value_type>& values) {
+    return std::adjacent_find(values.begin(), values.end(), std::not_equal_to<>{}) == values.end();
+}
+
 template <typename V>
 std::size_t extend_width(const arb::mechanism& mech, std::size_t width) {
     // Width has to accommodate mechanism alignment and SIMD width.
@@ -436,6 +488,7 @@ void shared_state::instantiate(arb::mechanism& m,
     }
 
     // Initialize state and parameter vectors with default values.
+    bool uniform_parameters = width > 0;
     {
         // Allocate view pointers for random nubers
         std::size_t num_random_numbers_per_cv = m.mech_.n_random_variables;
@@ -447,7 +500,7 @@ void shared_state::instantiate(arb::mechanism& m,
         std::size_t value_width_padded = extend_width<arb_value_type>(m, pos_data.cv.size());
         store.value_width_padded = value_width_padded;
         std::size_t count = (m.mech_.n_state_vars + m.mech_.n_parameters + 1 +
-            random_number_storage)*value_width_padded + m.mech_.n_globals;
+            random_number_storage)*value_width_padded + m.mech_.n_globals + m.mech_.n_table_values;
         store.data_ = array(count, NAN, pad);
         chunk_writer writer(store.data_.data(), value_width_padded);
 
@@ -461,6 +514,7 @@ void shared_state::instantiate(arb::mechanism& m,
             if (it != params.end()) {
                 if (it->second.size() != width) throw arbor_internal_error("mechanism field size mismatch");
                 m.ppack_.parameters[idx] = writer.append(it->second, param.default_value);
+                uniform_parameters = uniform_parameters && is_uniform(it->second);
             }
             else {
                 m.ppack_.parameters[idx] = writer.fill(param.default_value);
@@ -492,6 +546,15 @@ void shared_state::instantiate(arb::mechanism& m,
             if (!found) throw arbor_internal_error(util::pprintf("multicore/mechanism: no such mechanism global '{}'", k));
         }
         store.globals_ = std::vector<arb_value_type>(m.ppack_.globals, m.ppack_.globals + m.mech_.n_globals);
+        // Tables are filled by init_mechanism.
+        m.ppack_.tables = m.ppack_.globals + m.mech_.n_globals;
+    }
+
+    // Parameters painted uniformly over the cell group, or left at their
+    // defaults, can be read once per kernel invocation instead of per CV.
+    if (uniform_parameters) {
+        if (m.iface_.compute_currents_uniform) m.iface_.compute_currents = m.iface_.compute_currents_uniform;
+        if (m.iface_.advance_state_uniform)    m.iface_.advance_state    = m.iface_.advance_state_uniform;
     }
 
     // Make index bulk storage
@@ -24,6 +24,7 @@
 
 #include "backends/event.hpp"
 #include "backends/common_types.hpp"
+#include "backends/sample_reduction.hpp"
 #include "backends/rand_fwd.hpp"
 #include "backends/shared_state_base.hpp"
 
@@ -171,6 +172,12 @@ struct ARB_ARBOR_API shared_state:
     sample_event_stream sample_events;
     array sample_time;
     array sample_value;
+    std::vector<probe_handle> sample_handles; // Handles referred to by sample events.
+
+    sample_reduction_table reductions;    // Reductions of state, evaluated when sampling.
+    std::vector<array> reduction_value;   // Results, one block per reduction.
+    sample_reduction_index reduction_index;       // Reductions referred to by sample handles.
+    std::vector<arb_index_type> active_reductions; // Reductions sampled in the current step.
     threshold_watcher watcher;
 
     // Host-side views/copies and local state.
@@ -239,6 +246,17 @@ struct ARB_ARBOR_API shared_state:
     // (Used for solution bounds checking.)
     std::pair<arb_value_type, arb_value_type> voltage_bounds() const;
 
+    // Append to the table of sample handles, returning the index of the first.
+    sample_size_type add_sample_handles(const probe_handle* begin, const probe_handle* end);
+
+    // Add a reduction over the values at `handles`: their weighted sum or,
+    // given bin edges, the histogram of their weights. Returns the location
+    // of the result, one value per bin for histograms, which is updated
+    // whenever samples are taken.
+    const arb_value_type* add_reduction(const std::vector<probe_handle>& handles,
+                                        const std::vector<arb_value_type>& weights,
+                                        const std::vector<arb_value_type>& edges = {});
+
     // Take samples according to marked events in a sample_event_stream.
     void take_samples();
 
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/fvm_types.hpp>
+
+#include "backends/event.hpp"
+#include "util/span.hpp"
+
+namespace arb {
+
+// Reductions of back-end state, evaluated by the shared state when samples
+// are taken, such that a sample of an aggregate over many CVs or mechanism
+// instances costs a single raw value per result.
+//
+// Reduction r combines the values x_i = *handle[i] of its terms
+// i ∈ [term_divs[r], term_divs[r+1]) into either
+//
+//     out[0] = Σ_i weight[i]·x_i                           (no bin edges), or
+//     out[b] = Σ_i weight[i]·[edge[b] ≤ x_i < edge[b+1]]   (histogram),
+//
+// where the edges of r are [edge_divs[r], edge_divs[r+1]) in `edge`.
+// Null handles are skipped.
+
+struct sample_reduction_table {
+    std::vector<probe_handle> handle;
+    std::vector<arb_value_type> weight;
+    std::vector<arb_index_type> term_divs = {0};
+    std::vector<arb_value_type> edge;
+    std::vector<arb_index_type> edge_divs = {0};
+
+    std::size_t size() const { return term_divs.size()-1; }
+
+    // Number of results of reduction r.
+    arb_size_type width(std::size_t r) const {
+        auto n_edge = edge_divs[r+1]-edge_divs[r];
+        return n_edge? n_edge-1: 1;
+    }
+
+    // Append a reduction, returning its index.
+    std::size_t add(const std::vector<probe_handle>& handles,
+                    const std::vector<arb_value_type>& weights,
+                    const std::vector<arb_value_type>& edges) {
+        if (handles.size()!=weights.size()) {
+            throw arbor_internal_error("sample reduction: mismatched handles and weights");
+        }
+        if (edges.size()==1 || !std::is_sorted(edges.begin(), edges.end(), std::less_equal<>{})) {
+            throw arbor_exception("sample reduction: histogram edges must be at least two increasing values");
+        }
+
+        for (auto i: util::count_along(handles)) {
+            if (!handles[i]) continue;
+            handle.push_back(handles[i]);
+            weight.push_back(weights[i]);
+        }
+        term_divs.push_back(handle.size());
+        edge.insert(edge.end(), edges.begin(), edges.end());
+        edge_divs.push_back(edge.size());
+        return size()-1;
+    }
+};
+
+// Maps the sample handles to the reductions whose results they refer to, such
+// that only the reductions read by the sample events of a step are evaluated.
+struct sample_reduction_index {
+    // Register the results [begin, begin+width) of reduction r.
+    void add_results(probe_handle begin, arb_size_type width, arb_index_type r) {
+        results_[begin] = {width, r};
+        if (seen_.size()<=std::size_t(r)) seen_.resize(r+1, 0);
+    }
+
+    // Record the reductions of handles appended to the sample handle table.
+    void add_handles(const probe_handle* begin, const probe_handle* end) {
+        for (auto h = begin; h!=end; ++h) handle_reduction_.push_back(reduction_of(*h));
+    }
+
+    // Collect the reductions referred to by the sample events [begin, end) in
+    // `out`, in ascending order and without repetition.
+    template <typename Iter>
+    void collect(Iter begin, Iter end, std::vector<arb_index_type>& out) {
+        out.clear();
+        for (auto p = begin; p!=end; ++p) {
+            const auto& ev = *p;
+            for (auto i = ev.handle_offset; i<ev.handle_offset+ev.n_handle; ++i) {
+                auto r = handle_reduction_[i];
+                if (r>=0 && !seen_[r]) {
+                    seen_[r] = 1;
+                    out.push_back(r);
+                }
+            }
+        }
+        for (auto r: out) seen_[r] = 0;
+        std::sort(out.begin(), out.end());
+    }
+
+private:
+    arb_index_type reduction_of(probe_handle h) const {
+        auto it = results_.upper_bound(h);
+        if (it==results_.begin()) return -1;
+        --it;
+        const auto& [width, r] = it->second;
+        return std::less<>{}(h, it->first+width)? r: -1;
+    }
+
+    // Reduction results by their first value: (width, reduction index).
+    std::map<probe_handle, std::pair<arb_size_type, arb_index_type>, std::less<>> results_;
+    // The reduction of each sample handle, or -1.
+    std::vector<arb_index_type> handle_reduction_;
+    // Scratch flags for collect, indexed by reduction.
+    std::vector<char> seen_;
+};
+
+} // namespace arb
@@ -39,7 +39,10 @@ struct shared_state_base {
             }
         }
         // samples
-        auto n_samples = util::sum_by(samples, [] (const auto& s) {return s.size();});
+        sample_size_type n_samples = 0;
+        for (const auto& step: samples) {
+            for (const auto& ev: step) n_samples = std::max(n_samples, ev.raw.offset+ev.raw.n_handle);
+        }
         if (d->sample_time.size() < n_samples) {
             d->sample_time = array(n_samples);
             d->sample_value = array(n_samples);
@@ -1,4 +1,7 @@
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 
 #include <arbor/arbexcept.hpp>
 #include <arbor/benchmark_cell.hpp>
@@ -19,6 +22,13 @@ void deserialize(arb::serializer& s, const K& k, arb::benchmark_cell_group&);
 
 namespace arb {
 
+// Modelled cost of the cells that do not busy-wait, in nano seconds.
+static std::atomic<std::uint64_t> modelled_ns{0};
+
+double benchmark_modelled_time() {
+    return modelled_ns.load(std::memory_order_relaxed)*1e-9;
+}
+
 benchmark_cell_group::benchmark_cell_group(const std::vector<cell_gid_type>& gids,
                                            const recipe& rec,
                                            cell_label_range& cg_sources,
@@ -32,8 +42,10 @@ benchmark_cell_group::benchmark_cell_group(const std::vector<cell_gid_type>& gid
     }
 
     cells_.reserve(gids_.size());
-    for (auto gid: gids_) {
-        cells_.push_back(util::any_cast<benchmark_cell>(rec.get_cell_description(gid)));
+    auto batch = batched_cell_descriptions(rec, gids_);
+    for (auto i: util::count_along(gids_)) {
+        auto gid = gids_[i];
+        cells_.push_back(util::any_cast<benchmark_cell>(batch.empty()? rec.get_cell_description(gid): std::move(batch[i])));
     }
 
     for (const auto& c: cells_) {
@@ -75,6 +87,8 @@ void benchmark_cell_group::advance(epoch ep,
     PE(advance:bench:cell);
     // Micro-seconds to advance in this epoch.
     auto us = 1e3*(ep.duration());
+    // Cost of the cells that do not busy-wait, in micro seconds.
+    double modelled_us = 0;
     for (auto i: util::make_span(0, gids_.size())) {
         // Expected time to complete epoch in micro seconds.
         const double duration_us = cells_[i].realtime_ratio*us;
@@ -88,12 +102,22 @@ void benchmark_cell_group::advance(epoch ep,
             spikes_.push_back({{gid, 0u}, t});
         }
 
+        if (!cells_[i].busy_wait) {
+            modelled_us += duration_us;
+            continue;
+        }
+
         // Wait until the expected time to advance has elapsed. Use a busy-wait
         // so that the resources of this thread are tied up until the interval
         // has elapsed, to emulate a "real" cell.
         while (duration_type(high_resolution_clock::now()-start).count() < duration_us);
     }
 
+    // Only account for the cost of the remaining cells.
+    if (modelled_us>0) {
+        modelled_ns.fetch_add(std::llround(modelled_us*1e3), std::memory_order_relaxed);
+    }
+
     PL();
 };
 
@@ -363,6 +363,91 @@ void run_samples(
     sc.sampler({sc.probeset_id, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
 }
 
+void run_samples(
+    const fvm_probe_extracellular_potential& p,
+    const sampler_call_info& sc,
+    const arb_value_type* raw_times,
+    const arb_value_type* raw_samples,
+    std::vector<sample_record>& sample_records,
+    fvm_probe_scratch& scratch)
+{
+    const sample_size_type n_raw_per_sample = p.raw_handles.size();
+    sample_size_type n_sample = (sc.end_offset-sc.begin_offset)/n_raw_per_sample;
+    arb_assert((sc.end_offset-sc.begin_offset)==n_sample*n_raw_per_sample);
+
+    const auto n_electrode = p.metadata.size();
+    arb_assert(p.transfer_divs.size()==n_electrode+1);
+    const auto rows = util::partition_view(p.transfer_divs);
+
+    auto& sample_ranges = std::get<std::vector<cable_sample_range>>(scratch);
+    sample_ranges.clear();
+
+    auto& tmp = std::get<std::vector<double>>(scratch);
+    tmp.assign(n_electrode*n_sample, 0.);
+
+    sample_records.clear();
+
+    for (sample_size_type j = 0; j<n_sample; ++j) {
+        const double* raw = raw_samples+j*n_raw_per_sample+sc.begin_offset;
+        auto tmp_base = tmp.data()+j*n_electrode;
+
+        for (auto e: util::make_span(n_electrode)) {
+            double phi = 0;
+            for (auto k: util::make_span(rows[e])) phi += p.transfer[k]*raw[p.transfer_index[k]];
+            tmp_base[e] = phi;
+        }
+        sample_ranges.push_back({tmp_base, tmp_base+n_electrode});
+    }
+
+    const auto& csample_ranges = sample_ranges;
+    for (sample_size_type j = 0; j<n_sample; ++j) {
+        auto offset = j*n_raw_per_sample+sc.begin_offset;
+        sample_records.push_back(sample_record{time_type(raw_times[offset]), &csample_ranges[j]});
+    }
+
+    sc.sampler({sc.probeset_id, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+}
+
+void run_samples(
+    const fvm_probe_reduction& p,
+    const sampler_call_info& sc,
+    const arb_value_type* raw_times,
+    const arb_value_type* raw_samples,
+    std::vector<sample_record>& sample_records,
+    fvm_probe_scratch& scratch)
+{
+    // The raw values are the results of the reduction: histograms are
+    // presented as ranges over the bins, scalar reductions as plain values.
+    static_assert(std::is_same<double, arb_value_type>::value, "require sample value translation");
+
+    const sample_size_type n_raw_per_sample = p.raw_handles.size();
+    sample_size_type n_sample = (sc.end_offset-sc.begin_offset)/n_raw_per_sample;
+    arb_assert((sc.end_offset-sc.begin_offset)==n_sample*n_raw_per_sample);
+
+    sample_records.clear();
+    if (p.metadata.edges.empty()) {
+        for (auto i = sc.begin_offset; i!=sc.end_offset; ++i) {
+            sample_records.push_back(sample_record{time_type(raw_times[i]), &raw_samples[i]});
+        }
+    }
+    else {
+        auto& sample_ranges = std::get<std::vector<cable_sample_range>>(scratch);
+        sample_ranges.clear();
+        for (sample_size_type j = 0; j<n_sample; ++j) {
+            auto offset = j*n_raw_per_sample+sc.begin_offset;
+            sample_ranges.push_back({raw_samples+offset, raw_samples+offset+n_raw_per_sample});
+        }
+
+        const auto& csample_ranges = sample_ranges;
+        for (sample_size_type j = 0; j<n_sample; ++j) {
+            auto offset = j*n_raw_per_sample+sc.begin_offset;
+            sample_records.push_back(sample_record{time_type(raw_times[offset]), &csample_ranges[j]});
+        }
+    }
+
+    sc.sampler({sc.probeset_id, sc.index, p.get_metadata_ptr()}, n_sample, sample_records.data());
+}
+
 // Generic run_samples dispatches on probe info variant type.
 void run_samples(
     const sampler_call_info& sc,
@@ -421,8 +506,10 @@ void cable_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange
     //
     // For each (schedule, sampler, probe set) in the sampler association
     // map that will be triggered in this integration interval, create
-    // sample events for the lowered cell, one or more for each scheduled
-    // sample time and probe in the probe set.
+    // sample events for the lowered cell, one for each scheduled sample
+    // time and probe in the probe set. The probes of each association are
+    // resolved once, in `add_sampler`, and each event samples all raw
+    // handles of its probe, which are registered with the back-end.
     //
     // Each event is associated with an offset into the sample data and
     // time buffers; these are assigned contiguously such that one call to
@@ -432,6 +519,7 @@ void cable_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange
 
     PE(advance:samplesetup);
     std::vector<sampler_call_info> call_info;
+    std::vector<arb_size_type> sample_steps;
 
     sample_size_type n_samples = 0;
     sample_size_type max_samples_per_call = 0;
@@ -440,30 +528,32 @@ void cable_cell_group::advance(epoch ep, time_type dt, const event_lane_subrange
         // SAFETY: We need the lock here, as _schedule_ is not reentrant.
         std::lock_guard<std::mutex> guard(sampler_mex_);
         for (auto& [sk, sa]: sampler_map_) {
-            if (sa.probeset_ids.empty()) continue; // No need to make any schedule
+            const auto& plan = sample_plans_.at(sk);
+            if (plan.empty()) continue; // No need to make any schedule
             auto sample_times = util::make_range(sa.sched.events(tstart, ep.t1));
             sample_size_type n_times = sample_times.size();
             if (n_times == 0) continue;
             max_samples_per_call = std::max(max_samples_per_call, n_times);
-            for (const auto& pid: sa.probeset_ids) {
-                unsigned index = 0;
-                for (const auto& pdata: probe_map_.data_on(pid)) {
-                    call_info.push_back({sa.sampler,
-                                         pid,
-                                         index,
-                                         pdata,
-                                         n_samples,
-                                         n_samples + n_times*pdata->n_raw()});
-                    index++;
-                    for (auto t: sample_times) {
-                        auto it = timesteps_.find(t);
-                        arb_assert(it != timesteps_.end());
-                        const auto timestep_index = it - timesteps_.begin();
-                        for (probe_handle h: pdata->raw_handle_range()) {
-                            sample_event ev{t, {h, n_samples++}};
-                            sample_events_[timestep_index].push_back(ev);
-                        }
-                    }
+
+            sample_steps.clear();
+            for (auto t: sample_times) {
+                auto it = timesteps_.find(t);
+                arb_assert(it != timesteps_.end());
+                sample_steps.push_back(it - timesteps_.begin());
+            }
+
+            for (const auto& [pid, index, pdata]: plan) {
+                const auto n_raw = pdata->n_raw();
+                call_info.push_back({sa.sampler,
+                                     pid,
+                                     index,
+                                     pdata,
+                                     n_samples,
+                                     n_samples + n_times*n_raw});
+                for (auto i: util::count_along(sample_steps)) {
+                    sample_event ev{sample_times[i], {pdata->handle_offset, n_raw, n_samples}};
+                    sample_events_[sample_steps[i]].push_back(ev);
+                    n_samples += n_raw;
                 }
             }
             arb_assert(n_samples==call_info.back().end_offset);
@@ -508,6 +598,13 @@ void cable_cell_group::add_sampler(sampler_association_handle h,
     std::lock_guard<std::mutex> guard(sampler_mex_);
     auto probeset = probe_map_.keys(probeset_ids);
     if (!probeset.empty()) {
+        auto& plan = sample_plans_[h];
+        for (const auto& pid: probeset) {
+            unsigned index = 0;
+            for (const auto* pdata: probe_map_.data_on(pid)) {
+                plan.push_back({pid, index++, pdata});
+            }
+        }
         auto result = sampler_map_.insert({h, sampler_association{std::move(sched),
                                                                   std::move(fn),
                                                                   std::move(probeset)}});
@@ -518,11 +615,13 @@ void cable_cell_group::add_sampler(sampler_association_handle h,
 void cable_cell_group::remove_sampler(sampler_association_handle h) {
     std::lock_guard<std::mutex> guard(sampler_mex_);
     sampler_map_.erase(h);
+    sample_plans_.erase(h);
 }
 
 void cable_cell_group::remove_all_samplers() {
     std::lock_guard<std::mutex> guard(sampler_mex_);
     sampler_map_.clear();
+    sample_plans_.clear();
 }
 
 std::vector<probe_metadata> cable_cell_group::get_probe_metadata(const cell_address_type& probeset_id) const {
@@ -90,6 +90,15 @@ private:
     // Collection of samplers to be run against probes in this group.
     sampler_association_map sampler_map_;
 
+    // Probes sampled by each sampler association, in call order: probeset id,
+    // index within the probeset, and probe data in `probe_map_`.
+    struct sample_plan_entry {
+        cell_address_type probeset_id;
+        unsigned index;
+        const fvm_probe_data* pdata;
+    };
+    std::unordered_map<sampler_association_handle, std::vector<sample_plan_entry>> sample_plans_;
+
     // Mutex for thread-safe access to sampler associations.
     std::mutex sampler_mex_;
 
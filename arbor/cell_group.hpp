@@ -4,7 +4,9 @@
 #include <memory>
 #include <vector>
 
+#include <arbor/arbexcept.hpp>
 #include <arbor/common_types.hpp>
+#include <arbor/recipe.hpp>
 #include <arbor/sampling.hpp>
 #include <arbor/schedule.hpp>
 #include <arbor/spike.hpp>
@@ -54,6 +56,16 @@ public:
 
 using cell_group_ptr = std::unique_ptr<cell_group>;
 
+// The descriptions of the cells `gids` of a group from a single batched query, or
+// nothing if the recipe only answers queries per gid.
+inline std::vector<util::unique_any> batched_cell_descriptions(const recipe& rec, const std::vector<cell_gid_type>& gids) {
+    auto descriptions = rec.get_cell_descriptions(gids);
+    if (!descriptions.empty() && descriptions.size() != gids.size()) {
+        throw bad_cell_description_count(gids.size(), descriptions.size());
+    }
+    return descriptions;
+}
+
 template<typename K>
 void serialize(serializer& s, const K& k, const cell_group& v) { v.t_serialize(s, to_serdes_key(k)); }
 template<typename K>
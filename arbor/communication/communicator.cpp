@@ -1,23 +1,37 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
 #include <numeric>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <limits>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <arbor/assert.hpp>
 #include <arbor/common_types.hpp>
 #include <arbor/domain_decomposition.hpp>
 #include <arbor/recipe.hpp>
 #include <arbor/spike.hpp>
+#include <arbor/util/hash_def.hpp>
 #include <include/arbor/arbexcept.hpp>
 
 #include "communication/gathered_vector.hpp"
 #include "connection.hpp"
 #include "distributed_context.hpp"
 #include "execution_context.hpp"
+#include "label_resolution.hpp"
 #include "network_impl.hpp"
 #include "profile/profiler_macro.hpp"
 #include "threading/threading.hpp"
 #include "util/partition.hpp"
+#include "util/strprintf.hpp"
 #include "util/rangeutil.hpp"
 #include "util/span.hpp"
 
@@ -54,10 +68,95 @@ cell_member_type global_cell_of(const cell_member_type& c) {
     return {c.gid | msb, c.index};
 }
 
+namespace {
+// Connections on the local cells in columnar form, with the labels interned
+// into a table such that each distinct label is hashed once.
+struct local_connections {
+    std::vector<cell_tag_type> labels;
+    std::vector<hash_type> label_hashes;
+    // One partition entry per local cell, in the order of `gids`.
+    connection_columns columns;
+};
+
+void check_columns(const connection_columns& cols,
+                   cell_gid_type gid_begin,
+                   cell_gid_type gid_end,
+                   std::size_t num_labels) {
+    auto fail = [&](const std::string& msg) { throw bad_connection_columns(gid_begin, gid_end, msg); };
+    const auto n = cols.size();
+    if (cols.offsets.size() != gid_end - gid_begin + 1) fail("must have one offset per cell plus one");
+    if (cols.offsets.front() != 0 || cols.offsets.back() != n) fail("offsets must span all connections");
+    if (!std::is_sorted(cols.offsets.begin(), cols.offsets.end())) fail("offsets must be non-decreasing");
+    if (cols.source_label.size() != n || cols.source_policy.size() != n
+     || cols.target_label.size() != n || cols.target_policy.size() != n
+     || cols.weight.size() != n || cols.delay.size() != n) fail("must all have the same length");
+    for (std::size_t i = 0; i < n; ++i) {
+        if (cols.source_label[i] >= num_labels || cols.target_label[i] >= num_labels) fail("refer to a label not in the label table");
+        if (!std::isfinite(cols.weight[i])) fail("contain a weight which is not finite");
+        if (!std::isfinite(cols.delay[i]) || cols.delay[i] < 0) fail("contain a delay which is negative or not finite");
+    }
+}
+
+// Query the connections on `gids` from the recipe, by the bulk interface for runs of
+// consecutive gids if the recipe provides a label table, and else cell by cell.
+local_connections collect_connections(const recipe& rec, const std::vector<cell_gid_type>& gids) {
+    local_connections result;
+    auto& cols = result.columns;
+    result.labels = rec.connection_label_table();
+    if (!result.labels.empty()) {
+        result.label_hashes.reserve(result.labels.size());
+        for (const auto& label: result.labels) result.label_hashes.push_back(hash_value(label));
+        for (std::size_t i = 0; i < gids.size();) {
+            auto j = i + 1;
+            while (j < gids.size() && gids[j] == gids[j-1] + 1) ++j;
+            const auto gid_begin = gids[i], gid_end = gids[j-1] + 1;
+            const auto range = rec.connections_on_range(gid_begin, gid_end);
+            check_columns(range, gid_begin, gid_end, result.labels.size());
+            cols.append(range);
+            i = j;
+        }
+        return result;
+    }
+
+    std::unordered_map<cell_tag_type, cell_size_type> interned;
+    auto intern = [&](const cell_tag_type& tag) {
+        auto [it, inserted] = interned.try_emplace(tag, result.labels.size());
+        if (inserted) {
+            result.labels.push_back(tag);
+            result.label_hashes.push_back(hash_value(tag));
+        }
+        return it->second;
+    };
+    for (const auto gid: gids) {
+        for (const auto& conn: rec.connections_on(gid)) {
+            cols.add(conn.source.gid, intern(conn.source.label.tag), intern(conn.target.tag),
+                     conn.weight, conn.delay, conn.source.label.policy, conn.target.policy);
+        }
+        cols.next_cell();
+    }
+    return result;
+}
+} // namespace
+
 void communicator::update_connections(const recipe& rec,
                                       const domain_decomposition& dom_dec,
                                       const label_resolution_map& source_resolution_map,
                                       const label_resolution_map& target_resolution_map) {
+    update_connections(rec, dom_dec, &source_resolution_map, nullptr, target_resolution_map);
+}
+
+void communicator::update_connections(const recipe& rec,
+                                      const domain_decomposition& dom_dec,
+                                      const cell_labels_and_gids& local_sources,
+                                      const label_resolution_map& target_resolution_map) {
+    update_connections(rec, dom_dec, nullptr, &local_sources, target_resolution_map);
+}
+
+void communicator::update_connections(const recipe& rec,
+                                      const domain_decomposition& dom_dec,
+                                      const label_resolution_map* source_resolution_map,
+                                      const cell_labels_and_gids* local_sources,
+                                      const label_resolution_map& target_resolution_map) {
     PE(init:communicator:update:clear);
     // Forget all lingering information
     connections_.clear();
@@ -70,7 +169,7 @@ void communicator::update_connections(const recipe& rec,
     auto generated_connections = generate_connections(rec, ctx_, dom_dec);
 
     // Make a list of local cells' connections
-    //   -> gid_connections
+    //   -> local: columns with one partition entry per local cell
     // Count the number of local connections (i.e. connections terminating on this domain)
     //   -> n_cons: scalar
     // Calculate and store domain id of the presynaptic cell on each local connection
@@ -87,28 +186,25 @@ void communicator::update_connections(const recipe& rec,
 
     // Build the connection information for local cells.
     PE(init:communicator:update:gid_connections);
-    std::vector<cell_connection> gid_connections;
+    const auto local = collect_connections(rec, gids);
+    const auto& cols = local.columns;
     std::vector<ext_cell_connection> gid_ext_connections;
-    std::vector<size_t> part_connections;
-    part_connections.reserve(num_local_cells_);
-    part_connections.push_back(0);
     std::vector<size_t> part_ext_connections;
     part_ext_connections.reserve(num_local_cells_);
     part_ext_connections.push_back(0);
     std::vector<unsigned> src_domains;
+    src_domains.reserve(cols.size() + generated_connections.size());
     std::vector<cell_size_type> src_counts(num_domains_);
-    for (const auto gid: gids) {
+    for (const auto index: util::make_span(num_local_cells_)) {
+        const auto gid = gids[index];
         // Local
-        const auto& conns = rec.connections_on(gid);
-        for (const auto& conn: conns) {
-            const auto sgid = conn.source.gid;
+        for (const auto cidx: util::make_span(cols.offsets[index], cols.offsets[index+1])) {
+            const auto sgid = cols.source_gid[cidx];
             if (sgid >= num_total_cells_) throw arb::bad_connection_source_gid(gid, sgid, num_total_cells_);
             const auto src = dom_dec.gid_domain(sgid);
             src_domains.push_back(src);
             src_counts[src]++;
-            gid_connections.emplace_back(conn);
         }
-        part_connections.push_back(gid_connections.size());
         // Remote
         const auto& ext_conns = rec.external_connections_on(gid);
         for (const auto& conn: ext_conns) {
@@ -127,10 +223,25 @@ void communicator::update_connections(const recipe& rec,
     }
 
     util::make_partition(connection_part_, src_counts);
-    auto n_cons = gid_connections.size() + generated_connections.size();
+    auto n_cons = cols.size() + generated_connections.size();
     auto n_ext_cons = gid_ext_connections.size();
     PL();
 
+    // Collect the labels of the sources referenced by local connections.
+    label_resolution_map requested_sources;
+    if (local_sources) {
+        PE(init:communicator:update:resolve_sources);
+        std::vector<label_resolution_map::key_type> required;
+        required.reserve(cols.size());
+        for (const auto cidx: util::make_span(cols.size())) {
+            required.emplace_back(cols.source_gid[cidx], local.label_hashes[cols.source_label[cidx]]);
+        }
+        auto gid_domain = [&](cell_gid_type gid) { return dom_dec.gid_domain(gid); };
+        requested_sources = make_resolution_map(*local_sources, std::move(required), gid_domain, *ctx_->distributed);
+        source_resolution_map = &requested_sources;
+        PL();
+    }
+
     // Construct the connections. The loop above gave us the information needed
     // to do this in place.
     // NOTE: The connections are partitioned by the domain of their source gid.
@@ -144,16 +255,16 @@ void communicator::update_connections(const recipe& rec,
     for (const auto index: util::make_span(num_local_cells_)) {
         const auto tgt_gid = gids[index];
         const auto iod = dom_dec.index_on_domain(tgt_gid);
-        auto source_resolver = resolver(&source_resolution_map);
-        for (const auto cidx: util::make_span(part_connections[index], part_connections[index+1])) {
-            const auto& conn = gid_connections[cidx];
-            auto src_gid = conn.source.gid;
+        auto source_resolver = resolver(source_resolution_map);
+        for (const auto cidx: util::make_span(cols.offsets[index], cols.offsets[index+1])) {
+            auto src_gid = cols.source_gid[cidx];
             if(is_external(src_gid)) throw arb::source_gid_exceeds_limit(tgt_gid, src_gid);
-            auto src_lid = source_resolver.resolve(conn.source);
-            auto tgt_lid = target_resolver.resolve(tgt_gid, conn.target);
+            const auto src_label = cols.source_label[cidx], tgt_label = cols.target_label[cidx];
+            auto src_lid = source_resolver.resolve(src_gid, local.labels[src_label], local.label_hashes[src_label], cols.source_policy[cidx]);
+            auto tgt_lid = target_resolver.resolve(tgt_gid, local.labels[tgt_label], local.label_hashes[tgt_label], cols.target_policy[cidx]);
             auto offset  = offsets[*src_domain]++;
             ++src_domain;
-            connections[offset] = {{src_gid, src_lid}, tgt_lid, conn.weight, conn.delay, iod};
+            connections[offset] = {{src_gid, src_lid}, tgt_lid, cols.weight[cidx], cols.delay[cidx], iod};
         }
         for (const auto cidx: util::make_span(part_ext_connections[index], part_ext_connections[index+1])) {
             const auto& conn = gid_ext_connections[cidx];
@@ -173,11 +284,7 @@ void communicator::update_connections(const recipe& rec,
     PL();
 
     PE(init:communicator:update:index);
-    // Build cell partition by group for passing events to cell groups
-    index_part_ = util::make_partition(index_divisions_,
-        util::transform_view(
-            dom_dec.groups(),
-            [](const group_description& g){ return g.gids.size(); }));
+    update_index(dom_dec);
     PL();
 
     PE(init:communicator:update:sort_connections);
@@ -195,6 +302,334 @@ void communicator::update_connections(const recipe& rec,
     connections_.make(connections);
     ext_connections_.make(ext_connections);
     PL();
+
+    update_min_delay();
+}
+
+void communicator::update_index(const domain_decomposition& dom_dec) {
+    // Build cell partition by group for passing events to cell groups
+    index_part_ = util::make_partition(index_divisions_,
+        util::transform_view(
+            dom_dec.groups(),
+            [](const group_description& g){ return g.gids.size(); }));
+}
+
+void communicator::update_min_delay() {
+    local_min_delay_ = std::numeric_limits<time_type>::max();
+    for (auto del: connections_.delays) local_min_delay_ = std::min<time_type>(local_min_delay_, del);
+    for (auto del: ext_connections_.delays) local_min_delay_ = std::min<time_type>(local_min_delay_, del);
+}
+
+namespace {
+// Connection cache files consist of a header followed by the partition of
+// connections by source domain and the columns of the local and external
+// connection lists. Each part starts at a multiple of the alignment; files
+// are memory mapped for loading. Data is stored in native byte order; files
+// are not portable between architectures.
+constexpr char connection_cache_magic[8] = {'a', 'r', 'b', 'c', 'o', 'n', 'n', '\0'};
+constexpr std::uint32_t connection_cache_version = 1;
+constexpr std::size_t connection_cache_alignment = 64;
+
+struct connection_cache_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_domains;
+    std::uint64_t key;
+    std::uint64_t num_local_cells;
+    std::uint64_t num_connections;
+    std::uint64_t num_ext_connections;
+};
+
+std::filesystem::path connection_cache_path(std::filesystem::path path, int rank) {
+    path += "." + std::to_string(rank);
+    return path;
+}
+
+std::streamoff connection_cache_padding(std::streamoff pos) {
+    const std::streamoff alignment = connection_cache_alignment;
+    return (alignment - pos%alignment)%alignment;
+}
+
+template <typename T>
+void write_cache_section(std::ostream& out, const T* data, std::size_t n) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static constexpr char zeros[connection_cache_alignment] = {};
+    out.write(reinterpret_cast<const char*>(data), n*sizeof(T));
+    out.write(zeros, connection_cache_padding(out.tellp()));
+}
+
+void write_cache_section(std::ostream& out, const communicator::connection_list& cons) {
+    write_cache_section(out, cons.idx_on_domain.data(), cons.size());
+    write_cache_section(out, cons.srcs.data(), cons.size());
+    write_cache_section(out, cons.dests.data(), cons.size());
+    write_cache_section(out, cons.weights.data(), cons.size());
+    write_cache_section(out, cons.delays.data(), cons.size());
+}
+
+// Read-only mapping of a whole cache file; empty if it cannot be mapped.
+class mapped_cache_file {
+public:
+    explicit mapped_cache_file(const std::filesystem::path& fn) {
+        int fd = ::open(fn.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (!::fstat(fd, &st) && st.st_size > 0) {
+            void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<const char*>(data);
+                size_ = st.st_size;
+            }
+        }
+        ::close(fd);
+    }
+
+    mapped_cache_file(const mapped_cache_file&) = delete;
+    mapped_cache_file& operator=(const mapped_cache_file&) = delete;
+
+    ~mapped_cache_file() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    // Copy the next n values into data and advance to the next aligned
+    // section. Fails if the file is too short.
+    template <typename T>
+    bool read(T* data, std::size_t n) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (n > (size_ - pos_)/sizeof(T)) return false;
+        if (n) std::memcpy(data, data_ + pos_, n*sizeof(T));
+        pos_ = std::min<std::size_t>(size_, pos_ + n*sizeof(T) + connection_cache_padding(pos_ + n*sizeof(T)));
+        return true;
+    }
+
+    bool read(communicator::connection_list& cons, std::size_t n) {
+        constexpr std::size_t row = sizeof(cell_size_type) + sizeof(cell_member_type)
+                                  + sizeof(cell_lid_type) + 2*sizeof(float);
+        if (n > (size_ - pos_)/row) return false;
+        cons.resize(n);
+        return read(cons.idx_on_domain.data(), n)
+            && read(cons.srcs.data(), n)
+            && read(cons.dests.data(), n)
+            && read(cons.weights.data(), n)
+            && read(cons.delays.data(), n);
+    }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+};
+} // namespace
+
+std::optional<std::uint64_t> communicator::connectivity_hash(const recipe& rec,
+                                                             const cell_labels_and_gids& local_sources,
+                                                             const cell_labels_and_gids& local_targets) const {
+    // Connections are identified by the recipe's fingerprint, not by querying them.
+    const auto fingerprint = rec.connectivity_fingerprint();
+    if (!fingerprint) return std::nullopt;
+
+    PE(init:communicator:hash);
+    std::uint64_t hash = hash_value(*fingerprint, num_total_cells_, num_domains_, ctx_->distributed->id());
+    auto mix = [&hash](const auto&... values) { hash = hash_value(hash, values...); };
+
+    // Labels determine the lids which connections are resolved to.
+    for (const auto* labels: {&local_sources, &local_targets}) {
+        for (auto gid: labels->gids) mix(gid);
+        for (auto size: labels->label_range.sizes) mix(size);
+        for (auto label: labels->label_range.labels) mix(label);
+        for (auto range: labels->label_range.ranges) mix(range.begin, range.end);
+    }
+    PL();
+
+    // Combine the contributions of all ranks, as resolution of local
+    // connections depends on the labels of remote sources.
+    return ctx_->distributed->sum((unsigned long long)hash);
+}
+
+void communicator::save_connections(const std::filesystem::path& path, std::uint64_t key) const {
+    PE(init:communicator:save);
+    const auto fn = connection_cache_path(path, ctx_->distributed->id());
+    std::ofstream out(fn, std::ios::binary | std::ios::trunc);
+
+    connection_cache_header header = {};
+    std::memcpy(header.magic, connection_cache_magic, sizeof header.magic);
+    header.version = connection_cache_version;
+    header.num_domains = num_domains_;
+    header.key = key;
+    header.num_local_cells = num_local_cells_;
+    header.num_connections = connections_.size();
+    header.num_ext_connections = ext_connections_.size();
+
+    write_cache_section(out, &header, 1);
+    write_cache_section(out, connection_part_.data(), connection_part_.size());
+    write_cache_section(out, connections_);
+    write_cache_section(out, ext_connections_);
+    if (!out) throw arbor_exception(util::pprintf("Could not write connection cache '{}'.", fn.string()));
+    PL();
+}
+
+bool communicator::load_connections(const std::filesystem::path& path,
+                                    std::uint64_t key,
+                                    const domain_decomposition& dom_dec) {
+    PE(init:communicator:load);
+    connection_list connections, ext_connections;
+    std::vector<cell_size_type> connection_part;
+    auto read = [&]() {
+        mapped_cache_file in(connection_cache_path(path, ctx_->distributed->id()));
+        connection_cache_header header;
+        if (!in.read(&header, 1)) return false;
+        if (std::memcmp(header.magic, connection_cache_magic, sizeof header.magic)
+            || header.version != connection_cache_version
+            || header.key != key
+            || header.num_domains != num_domains_
+            || header.num_local_cells != num_local_cells_) return false;
+        connection_part.resize(num_domains_ + 1);
+        return in.read(connection_part.data(), connection_part.size())
+            && connection_part.back() == header.num_connections
+            && in.read(connections, header.num_connections)
+            && in.read(ext_connections, header.num_ext_connections);
+    };
+    // Connections are rebuilt collectively, unless all ranks can use their cache.
+    const bool loaded = ctx_->distributed->min(int(read()));
+    PL();
+    if (!loaded) return false;
+
+    connections_ = std::move(connections);
+    ext_connections_ = std::move(ext_connections);
+    connection_part_ = std::move(connection_part);
+    index_divisions_.clear();
+    update_index(dom_dec);
+    update_min_delay();
+    return true;
+}
+
+void communicator::update_connections(const connection_delta& delta,
+                                      const domain_decomposition& dom_dec,
+                                      const cell_labels_and_gids& local_sources,
+                                      const label_resolution_map& target_resolution_map) {
+    PE(init:communicator:update:delta:resolve_sources);
+    std::vector<label_resolution_map::key_type> required;
+    required.reserve(delta.added.size() + delta.removed.size());
+    for (const auto& [tgt_gid, conn]: delta.added) {
+        required.emplace_back(conn.source.gid, hash_value(conn.source.label.tag));
+    }
+    for (const auto& rm: delta.removed) {
+        required.emplace_back(rm.source.gid, hash_value(rm.source.label.tag));
+    }
+    // Out of range gids are rejected below.
+    auto gid_domain = [&](cell_gid_type gid) { return gid < num_total_cells_ ? dom_dec.gid_domain(gid) : -1; };
+    const auto source_resolution_map = make_resolution_map(local_sources, std::move(required), gid_domain, *ctx_->distributed);
+    PL();
+
+    const auto rank = ctx_->distributed->id();
+    auto check_gids = [&](cell_gid_type tgt_gid, cell_gid_type src_gid) {
+        if (tgt_gid >= num_total_cells_ || dom_dec.gid_domain(tgt_gid) != rank) {
+            throw arb::bad_connection_target_gid(tgt_gid);
+        }
+        if (src_gid >= num_total_cells_) throw arb::bad_connection_source_gid(tgt_gid, src_gid, num_total_cells_);
+    };
+
+    auto find_lids = [](const label_resolution_map& map, cell_gid_type gid, const cell_tag_type& tag) {
+        const auto* lids = map.find(gid, hash_value(tag));
+        if (!lids) throw arb::bad_connection_label(gid, tag, "label does not exist");
+        return lids;
+    };
+
+    // Removals are matched against connections by source gid and target cell,
+    // then by the lid sets of their labels.
+    PE(init:communicator:update:delta:remove);
+    struct removal {
+        cell_gid_type source_gid;
+        cell_size_type index_on_domain;
+        const label_resolution_map::range_set* source_lids;
+        const label_resolution_map::range_set* target_lids;
+    };
+    auto removal_key = [](const removal& r) { return std::make_pair(r.source_gid, r.index_on_domain); };
+
+    std::vector<removal> removals;
+    removals.reserve(delta.removed.size());
+    for (const auto& rm: delta.removed) {
+        check_gids(rm.target_gid, rm.source.gid);
+        removals.push_back({rm.source.gid,
+                            dom_dec.index_on_domain(rm.target_gid),
+                            find_lids(source_resolution_map, rm.source.gid, rm.source.label.tag),
+                            find_lids(target_resolution_map, rm.target_gid, rm.target.tag)});
+    }
+    util::sort_by(removals, removal_key);
+
+    auto is_removed = [&](const connection& con) {
+        const auto key = std::make_pair(con.source.gid, con.index_on_domain);
+        auto it = std::lower_bound(removals.begin(), removals.end(), key,
+                                   [&](const removal& r, const auto& k) { return removal_key(r) < k; });
+        for (; it != removals.end() && removal_key(*it) == key; ++it) {
+            if (it->source_lids->contains(con.source.index) && it->target_lids->contains(con.target)) return true;
+        }
+        return false;
+    };
+
+    // Compact the connections of each domain in place. As every connection is
+    // visited, the minimum delay is recomputed on the way.
+    if (!removals.empty()) {
+        local_min_delay_ = std::numeric_limits<time_type>::max();
+        for (auto del: ext_connections_.delays) local_min_delay_ = std::min<time_type>(local_min_delay_, del);
+
+        std::size_t out = 0;
+        for (cell_size_type d = 0; d < num_domains_; ++d) {
+            const auto begin = connection_part_[d], end = connection_part_[d+1];
+            connection_part_[d] = out;
+            for (auto i = begin; i < end; ++i) {
+                const auto con = connections_.get(i);
+                if (is_removed(con)) continue;
+                local_min_delay_ = std::min<time_type>(local_min_delay_, con.delay);
+                if (out != i) connections_.set(out, con);
+                ++out;
+            }
+        }
+        connection_part_[num_domains_] = out;
+        connections_.resize(out);
+    }
+    PL();
+
+    PE(init:communicator:update:delta:add);
+    std::vector<std::vector<connection>> added(num_domains_);
+    auto target_resolver = resolver(&target_resolution_map);
+    auto source_resolver = resolver(&source_resolution_map);
+    for (const auto& [tgt_gid, conn]: delta.added) {
+        const auto src_gid = conn.source.gid;
+        check_gids(tgt_gid, src_gid);
+        auto src_lid = source_resolver.resolve(conn.source);
+        auto tgt_lid = target_resolver.resolve(tgt_gid, conn.target);
+        added[dom_dec.gid_domain(src_gid)].push_back(
+            {{src_gid, src_lid}, tgt_lid, conn.weight, conn.delay, dom_dec.index_on_domain(tgt_gid)});
+        local_min_delay_ = std::min<time_type>(local_min_delay_, conn.delay);
+    }
+
+    // Merge the sorted additions into each domain back to front, such that no
+    // connection is overwritten before it has been moved.
+    if (!delta.added.empty()) {
+        const auto old_part = connection_part_;
+        for (cell_size_type d = 0; d < num_domains_; ++d) {
+            util::sort(added[d]);
+            connection_part_[d+1] = old_part[d+1] + (connection_part_[d] - old_part[d]) + added[d].size();
+        }
+        connections_.resize(connection_part_[num_domains_]);
+
+        for (auto d = num_domains_; d-- > 0;) {
+            const auto& add = added[d];
+            auto a = add.size();
+            auto r = old_part[d+1];
+            auto out = connection_part_[d+1];
+            // Additions are placed after existing connections with the same source.
+            while (a > 0 || (r > old_part[d] && out != r)) {
+                if (a > 0 && (r == old_part[d] || !(add[a-1] < connections_.get(r-1)))) {
+                    connections_.set(--out, add[--a]);
+                }
+                else {
+                    connections_.set(--out, connections_.get(--r));
+                }
+            }
+        }
+    }
+    PL();
 }
 
 std::pair<cell_size_type, cell_size_type> communicator::group_queue_range(cell_size_type i) {
@@ -203,22 +638,19 @@ std::pair<cell_size_type, cell_size_type> communicator::group_queue_range(cell_s
 }
 
 time_type communicator::min_delay() {
-    time_type res = std::numeric_limits<time_type>::max();
-    res = std::accumulate(connections_.delays.begin(), connections_.delays.end(),
-                          res,
-                          [](auto&& acc, time_type del) { return std::min(acc, del); });
-    res = std::accumulate(ext_connections_.delays.begin(), ext_connections_.delays.end(),
-                          res,
-                          [](auto&& acc, time_type del) { return std::min(acc, del); });
-    res = ctx_->distributed->min(res);
-    return res;
+    return ctx_->distributed->min(local_min_delay_);
 }
 
 communicator::spikes
 communicator::exchange(std::vector<spike> local_spikes) {
     PE(communication:exchange:sort);
-    // sort the spikes in ascending order of source gid
-    util::sort_by(local_spikes, [](spike s){return s.source;});
+    // Spikes must be in ascending order of source gid. The simulation hands
+    // over the merged, sorted buffers of its cell groups, so this is a single
+    // linear scan in the common case.
+    auto by_source = [](const spike& a, const spike& b) { return a.source<b.source; };
+    if (!std::is_sorted(local_spikes.begin(), local_spikes.end(), by_source)) {
+        std::sort(local_spikes.begin(), local_spikes.end());
+    }
     PL();
 
     PE(communication:exchange:gather);
@@ -242,7 +674,9 @@ communicator::exchange(std::vector<spike> local_spikes) {
     std::for_each(remote_spikes.begin(), remote_spikes.end(),
                   [](spike& s) { s.source = global_cell_of(s.source); });
     // sort, since we cannot trust our peers
-    std::sort(remote_spikes.begin(), remote_spikes.end());
+    if (!std::is_sorted(remote_spikes.begin(), remote_spikes.end())) {
+        std::sort(remote_spikes.begin(), remote_spikes.end());
+    }
     PL();
     return {global_spikes, remote_spikes};
 }
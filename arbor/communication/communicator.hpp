@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
 #include <vector>
 
 #include <arbor/common_types.hpp>
@@ -13,6 +17,7 @@
 #include "connection.hpp"
 #include "epoch.hpp"
 #include "execution_context.hpp"
+#include "label_resolution.hpp"
 #include "util/partition.hpp"
 
 namespace arb {
@@ -83,6 +88,42 @@ public:
                             const label_resolution_map& source_resolution_map,
                             const label_resolution_map& target_resolution_map);
 
+    /// As above, but source labels are resolved on demand: only the labels
+    /// referenced by local connections are collected from the ranks in
+    /// `local_sources`. Must be called collectively.
+    void update_connections(const recipe& rec,
+                            const domain_decomposition& dom_dec,
+                            const cell_labels_and_gids& local_sources,
+                            const label_resolution_map& target_resolution_map);
+
+    /// Apply the changes in `delta` to the connections terminating on local cells,
+    /// without consulting the recipe. Removals are applied before additions; the
+    /// sort order of connections of each source domain is kept. Source labels are
+    /// resolved on demand as above. Must be called collectively.
+    void update_connections(const connection_delta& delta,
+                            const domain_decomposition& dom_dec,
+                            const cell_labels_and_gids& local_sources,
+                            const label_resolution_map& target_resolution_map);
+
+    /// Key for cached connection tables, combining the recipe's connectivity
+    /// fingerprint with the source and target labels of all ranks. Returns
+    /// nothing if the recipe has no fingerprint. The recipe's connections are not
+    /// queried. Collective.
+    std::optional<std::uint64_t> connectivity_hash(const recipe& rec,
+                                                   const cell_labels_and_gids& local_sources,
+                                                   const cell_labels_and_gids& local_targets) const;
+
+    /// Write the connection table of this rank to `path` with the rank appended,
+    /// tagged with `key`.
+    void save_connections(const std::filesystem::path& path, std::uint64_t key) const;
+
+    /// Replace the connection table by one written by `save_connections` with the same
+    /// key, number of ranks and local cells. If any rank cannot do so, the connection
+    /// table is left unchanged on all ranks and false is returned. Collective.
+    bool load_connections(const std::filesystem::path& path,
+                          std::uint64_t key,
+                          const domain_decomposition& dom_dec);
+
     void set_remote_spike_filter(const spike_predicate&);
 
     // TODO: This is public for now.
@@ -112,12 +153,41 @@ public:
             delays.clear();
         }
 
+        void resize(size_t n) {
+            idx_on_domain.resize(n);
+            srcs.resize(n);
+            dests.resize(n);
+            weights.resize(n);
+            delays.resize(n);
+        }
+
+        connection get(size_t i) const {
+            return {srcs[i], dests[i], weights[i], delays[i], idx_on_domain[i]};
+        }
+
+        void set(size_t i, const connection& con) {
+            idx_on_domain[i] = con.index_on_domain;
+            srcs[i] = con.source;
+            dests[i] = con.target;
+            weights[i] = con.weight;
+            delays[i] = con.delay;
+        }
+
         size_t size() const { return srcs.size(); }
     };
 
     const connection_list& connections() const;
 
 private:
+    // Either a complete map of source labels or the local labels to resolve on demand.
+    void update_connections(const recipe& rec,
+                            const domain_decomposition& dom_dec,
+                            const label_resolution_map* source_resolution_map,
+                            const cell_labels_and_gids* local_sources,
+                            const label_resolution_map& target_resolution_map);
+
+    void update_index(const domain_decomposition& dom_dec);
+    void update_min_delay();
 
     cell_size_type num_total_cells_ = 0;
     cell_size_type num_local_cells_ = 0;
@@ -136,6 +206,9 @@ private:
     // Currently we have no partitions/indices/acceleration structures
     connection_list ext_connections_;
 
+    // Minimum delay of local and external connections on this domain.
+    time_type local_min_delay_ = std::numeric_limits<time_type>::max();
+
     std::uint64_t num_spikes_ = 0u;
     std::uint64_t num_local_events_ = 0u;
     context ctx_;
@@ -1,6 +1,12 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
+#include <arbor/arbexcept.hpp>
+#include <arbor/context.hpp>
 #include <arbor/spike.hpp>
 
 #include "distributed_context.hpp"
@@ -14,36 +20,132 @@ struct dry_run_context_impl {
 
     explicit dry_run_context_impl(unsigned num_ranks, unsigned num_cells_per_tile):
         num_ranks_(num_ranks), num_cells_per_tile_(num_cells_per_tile) {};
+
+    explicit dry_run_context_impl(const dry_run_info& info, std::shared_ptr<dry_run_report> report):
+        num_ranks_(info.num_ranks),
+        num_cells_per_tile_(info.num_cells_per_rank),
+        latency_(info.latency),
+        bandwidth_(info.bandwidth),
+        report_(std::move(report)),
+        rng_(info.seed)
+    {
+        if (report_) report_->num_ranks = num_ranks_;
+
+        if (info.rate) {
+            // Cumulative rates [kHz] of the cells on each non-local rank, for
+            // drawing spikes of the rank as the superposition of its cells.
+            cumulative_rates_.resize(num_ranks_);
+            for (unsigned r = 1; r<num_ranks_; ++r) {
+                auto& cr = cumulative_rates_[r];
+                double total = 0;
+                for (unsigned i = 0; i<num_cells_per_tile_; ++i) {
+                    total += 1e-3*info.rate(r*num_cells_per_tile_ + i);
+                    cr.push_back(total);
+                }
+            }
+        }
+        else if (!info.trace.empty()) {
+            if (!num_cells_per_tile_) throw arbor_exception("dry run: trace requires num_cells_per_rank > 0");
+            for (const auto& s: info.trace) {
+                auto tile = s.source.gid/num_cells_per_tile_;
+                if (tile>=trace_.size()) trace_.resize(tile+1);
+                trace_[tile].push_back(s);
+            }
+            for (auto& t: trace_) util::sort_by(t, [](const spike& s) { return s.time; });
+        }
+    }
+
     std::vector<spike>
     remote_gather_spikes(const std::vector<spike>& local_spikes) const {
         return {};
     }
+
     gathered_vector<spike>
     gather_spikes(const std::vector<spike>& local_spikes) const {
+        std::vector<spike> gathered_spikes;
+        std::vector<count_type> partition = {0};
 
-        count_type local_size = local_spikes.size();
+        if (cumulative_rates_.empty() && trace_.empty()) {
+            count_type local_size = local_spikes.size();
+            gathered_spikes.reserve(local_size*num_ranks_);
 
-        std::vector<spike> gathered_spikes;
-        gathered_spikes.reserve(local_size*num_ranks_);
+            for (count_type i = 0; i < num_ranks_; i++) {
+                util::append(gathered_spikes, local_spikes);
+            }
 
-        for (count_type i = 0; i < num_ranks_; i++) {
+            for (count_type i = 0; i < num_ranks_; i++) {
+                for (count_type j = i*local_size; j < (i+1)*local_size; j++){
+                    gathered_spikes[j].source.gid += num_cells_per_tile_*i;
+                }
+            }
+
+            for (count_type i = 1; i <= num_ranks_; i++) {
+                partition.push_back(static_cast<count_type>(i*local_size));
+            }
+        }
+        else {
             util::append(gathered_spikes, local_spikes);
+            partition.push_back(gathered_spikes.size());
+            for (unsigned r = 1; r<num_ranks_; ++r) {
+                auto first = gathered_spikes.size();
+                if (cumulative_rates_.empty()) replay_spikes(r, gathered_spikes);
+                else draw_spikes(r, gathered_spikes);
+
+                // Spikes of each rank are exchanged sorted by source.
+                std::sort(gathered_spikes.begin()+first, gathered_spikes.end(),
+                          [](const spike& a, const spike& b) { return a.source<b.source; });
+                partition.push_back(gathered_spikes.size());
+            }
         }
 
-        for (count_type i = 0; i < num_ranks_; i++) {
-            for (count_type j = i*local_size; j < (i+1)*local_size; j++){
-                gathered_spikes[j].source.gid += num_cells_per_tile_*i;
-            }
+        if (report_) record_exchange(partition);
+        return gathered_vector<spike>(std::move(gathered_spikes), std::move(partition));
+    }
+
+    // Spikes of rank r in the current epoch, as Poisson processes.
+    void draw_spikes(unsigned r, std::vector<spike>& out) const {
+        const auto& cr = cumulative_rates_[r];
+        if (cr.empty() || cr.back()<=0) return;
+
+        std::exponential_distribution<double> isi(cr.back());
+        std::uniform_real_distribution<double> pick(0, cr.back());
+        for (auto t = epoch_.t0 + isi(rng_); t<epoch_.t1; t += isi(rng_)) {
+            auto i = std::upper_bound(cr.begin(), cr.end(), pick(rng_)) - cr.begin();
+            i = std::min<std::ptrdiff_t>(i, cr.size()-1);
+            out.emplace_back(cell_member_type{cell_gid_type(r*num_cells_per_tile_ + i), 0u}, t);
         }
+    }
 
-        std::vector<count_type> partition;
-        for (count_type i = 0; i <= num_ranks_; i++) {
-            partition.push_back(static_cast<count_type>(i*local_size));
+    // Spikes of rank r in the current epoch, from the trace.
+    void replay_spikes(unsigned r, std::vector<spike>& out) const {
+        auto tile = r%trace_.size();
+        const auto& spikes = trace_[tile];
+        auto b = std::lower_bound(spikes.begin(), spikes.end(), epoch_.t0,
+                                  [](const spike& s, time_type t) { return s.time<t; });
+        for (auto it = b; it!=spikes.end() && it->time<epoch_.t1; ++it) {
+            auto s = *it;
+            s.source.gid += (r - tile)*num_cells_per_tile_;
+            out.push_back(s);
         }
+    }
 
-        return gathered_vector<spike>(std::move(gathered_spikes), std::move(partition));
+    void record_exchange(const std::vector<count_type>& partition) const {
+        std::size_t max_count = 0;
+        for (unsigned r = 0; r<num_ranks_; ++r) {
+            max_count = std::max<std::size_t>(max_count, partition[r+1]-partition[r]);
+        }
+        double rounds = num_ranks_>1? std::ceil(std::log2(num_ranks_)): 0;
+        double t = rounds*latency_ + partition.back()*sizeof(spike)/bandwidth_;
+
+        report_->num_exchanges += 1;
+        report_->num_spikes += partition.back();
+        report_->max_rank_spikes = std::max(report_->max_rank_spikes, max_count);
+        report_->exchange_time += t;
+        report_->max_exchange_time = std::max(report_->max_exchange_time, t);
     }
-    void remote_ctrl_send_continue(const epoch&) const {}
+
+    // The epoch whose spikes are exchanged next.
+    void remote_ctrl_send_continue(const epoch& e) const { epoch_ = e; }
     void remote_ctrl_send_done() const {}
     gathered_vector<cell_gid_type>
     gather_gids(const std::vector<cell_gid_type>& local_gids) const {
@@ -93,6 +195,24 @@ struct dry_run_context_impl {
         return std::vector<std::size_t>(num_ranks_, value);
     }
 
+    // Rank r holds the local cells with gids offset by r*num_cells_per_tile_,
+    // answer its requests from the local labels and restore the gids.
+    std::vector<label_resolution_map::entry>
+    exchange_label_requests(const std::vector<label_resolution_map::entry>& local_entries,
+                            const std::vector<std::vector<label_resolution_map::key_type>>& requests) const {
+        std::vector<label_resolution_map::entry> found;
+        for (unsigned r = 0; r<requests.size(); ++r) {
+            const cell_gid_type offset = r*num_cells_per_tile_;
+            for (const auto& [gid, label]: requests[r]) {
+                if (gid<offset) continue;
+                auto first = found.size();
+                find_label_entries(local_entries, {gid - offset, label}, found);
+                for (auto i = first; i<found.size(); ++i) found[i].gid = gid;
+            }
+        }
+        return found;
+    }
+
     distributed_request send_recv_nonblocking(std::size_t dest_count,
         void* dest_data,
         int dest,
@@ -125,10 +245,23 @@ struct dry_run_context_impl {
 
     unsigned num_ranks_;
     unsigned num_cells_per_tile_;
+    double latency_ = 0;
+    double bandwidth_ = 1;
+    std::shared_ptr<dry_run_report> report_;
+
+    // Spike synthesis for the non-local ranks, see dry_run_info.
+    std::vector<std::vector<double>> cumulative_rates_;
+    std::vector<std::vector<spike>> trace_;
+    mutable std::mt19937_64 rng_;
+    mutable epoch epoch_;
 };
 
 ARB_ARBOR_API std::shared_ptr<distributed_context> make_dry_run_context(unsigned num_ranks, unsigned num_cells_per_tile) {
     return std::make_shared<distributed_context>(dry_run_context_impl(num_ranks, num_cells_per_tile));
 }
 
+ARB_ARBOR_API std::shared_ptr<distributed_context> make_dry_run_context(const dry_run_info& info, std::shared_ptr<dry_run_report> report) {
+    return std::make_shared<distributed_context>(dry_run_context_impl(info, std::move(report)));
+}
+
 } // namespace arb
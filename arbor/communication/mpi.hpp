@@ -253,6 +253,47 @@ gathered_vector<T> gather_all_with_partition(const std::vector<T>& values, MPI_C
     );
 }
 
+/// Personalized all-to-all exchange: the values in `values`, partitioned by
+/// `counts`, are sent to the respective ranks. Returns the values received,
+/// partitioned by source rank.
+template <typename T>
+gathered_vector<T> alltoall_with_partition(const std::vector<T>& values, const std::vector<int>& counts, MPI_Comm comm) {
+    using gathered_type = gathered_vector<T>;
+    using count_type = typename gathered_vector<T>::count_type;
+    using traits = mpi_traits<T>;
+
+    const auto nranks = size(comm);
+    arb_assert(counts.size()==std::size_t(nranks));
+
+    std::vector<int> send_counts(counts), send_displs;
+    for (auto& c : send_counts) c *= traits::count();
+    util::make_partition(send_displs, send_counts);
+
+    std::vector<int> recv_counts(nranks), recv_displs;
+    MPI_OR_THROW(MPI_Alltoall,
+            send_counts.data(), 1, MPI_INT,
+            recv_counts.data(), 1, MPI_INT,
+            comm);
+    util::make_partition(recv_displs, recv_counts);
+
+    std::vector<T> buffer(recv_displs.back()/traits::count());
+
+    MPI_OR_THROW(MPI_Alltoallv,
+            // const_cast required for MPI implementations that don't use const* in their interfaces
+            const_cast<T*>(values.data()), send_counts.data(), send_displs.data(), traits::mpi_type(), // send buffer
+            buffer.data(), recv_counts.data(), recv_displs.data(), traits::mpi_type(),                 // receive buffer
+            comm);
+
+    for (auto& d : recv_displs) {
+        d /= traits::count();
+    }
+
+    return gathered_type(
+        std::move(buffer),
+        std::vector<count_type>(recv_displs.begin(), recv_displs.end())
+    );
+}
+
 template <typename T>
 T reduce(T value, MPI_Op op, int root, MPI_Comm comm) {
     using traits = mpi_traits<T>;
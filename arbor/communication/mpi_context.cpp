@@ -14,9 +14,13 @@
 #include <arbor/util/scope_exit.hpp>
 
 #include "communication/mpi.hpp"
+#include "communication/spike_packing.hpp"
 #include "distributed_context.hpp"
 #include "label_resolution.hpp"
 #include "affinity.hpp"
+#include "util/partition.hpp"
+#include "util/rangeutil.hpp"
+#include "util/span.hpp"
 
 namespace arb {
 
@@ -25,8 +29,12 @@ struct mpi_context_impl {
     int size_ = -1;
     int rank_ = -1;
     MPI_Comm comm_ = MPI_COMM_NULL;
+    // Exchange spikes in packed form if positive, see spike_packing.hpp.
+    time_type spike_time_resolution_ = 0;
 
-    explicit mpi_context_impl(MPI_Comm comm, bool bind=false): comm_(comm) {
+    explicit mpi_context_impl(MPI_Comm comm, bool bind=false, time_type spike_time_resolution=0):
+        comm_(comm), spike_time_resolution_(spike_time_resolution)
+    {
         size_ = mpi::size(comm_);
         rank_ = mpi::rank(comm_);
         if (bind) {
@@ -46,6 +54,10 @@ struct mpi_context_impl {
 
     gathered_vector<spike>
     gather_spikes(const std::vector<spike>& local_spikes) const {
+        if (spike_time_resolution_>0) {
+            auto packed = mpi::gather_all_with_partition(pack_spikes(local_spikes, spike_time_resolution_), comm_);
+            return unpack_spikes(packed, spike_time_resolution_);
+        }
         return mpi::gather_all_with_partition(local_spikes, comm_);
     }
 
@@ -69,6 +81,28 @@ struct mpi_context_impl {
         return cell_labels_and_gids(global_ranges, global_gids);
     }
 
+    // Send the requests to the owning ranks and reply with the matching entries.
+    std::vector<label_resolution_map::entry>
+    exchange_label_requests(const std::vector<label_resolution_map::entry>& local_entries,
+                            const std::vector<std::vector<label_resolution_map::key_type>>& requests) const {
+        std::vector<label_resolution_map::key_type> keys;
+        std::vector<int> counts;
+        for (const auto& req: requests) {
+            util::append(keys, req);
+            counts.push_back(req.size());
+        }
+        auto received = mpi::alltoall_with_partition(keys, counts, comm_);
+
+        std::vector<label_resolution_map::entry> replies;
+        counts.clear();
+        for (auto part: util::partition_view(received.partition())) {
+            auto first = replies.size();
+            for (auto i: util::make_span(part)) find_label_entries(local_entries, received.values()[i], replies);
+            counts.push_back(replies.size() - first);
+        }
+        return mpi::alltoall_with_partition(replies, counts, comm_).values();
+    }
+
     template <typename T>
     std::vector<T> gather(T value, int root) const {
         return mpi::gather(value, root, comm_);
@@ -158,8 +192,8 @@ struct mpi_context_impl {
 };
 
 template <>
-std::shared_ptr<distributed_context> make_mpi_context(MPI_Comm comm, bool bind) {
-    return std::make_shared<distributed_context>(mpi_context_impl(comm, bind));
+std::shared_ptr<distributed_context> make_mpi_context(MPI_Comm comm, bool bind, double spike_time_resolution) {
+    return std::make_shared<distributed_context>(mpi_context_impl(comm, bind, spike_time_resolution));
 }
 
 struct remote_context_impl {
@@ -210,6 +244,12 @@ struct remote_context_impl {
         return mpi_.send_recv_nonblocking(recv_count, recv_data, source_id, send_count, send_data, dest_id, tag);
     }
 
+    std::vector<label_resolution_map::entry>
+    exchange_label_requests(const std::vector<label_resolution_map::entry>& local_entries,
+                            const std::vector<std::vector<label_resolution_map::key_type>>& requests) const {
+        return mpi_.exchange_label_requests(local_entries, requests);
+    }
+
     template <typename T> std::vector<T> gather(T value, int root) const { return mpi_.gather(value, root); }
     std::string name() const { return "MPIRemote"; }
     int id() const { return mpi_.id(); }
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/spike.hpp>
+
+#include "communication/spike_packing.hpp"
+#include "util/rangeutil.hpp"
+#include "util/transform.hpp"
+
+namespace arb {
+
+namespace {
+
+enum : unsigned char { mode_offset = 0, mode_full = 1 };
+
+void put_varint(std::vector<char>& buf, std::uint64_t v) {
+    while (v>=0x80) {
+        buf.push_back(char(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(char(v));
+}
+
+template <typename T>
+void put_raw(std::vector<char>& buf, T v) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &v, sizeof(T));
+    buf.insert(buf.end(), bytes, bytes+sizeof(T));
+}
+
+struct reader {
+    const char* ptr;
+    const char* end;
+
+    void need(std::size_t n) const {
+        if (std::size_t(end-ptr)<n) throw arbor_internal_error("unpack_spikes: truncated buffer");
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t v = 0;
+        for (unsigned shift = 0; shift<64; shift += 7) {
+            need(1);
+            auto b = (unsigned char)*ptr++;
+            v |= std::uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        throw arbor_internal_error("unpack_spikes: malformed varint");
+    }
+
+    template <typename T>
+    T raw() {
+        need(sizeof(T));
+        T v;
+        std::memcpy(&v, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return v;
+    }
+};
+
+} // anonymous namespace
+
+std::vector<char> pack_spikes(const std::vector<spike>& spikes, time_type resolution) {
+    std::vector<char> buf;
+    put_varint(buf, spikes.size());
+    if (spikes.empty()) return buf;
+
+    auto by_source = [](const spike& a, const spike& b) { return a.source<b.source; };
+    std::vector<spike> sorted;
+    const std::vector<spike>* in = &spikes;
+    if (!std::is_sorted(spikes.begin(), spikes.end(), by_source)) {
+        sorted = spikes;
+        std::stable_sort(sorted.begin(), sorted.end(), by_source);
+        in = &sorted;
+    }
+
+    auto [lo, hi] = util::minmax_value(util::transform_view(*in, [](const spike& s) { return s.time; }));
+    bool offset = resolution>0 && (hi-lo)/resolution<std::numeric_limits<std::uint32_t>::max();
+
+    // Rough guess: a few bytes for the gid delta plus the time.
+    buf.reserve(buf.size() + 1 + sizeof(time_type) + in->size()*(offset? 8: 12));
+    buf.push_back(char(offset? mode_offset: mode_full));
+    put_raw(buf, lo);
+
+    cell_gid_type gid = 0;
+    for (const auto& s: *in) {
+        bool has_lid = s.source.index!=0;
+        put_varint(buf, (std::uint64_t(s.source.gid-gid) << 1) | has_lid);
+        if (has_lid) put_varint(buf, s.source.index);
+        gid = s.source.gid;
+
+        if (offset) put_raw(buf, std::uint32_t(std::lround((s.time-lo)/resolution)));
+        else put_raw(buf, s.time);
+    }
+    return buf;
+}
+
+void unpack_spikes(const char* begin, const char* end, time_type resolution, std::vector<spike>& out) {
+    reader r{begin, end};
+    auto n = r.varint();
+    if (!n) return;
+
+    auto mode = r.raw<unsigned char>();
+    auto base = r.raw<time_type>();
+    if (mode!=mode_offset && mode!=mode_full) throw arbor_internal_error("unpack_spikes: unknown mode");
+
+    out.reserve(out.size()+n);
+    cell_gid_type gid = 0;
+    for (std::uint64_t i = 0; i<n; ++i) {
+        auto key = r.varint();
+        gid += cell_gid_type(key >> 1);
+        cell_lid_type lid = key & 1? cell_lid_type(r.varint()): 0;
+        time_type t = mode==mode_offset? base + r.raw<std::uint32_t>()*resolution: r.raw<time_type>();
+        out.emplace_back(cell_member_type{gid, lid}, t);
+    }
+}
+
+gathered_vector<spike> unpack_spikes(const gathered_vector<char>& packed, time_type resolution) {
+    using count_type = gathered_vector<spike>::count_type;
+
+    const auto& bytes = packed.values();
+    const auto& part = packed.partition();
+
+    std::vector<spike> spikes;
+    std::vector<count_type> partition{0};
+    for (std::size_t i = 0; i+1<part.size(); ++i) {
+        unpack_spikes(bytes.data()+part[i], bytes.data()+part[i+1], resolution, spikes);
+        partition.push_back(spikes.size());
+    }
+    return gathered_vector<spike>(std::move(spikes), std::move(partition));
+}
+
+} // namespace arb
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+#include <arbor/common_types.hpp>
+#include <arbor/spike.hpp>
+
+#include "communication/gathered_vector.hpp"
+
+// Compact wire format for spike exchange.
+//
+// A block of spikes sorted by source is encoded as
+//
+//   count                   varint
+//   mode                    byte; 0: time offsets, 1: full times
+//   base                    double; earliest spike time
+//   per spike:
+//     gid delta << 1 | lid  varint; low bit set if the lid is non-zero
+//     lid                   varint; only if non-zero
+//     time                  uint32 offset from base in units of the
+//                           resolution, or double in mode 1
+//
+// Spikes from one epoch lie in a window of at most min_delay/2, so time
+// offsets fit comfortably into 32 bits for any sensible resolution; should
+// they not, the block falls back to full times. Times are otherwise rounded
+// to the resolution, and every rank, including the sender, sees the rounded
+// values.
+
+namespace arb {
+
+// Encode local spikes, sorting them by source first if needed.
+std::vector<char> pack_spikes(const std::vector<spike>& spikes, time_type resolution);
+
+// Append the spikes encoded in [begin, end) to out.
+void unpack_spikes(const char* begin, const char* end, time_type resolution, std::vector<spike>& out);
+
+// Decode a gathered set of blocks, one per rank, partitioned in bytes.
+gathered_vector<spike> unpack_spikes(const gathered_vector<char>& packed, time_type resolution);
+
+} // namespace arb
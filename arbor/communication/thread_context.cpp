@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/spike.hpp>
+
+#include "distributed_context.hpp"
+#include "label_resolution.hpp"
+#include "util/rangeutil.hpp"
+
+namespace arb {
+
+// State shared by all ranks of a thread context.
+struct thread_context_state {
+    explicit thread_context_state(unsigned n): size(n), slots(n) {}
+
+    const unsigned size;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned arrived = 0;
+    std::uint64_t generation = 0;
+
+    // Per rank contribution to the current collective.
+    std::vector<const void*> slots;
+
+    // Point-to-point messages in flight, by (source, destination, tag).
+    std::map<std::tuple<int, int, int>, std::deque<std::vector<char>>> mailbox;
+
+    void barrier() {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto gen = generation;
+        if (++arrived==size) {
+            arrived = 0;
+            ++generation;
+            cv.notify_all();
+        }
+        else {
+            cv.wait(lock, [&] { return generation!=gen; });
+        }
+    }
+};
+
+// One of several ranks in the same process, each to be driven by its own
+// thread. Collectives read the contributions of the other ranks in place:
+// every rank publishes a pointer to its argument, and the second barrier
+// keeps the arguments alive until all ranks are done reading.
+struct thread_context_impl {
+    using count_type = typename gathered_vector<spike>::count_type;
+
+    std::shared_ptr<thread_context_state> state_;
+    int rank_;
+
+    thread_context_impl(std::shared_ptr<thread_context_state> state, int rank):
+        state_(std::move(state)), rank_(rank) {}
+
+    template <typename T, typename F>
+    auto all_read(const T& local, F&& f) const {
+        state_->slots[rank_] = &local;
+        state_->barrier();
+        std::vector<const T*> all;
+        for (auto p: state_->slots) all.push_back(static_cast<const T*>(p));
+        auto result = f(all);
+        state_->barrier();
+        return result;
+    }
+
+    template <typename T>
+    gathered_vector<T> all_gather(const std::vector<T>& local) const {
+        return all_read(local, [](const auto& all) {
+            std::vector<T> values;
+            std::vector<count_type> partition = {0};
+            for (auto v: all) {
+                util::append(values, *v);
+                partition.push_back(values.size());
+            }
+            return gathered_vector<T>(std::move(values), std::move(partition));
+        });
+    }
+
+    gathered_vector<spike>
+    gather_spikes(const std::vector<spike>& local_spikes) const {
+        return all_gather(local_spikes);
+    }
+
+    std::vector<spike>
+    remote_gather_spikes(const std::vector<spike>& local_spikes) const {
+        return {};
+    }
+
+    gathered_vector<cell_gid_type>
+    gather_gids(const std::vector<cell_gid_type>& local_gids) const {
+        return all_gather(local_gids);
+    }
+
+    cell_label_range gather_cell_label_range(const cell_label_range& local_ranges) const {
+        return all_read(local_ranges, [](const auto& all) {
+            cell_label_range global_ranges;
+            for (auto r: all) global_ranges.append(*r);
+            return global_ranges;
+        });
+    }
+
+    cell_labels_and_gids gather_cell_labels_and_gids(const cell_labels_and_gids& local_labels_and_gids) const {
+        auto global_ranges = gather_cell_label_range(local_labels_and_gids.label_range);
+        auto gids = gather_gids(local_labels_and_gids.gids);
+        return cell_labels_and_gids(global_ranges, gids.values());
+    }
+
+    // Every rank publishes its label entries and answers its own requests by
+    // looking them up in the entries of the owning ranks in place.
+    std::vector<label_resolution_map::entry>
+    exchange_label_requests(const std::vector<label_resolution_map::entry>& local_entries,
+                            const std::vector<std::vector<label_resolution_map::key_type>>& requests) const {
+        return all_read(local_entries, [&](const auto& all) {
+            std::vector<label_resolution_map::entry> found;
+            for (unsigned r = 0; r<requests.size(); ++r) {
+                for (const auto& key: requests[r]) find_label_entries(*all[r], key, found);
+            }
+            return found;
+        });
+    }
+
+    // As with MPI, only the root receives the gathered values.
+    template <typename T>
+    std::vector<T> gather(T value, int root) const {
+        return all_read(value, [&](const auto& all) {
+            std::vector<T> values;
+            if (rank_==root) {
+                for (auto v: all) values.push_back(*v);
+            }
+            return values;
+        });
+    }
+
+    distributed_request send_recv_nonblocking(std::size_t recv_count,
+        void* recv_data,
+        int source_id,
+        std::size_t send_count,
+        const void* send_data,
+        int dest_id,
+        int tag) const {
+        if (source_id<0 || source_id>=size() || dest_id<0 || dest_id>=size())
+            throw arbor_internal_error(
+                "send_recv_nonblocking: source and destination id must be valid ranks.");
+
+        if (send_count) {
+            auto bytes = static_cast<const char*>(send_data);
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->mailbox[{rank_, dest_id, tag}].emplace_back(bytes, bytes+send_count);
+            state_->cv.notify_all();
+        }
+
+        // Receive on finalize, blocking until the matching message is posted.
+        struct thread_recv_request: distributed_request::distributed_request_interface {
+            std::shared_ptr<thread_context_state> state;
+            std::tuple<int, int, int> key;
+            std::size_t count;
+            void* data;
+
+            thread_recv_request(std::shared_ptr<thread_context_state> state, std::tuple<int, int, int> key,
+                                std::size_t count, void* data):
+                state(std::move(state)), key(key), count(count), data(data) {}
+
+            void finalize() override {
+                if (!count) return;
+                std::unique_lock<std::mutex> lock(state->mutex);
+                auto& queue = state->mailbox[key];
+                state->cv.wait(lock, [&] { return !queue.empty(); });
+                auto msg = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+
+                if (msg.size()!=count)
+                    throw arbor_internal_error(
+                        "send_recv_nonblocking: message size does not match recv_count.");
+                std::memcpy(data, msg.data(), count);
+            }
+        };
+
+        return distributed_request{
+            std::make_unique<thread_recv_request>(state_, std::make_tuple(source_id, rank_, tag), recv_count, recv_data)};
+    }
+
+    template <typename T>
+    T min(T value) const {
+        return all_read(value, [](const auto& all) { T r = *all[0]; for (auto v: all) r = std::min(r, *v); return r; });
+    }
+
+    template <typename T>
+    T max(T value) const {
+        return all_read(value, [](const auto& all) { T r = *all[0]; for (auto v: all) r = std::max(r, *v); return r; });
+    }
+
+    template <typename T>
+    T sum(T value) const {
+        return all_read(value, [](const auto& all) { T r = 0; for (auto v: all) r += *v; return r; });
+    }
+
+    void remote_ctrl_send_continue(const epoch&) const {}
+    void remote_ctrl_send_done() const {}
+
+    int id() const { return rank_; }
+
+    int size() const { return state_->size; }
+
+    void barrier() const { state_->barrier(); }
+
+    std::string name() const { return "threads"; }
+};
+
+ARB_ARBOR_API std::vector<distributed_context_handle> make_thread_distributed_contexts(unsigned num_ranks) {
+    if (!num_ranks) throw arbor_exception("thread context: need at least one rank");
+
+    auto state = std::make_shared<thread_context_state>(num_ranks);
+    std::vector<distributed_context_handle> contexts;
+    for (unsigned i = 0; i<num_ranks; ++i) {
+        contexts.push_back(std::make_shared<distributed_context>(thread_context_impl(state, i)));
+    }
+    return contexts;
+}
+
+} // namespace arb
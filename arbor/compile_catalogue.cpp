@@ -0,0 +1,214 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/mechcat.hpp>
+#include <arbor/version.hpp>
+
+#include "util/dylib.hpp"
+#include "util/strprintf.hpp"
+
+// Tools and headers, provided by the build system. Relative directories are
+// resolved against the installation prefix at run time.
+
+#ifndef ARB_CXX_PATH
+#define ARB_CXX_PATH "c++"
+#endif
+#ifndef ARB_BINDIR
+#define ARB_BINDIR "bin"
+#endif
+#ifndef ARB_INCLUDEDIR
+#define ARB_INCLUDEDIR "include"
+#endif
+
+namespace arb {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// FNV-1a; unlike std::hash, stable across processes and platforms, which is
+// what makes it usable as a cache key.
+struct content_hash {
+    std::uint64_t value = 0xcbf29ce484222325ull;
+
+    void add(const std::string& s) {
+        for (unsigned char c: s) mix(c);
+        // Terminate each item so that concatenations differ.
+        for (auto n = s.size(); n; n >>= 8) mix(n & 0xff);
+        mix(0xff);
+    }
+
+    void mix(unsigned char c) {
+        value ^= c;
+        value *= 0x100000001b3ull;
+    }
+
+    std::string hex() const { return util::strprintf("%016llx", (unsigned long long)value); }
+};
+
+std::string quote(const std::string& s) {
+    std::string r = "'";
+    for (auto c: s) {
+        if (c=='\'') r += "'\\''";
+        else r += c;
+    }
+    return r + "'";
+}
+
+fs::path default_cache_dir() {
+    if (auto xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) return fs::path(xdg)/"arbor";
+    if (auto home = std::getenv("HOME"); home && *home) return fs::path(home)/".cache"/"arbor";
+    return fs::temp_directory_path()/"arbor";
+}
+
+// Installed modcc and headers. The installation prefix is the closest ancestor
+// of the object holding libarbor -- the library itself, or the executable or
+// Python module it is linked into -- that contains arbor's headers. If there
+// is none, modcc is taken from PATH.
+struct installation {
+    fs::path modcc = "modcc";
+    std::vector<fs::path> include_dirs;
+};
+
+installation find_installation() {
+    installation inst;
+    fs::path object;
+    try {
+        object = util::dl_object_path((const void*)&find_installation);
+    }
+    catch (util::dl_error&) {}
+
+    for (auto dir = object.parent_path(); !dir.empty(); dir = dir.parent_path()) {
+        auto include = dir/ARB_INCLUDEDIR;
+        if (fs::exists(include/"arbor"/"mechanism_abi.h")) {
+            inst.include_dirs.push_back(include);
+            if (auto modcc = dir/ARB_BINDIR/"modcc"; fs::exists(modcc)) inst.modcc = modcc;
+            break;
+        }
+        if (dir==dir.parent_path()) break;
+    }
+#ifdef ARB_MODCC_PATH
+    inst.modcc = ARB_MODCC_PATH;
+#endif
+    return inst;
+}
+
+// Output of command, including stderr; empty if it cannot be started. Results
+// are kept for the lifetime of the process, as they are queried on every call
+// of compile_catalogue, including those served from the cache.
+std::string capture(const std::string& command) {
+    static std::mutex mtx;
+    static std::map<std::string, std::string> outputs;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (auto it = outputs.find(command); it!=outputs.end()) return it->second;
+
+    std::string out;
+    if (auto pipe = popen((command + " 2>&1").c_str(), "r")) {
+        char buf[4096];
+        for (std::size_t n; (n = std::fread(buf, 1, sizeof buf, pipe));) out.append(buf, n);
+        pclose(pipe);
+    }
+    return outputs[command] = out;
+}
+
+// Run command, writing its output to log; throw with the log on failure.
+void run(const std::string& command, const fs::path& log) {
+    if (std::system((command + " >" + quote(log.string()) + " 2>&1").c_str())) {
+        std::ifstream in(log);
+        std::stringstream text;
+        text << in.rdbuf();
+        throw catalogue_compile_error(command, text.str());
+    }
+}
+
+} // anonymous namespace
+
+ARB_ARBOR_API const mechanism_catalogue compile_catalogue(const std::vector<std::string>& nmodl,
+                                                          const compile_catalogue_options& opt) {
+    static const installation inst = find_installation();
+    auto modcc = opt.modcc.empty()? inst.modcc: opt.modcc;
+    auto cxx = opt.cxx.empty()? fs::path(ARB_CXX_PATH): opt.cxx;
+    auto include_dirs = opt.include_dirs.empty()? inst.include_dirs: opt.include_dirs;
+    auto cache_dir = opt.cache_dir.empty()? default_cache_dir(): opt.cache_dir;
+
+    content_hash hash;
+    hash.add(ARB_FULL_BUILD_ID);
+    hash.add(ARB_SOURCE_ID);
+    hash.add(modcc.string());
+    hash.add(cxx.string());
+    // Tools may be replaced in place, and flags like -march=native resolve to
+    // a different target on each host sharing the cache. Key the cache on the
+    // tool versions and on the target as expanded by the compiler driver.
+    hash.add(capture(quote(modcc.string()) + " --version"));
+    hash.add(capture(quote(cxx.string()) + " --version"));
+    std::string target_cmd = quote(cxx.string());
+    for (const auto& f: opt.cxx_flags) target_cmd += " " + quote(f);
+    hash.add(capture(target_cmd + " -### -E -x c++ /dev/null"));
+    for (const auto& f: opt.modcc_flags) hash.add(f);
+    hash.add("--");
+    for (const auto& f: opt.cxx_flags) hash.add(f);
+    hash.add("--");
+    for (const auto& d: include_dirs) hash.add(d.string());
+    hash.add("--");
+    for (const auto& s: nmodl) hash.add(s);
+
+    auto target = cache_dir/hash.hex();
+    auto so = target/"catalogue.so";
+    if (fs::exists(so)) return load_catalogue(so);
+
+    // Build in a private directory and move it into place when done, such
+    // that concurrent compilations of the same catalogue do not collide.
+    auto work = cache_dir/util::strprintf("%s.%d", hash.hex(), (int)getpid());
+    fs::remove_all(work);
+    try {
+        fs::create_directories(work/"mod");
+        fs::create_directories(work/"generated");
+
+        std::string modcc_cmd = quote(modcc.string()) + " -t cpu -N arb -c jit -o " + quote((work/"generated").string());
+        for (const auto& f: opt.modcc_flags) modcc_cmd += " " + quote(f);
+        for (std::size_t i = 0; i<nmodl.size(); ++i) {
+            auto fn = work/"mod"/util::strprintf("mechanism_%d.mod", (int)i);
+            std::ofstream(fn) << nmodl[i];
+            modcc_cmd += " " + quote(fn.string());
+        }
+        run(modcc_cmd, work/"modcc.log");
+
+        std::string cxx_cmd = quote(cxx.string()) + " -std=c++17 -fPIC -shared -DSTANDALONE=1";
+        for (const auto& f: opt.cxx_flags) cxx_cmd += " " + quote(f);
+        for (const auto& d: include_dirs) cxx_cmd += " -I" + quote(d.string());
+        cxx_cmd += " -I" + quote((work/"generated").string());
+        for (const auto& e: fs::directory_iterator(work/"generated")) {
+            if (e.path().extension()==".cpp") cxx_cmd += " " + quote(e.path().string());
+        }
+        cxx_cmd += " -o " + quote((work/"catalogue.so").string());
+        run(cxx_cmd, work/"cxx.log");
+    }
+    catch (...) {
+        // Do not leave partial builds behind in the cache.
+        std::error_code ec;
+        fs::remove_all(work, ec);
+        throw;
+    }
+
+    // Another process may have completed the same catalogue in the meantime.
+    std::error_code ec;
+    fs::rename(work, target, ec);
+    if (ec) fs::remove_all(work);
+
+    return load_catalogue(so);
+}
+
+} // namespace arb
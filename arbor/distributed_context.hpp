@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <cstring>
+#include <vector>
 
 #include <arbor/export.hpp>
 #include <arbor/context.hpp>
@@ -77,6 +78,8 @@ public:
     using spike_vector = std::vector<arb::spike>;
     using gid_vector = std::vector<cell_gid_type>;
     using gj_connection_vector = std::vector<gid_vector>;
+    using label_entry_vector = std::vector<label_resolution_map::entry>;
+    using label_request_vector = std::vector<std::vector<label_resolution_map::key_type>>;
 
     // default constructor uses a local context: see below.
     distributed_context();
@@ -113,6 +116,14 @@ public:
         return impl_->gather(value, root);
     }
 
+    // Send the (gid, label) pairs in requests[r] to rank r, which answers them
+    // from its label entries, see find_label_entries. Returns the entries
+    // matching the requests of this rank.
+    label_entry_vector exchange_label_requests(const label_entry_vector& local_entries,
+                                               const label_request_vector& requests) const {
+        return impl_->exchange_label_requests(local_entries, requests);
+    }
+
     template <typename T>
     distributed_request send_recv_nonblocking(std::size_t recv_count,
         T* recv_data,
@@ -169,6 +180,8 @@ private:
         gather_cell_labels_and_gids(const cell_labels_and_gids& local_labels_and_gids) const = 0;
         virtual std::vector<std::string>
         gather(std::string value, int root) const = 0;
+        virtual label_entry_vector
+        exchange_label_requests(const label_entry_vector& local_entries, const label_request_vector& requests) const = 0;
         virtual distributed_request send_recv_nonblocking(std::size_t recv_count,
             void* recv_data,
             int source_id,
@@ -217,6 +230,10 @@ private:
         gather(std::string value, int root) const override {
             return wrapped.gather(value, root);
         }
+        label_entry_vector
+        exchange_label_requests(const label_entry_vector& local_entries, const label_request_vector& requests) const override {
+            return wrapped.exchange_label_requests(local_entries, requests);
+        }
         distributed_request send_recv_nonblocking(std::size_t recv_count,
             void* recv_data,
             int source_id,
@@ -286,6 +303,13 @@ struct local_context {
     std::vector<T> gather(T value, int) const {
         return {std::move(value)};
     }
+    std::vector<label_resolution_map::entry>
+    exchange_label_requests(const std::vector<label_resolution_map::entry>& local_entries,
+                            const std::vector<std::vector<label_resolution_map::key_type>>& requests) const {
+        std::vector<label_resolution_map::entry> found;
+        for (const auto& key: requests.at(0)) find_label_entries(local_entries, key, found);
+        return found;
+    }
 
     distributed_request send_recv_nonblocking(std::size_t dest_count,
         void* dest_data,
@@ -336,10 +360,15 @@ distributed_context_handle make_local_context() {
 }
 
 ARB_ARBOR_API distributed_context_handle make_dry_run_context(unsigned num_ranks, unsigned num_cells_per_rank);
+ARB_ARBOR_API distributed_context_handle make_dry_run_context(const dry_run_info& info, std::shared_ptr<dry_run_report> report = {});
+
+// Contexts for num_ranks ranks sharing this process, one per rank, each to be
+// used from its own thread.
+ARB_ARBOR_API std::vector<distributed_context_handle> make_thread_distributed_contexts(unsigned num_ranks);
 
 // MPI context creation functions only provided if built with MPI support.
 template <typename MPICommType>
-distributed_context_handle make_mpi_context(MPICommType, bool bind=false);
+distributed_context_handle make_mpi_context(MPICommType, bool bind=false, double spike_time_resolution=0);
 
 template <typename MPICommType>
 distributed_context_handle make_remote_context(MPICommType, MPICommType);
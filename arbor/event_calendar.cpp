@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <arbor/math.hpp>
+#include <arbor/spike_event.hpp>
+
+#include "event_calendar.hpp"
+
+namespace arb {
+
+namespace {
+// Heap order for far events: earliest on top.
+constexpr auto later = std::greater<>{};
+} // anonymous namespace
+
+event_calendar::event_calendar(time_type width) {
+    set_width(width);
+}
+
+event_calendar::index_type event_calendar::index(time_type t) const {
+    // Clamp, such that events at or near terminal_time cannot overflow;
+    // these wait in the heap in any case.
+    constexpr auto max_index = index_type(1) << 52;
+    auto k = std::floor(t/width_);
+    return k>0? (k<max_index? index_type(k): max_index): 0;
+}
+
+void event_calendar::set_width(time_type width) {
+    if (!(width>0) || !std::isfinite(width)) width = std::numeric_limits<time_type>::max();
+    if (width==width_) return;
+
+    pse_vector evs = std::move(far_);
+    for (auto& b: buckets_) {
+        evs.insert(evs.end(), b.begin(), b.end());
+    }
+    time_type t_base = base_*width_;
+
+    width_ = width;
+    clear();
+    base_ = index(t_base);
+    insert(evs);
+}
+
+void event_calendar::insert(const spike_event& ev) {
+    auto k = std::max(index(ev.time), base_);
+    auto n = std::size_t(k-base_+1);
+    ++size_;
+
+    if (n>buckets_.size()) {
+        if (n>max_buckets) {
+            far_.push_back(ev);
+            std::push_heap(far_.begin(), far_.end(), later);
+            return;
+        }
+        grow(math::next_pow2(n));
+    }
+    bucket(k).push_back(ev);
+}
+
+void event_calendar::take(time_type t, pse_vector& out) {
+    auto first = out.size();
+    auto k_end = index(t);
+
+    // Far events that are due already, should t have skipped past the ring.
+    while (!far_.empty() && far_.front().time<t) {
+        std::pop_heap(far_.begin(), far_.end(), later);
+        out.push_back(far_.back());
+        far_.pop_back();
+        --size_;
+    }
+
+    // Buckets before the one containing t are due in full; that one only in part.
+    auto n_bucket = index_type(buckets_.size());
+    for (auto k = base_; k<std::min(k_end, base_+n_bucket); ++k) {
+        auto& b = bucket(k);
+        out.insert(out.end(), b.begin(), b.end());
+        size_ -= b.size();
+        b.clear();
+    }
+    if (auto k = std::max(k_end, base_); k<base_+n_bucket) {
+        auto& b = bucket(k);
+        auto keep = b.begin();
+        for (auto& ev: b) {
+            if (ev.time<t) out.push_back(ev);
+            else *keep++ = ev;
+        }
+        size_ -= b.end()-keep;
+        b.erase(keep, b.end());
+    }
+    base_ = std::max(base_, k_end);
+
+    // Move far events into the ring once it reaches them.
+    while (!far_.empty() && index(far_.front().time)<base_+index_type(max_buckets)) {
+        std::pop_heap(far_.begin(), far_.end(), later);
+        auto ev = far_.back();
+        far_.pop_back();
+        --size_;
+        insert(ev);
+    }
+
+    std::sort(out.begin()+first, out.end());
+}
+
+void event_calendar::clear() {
+    base_ = 0;
+    for (auto& b: buckets_) b.clear();
+    far_.clear();
+    size_ = 0;
+}
+
+void event_calendar::grow(std::size_t n) {
+    std::vector<pse_vector> buckets(n);
+    for (auto k = base_; k<base_+index_type(buckets_.size()); ++k) {
+        buckets[k & (n-1)] = std::move(bucket(k));
+    }
+    std::swap(buckets, buckets_);
+}
+
+} // namespace arb
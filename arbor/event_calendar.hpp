@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <arbor/export.hpp>
+#include <arbor/common_types.hpp>
+#include <arbor/serdes.hpp>
+#include <arbor/spike_event.hpp>
+
+namespace arb {
+
+// Pending events of a single cell, bucketed by delivery time.
+//
+// Bucket k holds the events with delivery time in [k·width, (k+1)·width).
+// Events are inserted once, into the bucket of their delivery time, and are
+// only sorted when taken out as they fall due. Hence an event with a long
+// delay is not copied again for every epoch it spends in flight.
+//
+// The buckets form a ring that grows on demand, up to max_buckets; events
+// further in the future wait in a heap ordered by time and move into the
+// ring once it reaches them.
+
+class ARB_ARBOR_API event_calendar {
+public:
+    static constexpr std::size_t max_buckets = 64;
+
+    explicit event_calendar(time_type width = 1);
+
+    // Change the bucket width, re-binning any stored events.
+    void set_width(time_type width);
+    time_type width() const { return width_; }
+
+    void insert(const spike_event& ev);
+
+    void insert(const pse_vector& evs) {
+        for (const auto& ev: evs) insert(ev);
+    }
+
+    // Move all events with time < t to the end of out, in sorted order.
+    void take(time_type t, pse_vector& out);
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return !size_; }
+
+    void clear();
+
+    ARB_SERDES_ENABLE(event_calendar, width_, base_, buckets_, far_, size_);
+
+private:
+    using index_type = std::int64_t;
+
+    index_type index(time_type t) const;
+    pse_vector& bucket(index_type k) { return buckets_[k & (buckets_.size()-1)]; }
+    void grow(std::size_t n);
+
+    time_type width_ = 0;
+    // Index of the earliest bucket in the ring.
+    index_type base_ = 0;
+    // Ring of buckets [base_, base_+buckets_.size()); the size is a power of two.
+    std::vector<pse_vector> buckets_;
+    // Min-heap of events beyond the ring.
+    pse_vector far_;
+    std::size_t size_ = 0;
+};
+
+} // namespace arb
@@ -1,5 +1,7 @@
 #include <memory>
+#include <vector>
 
+#include <arbor/arbexcept.hpp>
 #include <arbor/context.hpp>
 
 #include "gpu_context.hpp"
@@ -24,11 +26,26 @@ ARB_ARBOR_API context make_context(const proc_allocation& p) {
     return std::make_shared<execution_context>(p);
 }
 
+execution_context::execution_context(const proc_allocation& resources, distributed_context_handle d):
+    distributed(std::move(d)),
+    thread_pool(std::make_shared<threading::task_system>(resources.num_threads, resources.bind_threads)),
+    gpu(resources.has_gpu()? std::make_shared<gpu_context>(resources.gpu_id)
+                           : std::make_shared<gpu_context>())
+{}
+
+ARB_ARBOR_API std::vector<context> make_thread_contexts(const proc_allocation& p, unsigned num_ranks) {
+    std::vector<context> contexts;
+    for (auto& d: make_thread_distributed_contexts(num_ranks)) {
+        contexts.push_back(std::make_shared<execution_context>(p, std::move(d)));
+    }
+    return contexts;
+}
+
 #ifdef ARB_HAVE_MPI
 
 template <>
 execution_context::execution_context(const proc_allocation& resources, MPI_Comm comm):
-    distributed(make_mpi_context(comm, resources.bind_procs)),
+    distributed(make_mpi_context(comm, resources.bind_procs, resources.spike_time_resolution)),
     thread_pool(std::make_shared<threading::task_system>(resources.num_threads, resources.bind_threads)),
     gpu(resources.has_gpu()? std::make_shared<gpu_context>(resources.gpu_id)
                            : std::make_shared<gpu_context>())
@@ -57,11 +74,13 @@ template <>
 execution_context::execution_context(
         const proc_allocation& resources,
         dry_run_info d):
-        distributed(make_dry_run_context(d.num_ranks, d.num_cells_per_rank)),
         thread_pool(std::make_shared<threading::task_system>(resources.num_threads, resources.bind_threads)),
         gpu(resources.has_gpu()? std::make_shared<gpu_context>(resources.gpu_id)
-                               : std::make_shared<gpu_context>())
-{}
+                               : std::make_shared<gpu_context>()),
+        dry_run(std::make_shared<dry_run_report>())
+{
+    distributed = make_dry_run_context(d, dry_run);
+}
 
 template <>
 ARB_ARBOR_API context make_context(const proc_allocation& p, dry_run_info d) {
@@ -88,6 +107,11 @@ ARB_ARBOR_API unsigned rank(context ctx) {
     return ctx->distributed->id();
 }
 
+ARB_ARBOR_API dry_run_report dry_run_statistics(context ctx) {
+    if (!ctx->dry_run) throw arbor_exception("dry_run_statistics: not a dry-run context");
+    return *ctx->dry_run;
+}
+
 ARB_ARBOR_API bool has_mpi(context ctx) {
     return ctx->distributed->name() == "MPI";
 }
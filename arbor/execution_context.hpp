@@ -24,6 +24,8 @@ struct ARB_ARBOR_API execution_context {
     distributed_context_handle distributed;
     task_system_handle thread_pool;
     gpu_context_handle gpu;
+    // Statistics of the spike exchange, for dry-run contexts only.
+    std::shared_ptr<dry_run_report> dry_run;
 
     execution_context(const proc_allocation& resources = proc_allocation{1,gpu_nil_id});
 
@@ -34,6 +36,8 @@ struct ARB_ARBOR_API execution_context {
 
     template <typename Comm>
     execution_context(const proc_allocation& resources, Comm comm, Comm remote);
+
+    execution_context(const proc_allocation& resources, distributed_context_handle distributed);
 };
 
 } // namespace arb
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 #include <optional>
 #include <set>
 #include <unordered_set>
@@ -15,6 +16,7 @@
 #include <arbor/morph/mcable_map.hpp>
 #include <arbor/morph/mprovider.hpp>
 #include <arbor/morph/morphology.hpp>
+#include <arbor/morph/place_pwlin.hpp>
 
 #include "fvm_layout.hpp"
 #include "threading/threading.hpp"
@@ -698,6 +700,54 @@ ARB_ARBOR_API fvm_voltage_interpolant fvm_axial_current(const cable_cell& cell,
     return vi;
 }
 
+namespace {
+// Mean of 1/|x-e| [1/µm] over the axis x of the segment, clamping distances
+// to the segment radius to avoid the singularity on the axis.
+double line_source_mean(const msegment& seg, const mpoint& e) {
+    double dx = seg.dist.x-seg.prox.x, dy = seg.dist.y-seg.prox.y, dz = seg.dist.z-seg.prox.z;
+    double len = std::sqrt(dx*dx+dy*dy+dz*dz);
+    double rmin = std::max(0.5*(seg.prox.radius+seg.dist.radius), 1e-3);
+
+    double ex = e.x-seg.prox.x, ey = e.y-seg.prox.y, ez = e.z-seg.prox.z;
+    double d2 = ex*ex+ey*ey+ez*ez;
+    if (len<1e-9) return 1/std::max(std::sqrt(d2), rmin);
+
+    // Distance along the axis of the projection of e, and from the axis.
+    double h = (ex*dx+ey*dy+ez*dz)/len;
+    double r = std::max(std::sqrt(std::max(d2-h*h, 0.)), rmin);
+    return (std::asinh((len-h)/r)+std::asinh(h/r))/len;
+}
+}
+
+ARB_ARBOR_API std::vector<double> fvm_line_source_transfer(const cable_cell& cell, const mcable_list& cables, const std::vector<mpoint>& electrodes, double sigma) {
+    if (!(sigma>0)) throw cable_cell_error("extracellular conductivity must be positive");
+
+    const double coef = 1/(4*math::pi<double>*sigma); // [mV/nA·µm]
+    place_pwlin place(cell.morphology());
+    std::vector<double> transfer(electrodes.size()*cables.size(), 0.);
+
+    for (auto c: util::count_along(cables)) {
+        auto segs = place.segments(mextent(mcable_list{cables[c]}));
+
+        // Share of the cable current carried by each segment, by lateral area.
+        std::vector<double> share;
+        for (const auto& s: segs) {
+            share.push_back(math::area_frustrum(distance(s.prox, s.dist), s.prox.radius, s.dist.radius));
+        }
+        double total = util::sum(share);
+        if (total<=0) continue;
+
+        for (auto i: util::count_along(electrodes)) {
+            double phi = 0;
+            for (auto k: util::count_along(segs)) {
+                phi += share[k]/total*line_source_mean(segs[k], electrodes[i]);
+            }
+            transfer[i*cables.size()+c] = coef*phi;
+        }
+    }
+    return transfer;
+}
+
 // FVM mechanism data
 // ------------------
 
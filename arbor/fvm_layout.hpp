@@ -199,6 +199,12 @@ ARB_ARBOR_API fvm_voltage_interpolant fvm_interpolate_voltage(const cable_cell&
 // Axial current as linear combiantion of voltages.
 ARB_ARBOR_API fvm_voltage_interpolant fvm_axial_current(const cable_cell& cell, const fvm_cv_discretization& D, arb_size_type cell_idx, const mlocation& site);
 
+// Extracellular potential [mV] at each electrode per unit current [nA] through
+// each cable, in a homogeneous medium of conductivity sigma [S/m]. The current
+// of a cable is distributed over its segments by membrane area, and each
+// segment is treated as a line source. Result is electrode × cable, row-major.
+ARB_ARBOR_API std::vector<double> fvm_line_source_transfer(const cable_cell& cell, const mcable_list& cables, const std::vector<mpoint>& electrodes, double sigma);
+
 
 // Post-discretization data for point and density mechanism instantiation.
 
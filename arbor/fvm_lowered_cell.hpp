@@ -128,6 +128,43 @@ struct fvm_probe_membrane_currents {
     util::any_ptr get_metadata_ptr() const { return &metadata; }
 };
 
+// Extracellular potentials are a linear function of the same raw data as
+// membrane currents; the transfer matrix folds the current computation and
+// the line source weights. It is stored in CSR format, one row per electrode.
+struct fvm_probe_extracellular_potential {
+    std::vector<probe_handle> raw_handles;   // Voltage per CV, followed by stim current densities.
+    std::vector<unsigned> transfer_divs;     // Partition of the entries by electrode.
+    std::vector<unsigned> transfer_index;    // Raw handle index of each entry.
+    std::vector<double> transfer;            // Coefficient of each entry.
+    std::vector<mpoint> metadata;            // Electrode positions.
+
+    void shrink_to_fit() {
+        raw_handles.shrink_to_fit();
+        transfer_divs.shrink_to_fit();
+        transfer_index.shrink_to_fit();
+        transfer.shrink_to_fit();
+        metadata.shrink_to_fit();
+    }
+
+    util::any_ptr get_metadata_ptr() const { return &metadata; }
+};
+
+// Reductions are evaluated by the back-end: raw handles refer to the
+// results, a single value for scalar reductions or one per histogram bin.
+struct fvm_probe_reduction {
+    std::vector<probe_handle> raw_handles;
+    cable_probe_reduction_info metadata;
+
+    void shrink_to_fit() {
+        raw_handles.shrink_to_fit();
+        metadata.cables.shrink_to_fit();
+        metadata.points.shrink_to_fit();
+        metadata.edges.shrink_to_fit();
+    }
+
+    util::any_ptr get_metadata_ptr() const { return &metadata; }
+};
+
 struct missing_probe_info {
     // dummy data...
     std::array<probe_handle, 0> raw_handles;
@@ -144,6 +181,8 @@ struct fvm_probe_data {
     fvm_probe_data(fvm_probe_weighted_multi p): info(std::move(p)) {}
     fvm_probe_data(fvm_probe_interpolated_multi p): info(std::move(p)) {}
     fvm_probe_data(fvm_probe_membrane_currents p): info(std::move(p)) {}
+    fvm_probe_data(fvm_probe_extracellular_potential p): info(std::move(p)) {}
+    fvm_probe_data(fvm_probe_reduction p): info(std::move(p)) {}
 
     std::variant<
         missing_probe_info,
@@ -152,7 +191,9 @@ struct fvm_probe_data {
         fvm_probe_multi,
         fvm_probe_weighted_multi,
         fvm_probe_interpolated_multi,
-        fvm_probe_membrane_currents
+        fvm_probe_membrane_currents,
+        fvm_probe_extracellular_potential,
+        fvm_probe_reduction
     > info = missing_probe_info{};
 
     auto raw_handle_range() const {
@@ -172,6 +213,9 @@ struct fvm_probe_data {
 
     sample_size_type n_raw() const { return raw_handle_range().size(); }
 
+    // Index of the first raw handle in the back-end sample handle table.
+    sample_size_type handle_offset = 0;
+
     explicit operator bool() const { return !std::get_if<missing_probe_info>(&info); }
 };
 
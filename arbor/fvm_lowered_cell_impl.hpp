@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <optional>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include <arbor/recipe.hpp>
 #include <arbor/util/any_visitor.hpp>
 
+#include "cell_group.hpp"
 #include "execution_context.hpp"
 #include "fvm_layout.hpp"
 #include "fvm_lowered_cell.hpp"
@@ -25,7 +27,9 @@
 #include "profile/profiler_macro.hpp"
 #include "util/maputil.hpp"
 #include "util/meta.hpp"
+#include "util/partition.hpp"
 #include "util/rangeutil.hpp"
+#include "util/span.hpp"
 #include "util/strprintf.hpp"
 #include "util/transform.hpp"
 
@@ -348,6 +352,8 @@ fvm_lowered_cell_impl<Backend>::add_probes(const std::vector<cell_gid_type>& gid
                 cell_address_type addr{gid, pi.tag};
                 if (probe_map.count(addr)) throw dup_cell_probe(cell_kind::cable, gid, pi.tag);
                 for (auto& data: probe_data) {
+                    auto handles = data.raw_handle_range();
+                    data.handle_offset = state_->add_sample_handles(handles.begin(), handles.end());
                     probe_map.insert(addr, std::move(data));
                 }
             }
@@ -372,11 +378,13 @@ fvm_lowered_cell_impl<Backend>::initialize(const std::vector<cell_gid_type>& gid
     const std::size_t ncell = gids.size();
 
     cells.resize(ncell);
+    // A batched query is answered in one call, otherwise cells are queried in parallel.
+    auto batch = batched_cell_descriptions(rec, gids);
     threading::parallel_for::apply(0, gids.size(), context_.thread_pool.get(),
            [&](cell_size_type i) {
                auto gid = gids[i];
                try {
-                   cells[i] = any_cast<cable_cell&&>(rec.get_cell_description(gid));
+                   cells[i] = any_cast<cable_cell&&>(batch.empty()? rec.get_cell_description(gid): std::move(batch[i]));
                }
                catch (std::bad_any_cast&) {
                    throw bad_cell_description(rec.get_cell_kind(gid), gid);
@@ -654,6 +662,7 @@ void fvm_lowered_cell_impl<Backend>::resolve_probe_address(std::vector<fvm_probe
         cable_probe_total_ion_current_cell,
         cable_probe_total_current_cell,
         cable_probe_stimulus_current_cell,
+        cable_probe_extracellular_potential,
         cable_probe_density_state,
         cable_probe_density_state_cell,
         cable_probe_point_state,
@@ -665,7 +674,11 @@ void fvm_lowered_cell_impl<Backend>::resolve_probe_address(std::vector<fvm_probe
         cable_probe_ion_diff_concentration,
         cable_probe_ion_diff_concentration_cell,
         cable_probe_ion_ext_concentration,
-        cable_probe_ion_ext_concentration_cell>;
+        cable_probe_ion_ext_concentration_cell,
+        cable_probe_membrane_voltage_mean,
+        cable_probe_total_ion_current_sum,
+        cable_probe_point_state_sum,
+        cable_probe_membrane_voltage_histogram>;
 
     auto visitor = util::overload(
         [&prd](auto& probe_addr) { resolve_probe(probe_addr, prd); },
@@ -765,7 +778,7 @@ void resolve_probe(const cable_probe_total_ion_current_cell& p, probe_resolution
 }
 
 template <typename B>
-void resolve_probe(const cable_probe_total_current_cell& p, probe_resolution_data<B>& R) {
+fvm_probe_membrane_currents membrane_currents(probe_resolution_data<B>& R) {
     fvm_probe_membrane_currents r;
 
     auto cell_cv_ival = R.D.geometry.cell_cv_interval(R.cell_idx);
@@ -800,6 +813,72 @@ void resolve_probe(const cable_probe_total_current_cell& p, probe_resolution_dat
         r.stim_cv.push_back(cv-cv0);
         r.stim_scale.push_back(0.001*R.D.cv_area[cv]); // Scale from [µm²·A/m²] to [nA].
     }
+    return r;
+}
+
+template <typename B>
+void resolve_probe(const cable_probe_total_current_cell& p, probe_resolution_data<B>& R) {
+    auto r = membrane_currents(R);
+    r.shrink_to_fit();
+    R.result.push_back(std::move(r));
+}
+
+template <typename B>
+void resolve_probe(const cable_probe_extracellular_potential& p, probe_resolution_data<B>& R) {
+    // Electrode potentials are T·I for the cable currents I of
+    // cable_probe_total_current_cell; with the per-CV transfer G, combining
+    // the weights of the cables of each CV, expand I in terms of raw data.
+    auto I = membrane_currents(R);
+    const auto n_cv = I.cv_parent.size();
+    const auto n_raw = I.raw_handles.size();
+    const auto n_cable = I.metadata.size();
+    const auto cables_by_cv = util::partition_view(I.cv_cables_divs);
+
+    if (!(p.cutoff>=0 && p.cutoff<=1)) throw cable_cell_error("extracellular potential cutoff must be in [0, 1]");
+    auto T = fvm_line_source_transfer(R.cell, I.metadata, p.electrodes, p.sigma);
+
+    // Assemble each row densely, then keep its non-zero entries. CVs whose
+    // weight is below the cutoff are dropped before the weights are expanded
+    // in terms of raw data: this ignores their currents, while the voltage
+    // coefficients of each row still sum to zero.
+    fvm_probe_extracellular_potential r;
+    r.transfer_divs.push_back(0);
+    std::vector<double> G(n_cv), M(n_raw);
+    for (auto e: util::count_along(p.electrodes)) {
+        const double* Te = T.data()+e*n_cable;
+        std::fill(M.begin(), M.end(), 0.);
+
+        double G_max = 0;
+        for (auto cv: util::make_span(n_cv)) {
+            G[cv] = 0;
+            for (auto c: util::make_span(cables_by_cv[cv])) G[cv] += Te[c]*I.weight[c];
+            G_max = std::max(G_max, std::abs(G[cv]));
+        }
+        for (auto& g: G) {
+            if (std::abs(g)<p.cutoff*G_max) g = 0;
+        }
+        for (auto cv: util::make_span(n_cv)) {
+            auto parent_cv = I.cv_parent[cv];
+            if (parent_cv+1==0) continue;
+            double m = I.cv_parent_cond[cv]*(G[parent_cv]-G[cv]);
+            M[cv] += m;
+            M[parent_cv] -= m;
+        }
+        for (auto i: util::count_along(I.stim_cv)) {
+            M[n_cv+i] = -I.stim_scale[i]*G[I.stim_cv[i]];
+        }
+
+        for (auto i: util::make_span(n_raw)) {
+            if (M[i]!=0) {
+                r.transfer_index.push_back(i);
+                r.transfer.push_back(M[i]);
+            }
+        }
+        r.transfer_divs.push_back(r.transfer.size());
+    }
+
+    r.raw_handles = std::move(I.raw_handles);
+    r.metadata = p.electrodes;
     r.shrink_to_fit();
     R.result.push_back(std::move(r));
 }
@@ -1062,4 +1141,122 @@ void resolve_probe(const cable_probe_ion_diff_concentration_cell& p, probe_resol
     resolve_ion_conc_common<B>(R.M.ions.at(p.ion).cv, R.state->ion_data.at(p.ion).Xd_.data(), R);
 }
 
+// Reduction probes: resolved into terms of a back-end reduction, whose
+// results are the raw values of the probe.
+
+template <typename B>
+void add_reduction(fvm_probe_reduction& r,
+                   const std::vector<probe_handle>& handles,
+                   const std::vector<arb_value_type>& weights,
+                   probe_resolution_data<B>& R) {
+    auto out = R.state->add_reduction(handles, weights, r.metadata.edges);
+    auto width = r.metadata.edges.empty()? 1: r.metadata.edges.size()-1;
+    for (auto k: util::make_span(width)) r.raw_handles.push_back(out+k);
+    r.shrink_to_fit();
+    R.result.push_back(std::move(r));
+}
+
+// Membrane area [µm²] of each CV of the cell within an extent, for CVs
+// where it is non-zero; the contributing cables are appended to `cables`.
+template <typename B>
+std::vector<std::pair<arb_index_type, double>> cv_area_within(const mextent& ext,
+                                                              probe_resolution_data<B>& R,
+                                                              mcable_list& cables) {
+    std::vector<std::pair<arb_index_type, double>> result;
+    for (auto cv: R.D.geometry.cell_cvs(R.cell_idx)) {
+        auto cv_cables = R.D.geometry.cables(cv);
+        double area = 0;
+        for (auto cable: intersect(mextent(mcable_list(cv_cables.begin(), cv_cables.end())), ext)) {
+            if (cable.prox_pos==cable.dist_pos) continue;
+            area += R.cell.embedding().integrate_area(cable);
+            cables.push_back(cable);
+        }
+        if (area>0) result.emplace_back(cv, area);
+    }
+    return result;
+}
+
+template <typename B>
+void resolve_voltage_distribution(const region& reg, std::vector<double> edges, probe_resolution_data<B>& R) {
+    fvm_probe_reduction r;
+    r.metadata.edges = std::move(edges);
+    auto cv_area = cv_area_within(thingify(reg, R.cell.provider()), R, r.metadata.cables);
+    if (cv_area.empty()) return;
+
+    double total = util::sum_by(cv_area, [](const auto& x) { return x.second; });
+    std::vector<probe_handle> handles;
+    std::vector<arb_value_type> weights;
+    for (auto [cv, area]: cv_area) {
+        handles.push_back(R.state->voltage.data()+cv);
+        weights.push_back(area/total);
+    }
+    add_reduction(r, handles, weights, R);
+}
+
+template <typename B>
+void resolve_probe(const cable_probe_membrane_voltage_mean& p, probe_resolution_data<B>& R) {
+    resolve_voltage_distribution(p.reg, {}, R);
+}
+
+template <typename B>
+void resolve_probe(const cable_probe_membrane_voltage_histogram& p, probe_resolution_data<B>& R) {
+    if (p.edges.size()<2) throw cable_cell_error("voltage histogram requires at least two bin edges");
+    resolve_voltage_distribution(p.reg, p.edges, R);
+}
+
+template <typename B>
+void resolve_probe(const cable_probe_total_ion_current_sum& p, probe_resolution_data<B>& R) {
+    fvm_probe_reduction r;
+    auto cv_area = cv_area_within(thingify(p.reg, R.cell.provider()), R, r.metadata.cables);
+    if (cv_area.empty()) return;
+
+    // As for cable_probe_total_ion_current_cell: accumulated current density
+    // less stimulus, scaled from [µm²·A/m²] to [nA].
+    std::vector<probe_handle> handles;
+    std::vector<arb_value_type> weights;
+    for (auto [cv, area]: cv_area) {
+        handles.push_back(R.state->current_density.data()+cv);
+        weights.push_back(0.001*area);
+        if (auto opt_i = util::binary_search_index(R.M.stimuli.cv_unique, cv)) {
+            handles.push_back(R.state->stim_data.accu_stim_.data()+*opt_i);
+            weights.push_back(-0.001*area);
+        }
+    }
+    add_reduction(r, handles, weights, R);
+}
+
+template <typename B>
+void resolve_probe(const cable_probe_point_state_sum& p, probe_resolution_data<B>& R) {
+    const auto& data = R.mechanism_state(p.mechanism, p.state);
+    if (!data) return;
+    if (!R.mech_instance_by_name.count(p.mechanism)) return;
+    auto mech_id = R.mech_instance_by_name.at(p.mechanism)->mechanism_id();
+    const auto& multiplicity = R.M.mechanisms.at(p.mechanism).multiplicity;
+
+    const auto& synapses = R.cell.synapses();
+    if (!synapses.count(p.mechanism)) return;
+    const auto& placed_instances = synapses.at(p.mechanism);
+
+    auto cell_targets_beg = R.M.target_divs.at(R.cell_idx);
+    auto cell_targets_end = R.M.target_divs.at(R.cell_idx + 1);
+
+    // Coalesced instances share state: count each once.
+    fvm_probe_reduction r;
+    std::vector<probe_handle> handles;
+    std::unordered_set<arb_index_type> seen;
+    for (auto target: util::make_span(cell_targets_beg, cell_targets_end)) {
+        const auto& handle = R.handles.at(target);
+        if (handle.mech_id != mech_id) continue;
+
+        auto mech_index = handle.mech_index;
+        if (!seen.insert(mech_index).second) continue;
+        handles.push_back(data + mech_index);
+        r.metadata.points.push_back(point_info_of(target - cell_targets_beg,
+                                                  mech_index,
+                                                  placed_instances,
+                                                  multiplicity));
+    }
+    add_reduction(r, handles, std::vector<arb_value_type>(handles.size(), 1.), R);
+}
+
 } // namespace arb
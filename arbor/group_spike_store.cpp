@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <vector>
+
+#include <arbor/common_types.hpp>
+#include <arbor/spike.hpp>
+
+#include "threading/threading.hpp"
+#include "group_spike_store.hpp"
+
+namespace arb {
+
+group_spike_store::group_spike_store(std::size_t num_groups, const task_system_handle& ts):
+    buffers_(num_groups), task_system_(ts)
+{}
+
+void group_spike_store::set(std::size_t i, const std::vector<spike>& spikes) {
+    auto& buffer = buffers_.at(i);
+    buffer.assign(spikes.begin(), spikes.end());
+    // Groups typically emit spikes in order already.
+    if (!std::is_sorted(buffer.begin(), buffer.end())) {
+        std::sort(buffer.begin(), buffer.end());
+    }
+}
+
+std::vector<spike> group_spike_store::gather() const {
+    // Lay out the buffers back to back in group order, ...
+    std::vector<std::size_t> part = {0};
+    for (const auto& b: buffers_) part.push_back(part.back() + b.size());
+
+    std::vector<spike> spikes(part.back());
+    if (spikes.empty()) return spikes;
+    threading::parallel_for::apply(0, buffers_.size(), task_system_.get(),
+        [&](int i) { std::copy(buffers_[i].begin(), buffers_[i].end(), spikes.begin() + part[i]); });
+
+    // ... then merge adjacent sorted runs pairwise, halving the number of
+    // runs on each pass.
+    std::vector<spike> scratch(spikes.size());
+    while (part.size()>2) {
+        auto n_run = part.size()-1;
+        threading::parallel_for::apply(0, (n_run+1)/2, task_system_.get(),
+            [&](std::size_t k) {
+                auto lo = part[2*k], mid = part[std::min(2*k+1, n_run)], hi = part[std::min(2*k+2, n_run)];
+                std::merge(spikes.begin()+lo,  spikes.begin()+mid,
+                           spikes.begin()+mid, spikes.begin()+hi,
+                           scratch.begin()+lo);
+            });
+        std::swap(spikes, scratch);
+
+        std::vector<std::size_t> merged;
+        for (std::size_t j = 0; j<part.size(); j += 2) merged.push_back(part[j]);
+        if (merged.back()!=part.back()) merged.push_back(part.back());
+        part = std::move(merged);
+    }
+    return spikes;
+}
+
+void group_spike_store::clear() {
+    for (auto& b: buffers_) b.clear();
+}
+
+} // namespace arb
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include <arbor/export.hpp>
+#include <arbor/common_types.hpp>
+#include <arbor/spike.hpp>
+
+#include "threading/threading.hpp"
+
+namespace arb {
+
+/// Per cell group buffers of spikes, each kept sorted by (source, time).
+///
+/// Every cell group owns exactly one buffer, so groups advanced in parallel
+/// can publish their spikes without synchronisation. As the gids of distinct
+/// groups are disjoint, merging the sorted buffers yields a single ordering
+/// that depends only on the spikes, not on the number of threads or the
+/// order in which the groups finished.
+class ARB_ARBOR_API group_spike_store {
+public:
+    group_spike_store() = default;
+    group_spike_store(std::size_t num_groups, const task_system_handle& ts);
+
+    std::size_t num_groups() const { return buffers_.size(); }
+
+    /// Replace the spikes of group i, sorting them if needed.
+    /// Concurrent calls must use distinct group indices.
+    void set(std::size_t i, const std::vector<spike>& spikes);
+
+    /// Merge all buffers into a single vector sorted by (source, time).
+    /// Buffers are merged pairwise in parallel. Does not modify the buffer
+    /// contents.
+    std::vector<spike> gather() const;
+
+    /// Clear all buffers.
+    void clear();
+
+private:
+    std::vector<std::vector<spike>> buffers_;
+    task_system_handle task_system_;
+};
+
+} // namespace arb
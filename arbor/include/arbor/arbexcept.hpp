@@ -60,6 +60,11 @@ struct ARB_SYMBOL_VISIBLE bad_cell_description: arbor_exception {
     cell_kind kind;
 };
 
+struct ARB_SYMBOL_VISIBLE bad_cell_description_count: arbor_exception {
+    bad_cell_description_count(std::size_t num_cells, std::size_t num_descriptions);
+    std::size_t num_cells, num_descriptions;
+};
+
 struct ARB_SYMBOL_VISIBLE bad_connection_source_gid: arbor_exception {
     bad_connection_source_gid(cell_gid_type gid, cell_gid_type src_gid, cell_size_type num_cells);
     cell_gid_type gid, src_gid;
@@ -72,12 +77,22 @@ struct ARB_SYMBOL_VISIBLE source_gid_exceeds_limit: arbor_exception {
 };
 
 
+struct ARB_SYMBOL_VISIBLE bad_connection_target_gid: arbor_exception {
+    bad_connection_target_gid(cell_gid_type gid);
+    cell_gid_type gid;
+};
+
 struct ARB_SYMBOL_VISIBLE bad_connection_label: arbor_exception {
     bad_connection_label(cell_gid_type gid, const cell_tag_type& label, const std::string& msg);
     cell_gid_type gid;
     cell_tag_type label;
 };
 
+struct ARB_SYMBOL_VISIBLE bad_connection_columns: arbor_exception {
+    bad_connection_columns(cell_gid_type gid_begin, cell_gid_type gid_end, const std::string& msg);
+    cell_gid_type gid_begin, gid_end;
+};
+
 struct ARB_SYMBOL_VISIBLE bad_global_property: arbor_exception {
     explicit bad_global_property(cell_kind kind);
     cell_kind kind;
@@ -202,6 +217,12 @@ struct ARB_SYMBOL_VISIBLE bad_catalogue_error: arbor_exception {
     std::any platform_error;
 };
 
+struct ARB_SYMBOL_VISIBLE catalogue_compile_error: arbor_exception {
+    catalogue_compile_error(const std::string& command, const std::string& log);
+    std::string command;
+    std::string log;
+};
+
 // ABI errors
 
 struct ARB_SYMBOL_VISIBLE bad_alignment: arbor_exception {
@@ -24,13 +24,23 @@ struct ARB_SYMBOL_VISIBLE benchmark_cell {
     // If equal to 1, then a single cell can be advanced in realtime 
     double realtime_ratio;
 
+    // If true, the cost is emulated by spinning, tying up a CPU core for
+    // the duration. Otherwise the cost is only accounted for in
+    // benchmark_modelled_time() and the cell advances at once, which lets
+    // load-balance studies model expensive cells without burning CPU.
+    bool busy_wait = true;
+
     benchmark_cell() = default;
-    benchmark_cell(cell_tag_type source, cell_tag_type target, schedule seq, double ratio):
-        source(source), target(target), time_sequence(seq), realtime_ratio(ratio) {};
+    benchmark_cell(cell_tag_type source, cell_tag_type target, schedule seq, double ratio, bool busy_wait = true):
+        source(source), target(target), time_sequence(seq), realtime_ratio(ratio), busy_wait(busy_wait) {};
 
-    ARB_SERDES_ENABLE(benchmark_cell, source, target, time_sequence, realtime_ratio);
+    ARB_SERDES_ENABLE(benchmark_cell, source, target, time_sequence, realtime_ratio, busy_wait);
 };
 
+// Modelled cost in seconds of all benchmark cells with busy_wait unset that
+// were advanced by this process. The count is never reset; take differences.
+ARB_ARBOR_API double benchmark_modelled_time();
+
 } // namespace arb
 
 
@@ -57,6 +57,13 @@ struct ARB_SYMBOL_VISIBLE cable_probe_point_info {
     mlocation loc;          // Point on cell morphology where instance is placed.
 };
 
+// Metadata for reduction probes.
+struct ARB_SYMBOL_VISIBLE cable_probe_reduction_info {
+    mcable_list cables;                         // Membrane contributing to the reduction, if any.
+    std::vector<cable_probe_point_info> points; // Point process instances contributing, if any.
+    std::vector<double> edges;                  // Histogram bin edges; empty for scalar reductions.
+};
+
 // Voltage estimate [mV] at `location`, interpolated.
 // Sample value type: `double`
 // Sample metadata type: `mlocation`
@@ -98,6 +105,20 @@ struct ARB_SYMBOL_VISIBLE cable_probe_total_current_cell {};
 // Sample metadata type: `mcable_list`
 struct ARB_SYMBOL_VISIBLE cable_probe_stimulus_current_cell {};
 
+// Extracellular potential [mV] at electrode positions [µm], given in the
+// coordinates of the cell morphology, generated by the total membrane current
+// of the cell in an infinite homogeneous medium of conductivity sigma [S/m].
+// Each CV is modelled as a set of line sources; electrode radii are ignored.
+// The currents of CVs whose transfer to an electrode is below `cutoff` times
+// the largest transfer to that electrode are ignored; zero keeps all CVs.
+// Sample value type: `cable_sample_range`
+// Sample metadata type: `std::vector<mpoint>`
+struct ARB_SYMBOL_VISIBLE cable_probe_extracellular_potential {
+    std::vector<mpoint> electrodes;
+    double sigma = 0.3;
+    double cutoff = 0;
+};
+
 // Value of state variable `state` in density mechanism `mechanism` in CV at `location`.
 // Sample value type: `double`
 // Sample metadata type: `mlocation`
@@ -193,6 +214,44 @@ struct ARB_SYMBOL_VISIBLE cable_probe_ion_ext_concentration_cell {
     std::string ion;
 };
 
+// Reductions are evaluated by the back-end when sampled: the sampler receives
+// the reduced value only, however many CVs or instances contribute to it.
+// Each reduction covers the cell it is placed on. Only the multicore back-end
+// implements them.
+
+// Membrane voltage [mV] averaged over the membrane area of `reg`.
+// Sample value type: `double`
+// Sample metadata type: `cable_probe_reduction_info`
+struct ARB_SYMBOL_VISIBLE cable_probe_membrane_voltage_mean {
+    region reg;
+};
+
+// Total ionic current [nA] across the membrane of `reg`, excluding capacitive
+// and stimulus currents.
+// Sample value type: `double`
+// Sample metadata type: `cable_probe_reduction_info`
+struct ARB_SYMBOL_VISIBLE cable_probe_total_ion_current_sum {
+    region reg;
+};
+
+// Value of state variable `state` in point mechanism `mechanism` summed over
+// every target with this mechanism, e.g. the total synaptic current.
+// Sample value type: `double`
+// Sample metadata type: `cable_probe_reduction_info`
+struct ARB_SYMBOL_VISIBLE cable_probe_point_state_sum {
+    std::string mechanism;
+    std::string state;
+};
+
+// Fraction of the membrane area of `reg` with membrane voltage in each bin
+// [edges[i], edges[i+1]) [mV]; edges must be increasing.
+// Sample value type: `cable_sample_range`, one value per bin
+// Sample metadata type: `cable_probe_reduction_info`
+struct ARB_SYMBOL_VISIBLE cable_probe_membrane_voltage_histogram {
+    region reg;
+    std::vector<double> edges;
+};
+
 // Forward declare the implementation, for PIMPL.
 struct cable_cell_impl;
 
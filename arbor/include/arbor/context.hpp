@@ -1,22 +1,65 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <vector>
 
+#include <arbor/common_types.hpp>
 #include <arbor/export.hpp>
+#include <arbor/spike.hpp>
 
 namespace arb {
 
 constexpr static int gpu_nil_id = -1;
 
 // Requested dry-run parameters.
+//
+// Only the cells of rank 0 are simulated. By default, the other ranks replay
+// the local spikes with their gids shifted by a multiple of
+// num_cells_per_rank. Instead, the spikes of the other ranks can be drawn
+// from Poisson processes with a given rate per cell, or replayed from a
+// recorded trace.
 struct dry_run_info {
     unsigned num_ranks;
     unsigned num_cells_per_rank;
+
+    // Firing rate [Hz] of each cell, by gid.
+    std::function<double(cell_gid_type)> rate;
+
+    // Recorded spikes. Rank r replays the spikes of the gids in
+    // [k*num_cells_per_rank, (k+1)*num_cells_per_rank), where k is r modulo
+    // the number of such ranges covered by the trace.
+    std::vector<spike> trace;
+
+    // Seed for the random number generator used with rate.
+    std::uint64_t seed = 0;
+
+    // Network model for the projected spike exchange time: an all-gather
+    // costs latency [s] per round of ceil(log2(num_ranks)) rounds, plus the
+    // gathered volume over bandwidth [byte/s].
+    double latency = 2e-6;
+    double bandwidth = 1e10;
+
     dry_run_info(unsigned ranks, unsigned cells_per_rank):
             num_ranks(ranks),
             num_cells_per_rank(cells_per_rank) {}
 };
 
+// Statistics of a dry run, accumulated over all spike exchanges.
+struct dry_run_report {
+    unsigned num_ranks = 0;
+    std::size_t num_exchanges = 0;
+    // Total number of spikes gathered.
+    std::size_t num_spikes = 0;
+    // Largest number of spikes contributed by one rank to an exchange.
+    std::size_t max_rank_spikes = 0;
+    // Projected spike exchange time [s], in total and of the slowest exchange.
+    double exchange_time = 0;
+    double max_exchange_time = 0;
+};
+
 // A description of local computation resources to use in a computation.
 // By default, a proc_allocation will comprise one thread and no GPU.
 
@@ -33,6 +76,10 @@ struct proc_allocation {
     bool bind_procs = false;
     bool bind_threads = false;
 
+    // If positive, spikes are exchanged between MPI ranks in a packed
+    // encoding, with spike times rounded to this resolution [ms].
+    double spike_time_resolution = 0;
+
     proc_allocation() = default;
 
     proc_allocation(unsigned long threads, int gpu, bool bind_proc=false, bool bind_thread=false):
@@ -75,6 +122,12 @@ ARB_ARBOR_API context make_context(const proc_allocation& resources, Comm comm);
 template <typename Comm>
 ARB_ARBOR_API context make_context(const proc_allocation& resources, Comm comm, Comm remote);
 
+// Contexts for num_ranks ranks within this process, which exchange spikes
+// through shared memory instead of MPI. Each rank gets its own thread pool
+// described by resources, and each context must be used from its own thread,
+// as collective operations block until all ranks take part.
+ARB_ARBOR_API std::vector<context> make_thread_contexts(const proc_allocation& resources, unsigned num_ranks);
+
 // Queries for properties of execution resources in a context.
 
 ARB_ARBOR_API std::string distribution_type(context);
@@ -84,4 +137,8 @@ ARB_ARBOR_API bool has_mpi(context);
 ARB_ARBOR_API unsigned num_ranks(context);
 ARB_ARBOR_API unsigned rank(context);
 
+// Spike exchange statistics of a dry-run context; throws arb::arbor_exception
+// for other contexts.
+ARB_ARBOR_API dry_run_report dry_run_statistics(context);
+
 }
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <optional>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 #include <arbor/assert.hpp>
 #include <arbor/common_types.hpp>
@@ -54,14 +56,32 @@ using resolution_function = std::function<cell_lid_type(const cell_local_label_t
 
 // Generate events with a fixed target and weight according to
 // a provided time schedule.
+//
+// A generator may also deliver each event of its schedule to several
+// targets, each with its own weight. This is equivalent to one generator per
+// target sharing the schedule, but the schedule is queried once, and the
+// events form a single sorted stream that is merged into the event lane of
+// the cell as one.
 
 struct event_generator {
+    using target_weight = std::pair<cell_local_label_type, float>;
+
     event_generator(cell_local_label_type target, float weight, schedule sched):
-        target_(std::move(target)), weight_(weight), sched_(std::move(sched))
+        targets_{{std::move(target), weight}}, sched_(std::move(sched))
+    {}
+
+    event_generator(std::vector<target_weight> targets, schedule sched):
+        targets_(std::move(targets)), sched_(std::move(sched))
     {}
 
     void resolve_label(resolution_function label_resolver) {
-        resolved_ = label_resolver(target_);
+        resolved_.clear();
+        for (const auto& [target, weight]: targets_) {
+            resolved_.emplace_back(label_resolver(target), weight);
+        }
+        // Events at the same time are ordered by target, then weight.
+        std::sort(resolved_.begin(), resolved_.end());
+        is_resolved_ = true;
     }
 
     void reset() {
@@ -69,15 +89,16 @@ struct event_generator {
     }
 
     event_seq events(time_type t0, time_type t1) {
-        if (!resolved_) throw arbor_internal_error("Unresolved label in event generator.");
-        auto tgt = *resolved_;
+        if (!is_resolved_) throw arbor_internal_error("Unresolved label in event generator.");
         auto ts = sched_.events(t0, t1);
 
         events_.clear();
-        events_.reserve(ts.second-ts.first);
+        events_.reserve((ts.second-ts.first)*resolved_.size());
 
         for (auto i = ts.first; i!=ts.second; ++i) {
-            events_.push_back(spike_event{tgt, *i, weight_});
+            for (const auto& [tgt, weight]: resolved_) {
+                events_.push_back(spike_event{tgt, *i, weight});
+            }
         }
 
         return {events_.data(), events_.data()+events_.size()};
@@ -85,10 +106,9 @@ struct event_generator {
 
 private:
     pse_vector events_;
-    cell_local_label_type target_;
-    resolution_function label_resolver_;
-    std::optional<cell_lid_type> resolved_;
-    float weight_;
+    std::vector<target_weight> targets_;
+    std::vector<std::pair<cell_lid_type, float>> resolved_;
+    bool is_resolved_ = false;
     schedule sched_;
 };
 
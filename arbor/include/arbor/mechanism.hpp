@@ -32,8 +32,7 @@ public:
     using size_type  = arb_size_type;
 
     mechanism(const arb_mechanism_type& m,
-              const arb_mechanism_interface& i): mech_{m}, iface_{i}, ppack_{} {
-        if (mech_.abi_version != ARB_MECH_ABI_VERSION) throw unsupported_abi_error{mech_.abi_version};
+              const arb_mechanism_interface& i): mech_{m}, iface_{checked_interface(m, i)}, ppack_{} {
         state_prof_id   = profile::profiler_region_id("advance:integrate:state:"+internal_name());
         current_prof_id = profile::profiler_region_id("advance:integrate:current:"+internal_name());
         deliver_prof_id = profile::profiler_region_id("advance:integrate:event:"+internal_name());
@@ -100,17 +99,19 @@ public:
     arb_mechanism_ppack ppack_;
 
 private:
-#ifdef ARB_PROFILE_ENABLED
+    // Check the ABI version before copying the interface: catalogues built
+    // against an older ABI provide a smaller interface struct.
+    static const arb_mechanism_interface& checked_interface(const arb_mechanism_type& m, const arb_mechanism_interface& i) {
+        if (m.abi_version != ARB_MECH_ABI_VERSION) throw unsupported_abi_error{m.abi_version};
+        return i;
+    }
+
     void prof_enter(profile::region_id_type id) {
-        profile::profiler_enter(id);
+        if (profile::profiler_enabled()) profile::profiler_enter(id);
     }
     void prof_exit() {
-        profile::profiler_leave();
+        if (profile::profiler_enabled()) profile::profiler_leave();
     }
-#else
-    void prof_enter(profile::region_id_type) {}
-    void prof_exit() {}
-#endif
     profile::region_id_type state_prof_id;
     profile::region_id_type current_prof_id;
     profile::region_id_type deliver_prof_id;
@@ -20,9 +20,9 @@ extern "C" {
 
 // Version
 #define ARB_MECH_ABI_VERSION_MAJOR 0
-#define ARB_MECH_ABI_VERSION_MINOR 6
+#define ARB_MECH_ABI_VERSION_MINOR 7
 #define ARB_MECH_ABI_VERSION_PATCH 0
-#define ARB_MECH_ABI_VERSION ((ARB_MECH_ABI_VERSION_MAJOR * 10000L * 10000L) + (ARB_MECH_ABI_VERSION_MAJOR * 10000L) + ARB_MECH_ABI_VERSION_PATCH)
+#define ARB_MECH_ABI_VERSION ((ARB_MECH_ABI_VERSION_MAJOR * 10000L * 10000L) + (ARB_MECH_ABI_VERSION_MINOR * 10000L) + ARB_MECH_ABI_VERSION_PATCH)
 
 typedef const char* arb_mechanism_fingerprint;
 
@@ -116,6 +116,7 @@ typedef struct arb_mechanism_ppack {
     arb_ion_state*   ion_states;                    // Array of views into shared state.
 
     arb_value_type const * const * random_numbers;  // Array of random numbers
+    arb_value_type*  tables;                        // Storage for tables sampled by init_mechanism.
 } arb_mechanism_ppack;
 
 
@@ -140,6 +141,7 @@ typedef struct arb_mechanism_interface {
      *   - will receive an allocated and initialised ppack object
      *     - pointers in ion_state_view are set to their associated values in shared state
      *     - pointers to state, parameters, globals, and constants are allocated and initialised to the given defaults.
+     *     - `tables` holds `n_table_values` uninitialised values, to be filled here from globals.
      *     - SIMD only: index_constraint is set up
      *     - Internal values (see above) are initialised
      */
@@ -178,6 +180,15 @@ typedef struct arb_mechanism_interface {
      * - corresponds to NET_RECEIVE in NMODL
      */
     arb_mechanism_method post_event;
+    /* 7. compute_currents_uniform, advance_state_uniform
+     * - optional, may be null
+     * - replace compute_currents and advance_state if every parameter takes
+     *   the same value for all instances, i.e. `ppack::parameters[i][j]` is
+     *   independent of j; such kernels may read `ppack::parameters[i][0]` once
+     * - only used if width > 0
+     */
+    arb_mechanism_method compute_currents_uniform;
+    arb_mechanism_method advance_state_uniform;
 } arb_mechanism_interface;
 
 typedef struct arb_field_info {
@@ -226,6 +237,8 @@ typedef struct arb_mechanism_type {
     arb_size_type             n_ions;
     arb_random_variable_info* random_variables; // Random variable properties
     arb_size_type             n_random_variables;
+    // Storage for tables sampled by init_mechanism
+    arb_size_type             n_table_values;   // Size of ppack::tables
 } arb_mechanism_type;
 
 // Bundle a type and its interfaces
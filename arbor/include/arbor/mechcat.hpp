@@ -118,4 +118,29 @@ ARB_ARBOR_API const mechanism_catalogue& global_stochastic_catalogue();
 // Load catalogue from disk.
 ARB_ARBOR_API const mechanism_catalogue load_catalogue(const std::filesystem::path&);
 
+// Compile a catalogue from NMODL sources at runtime.
+//
+// The sources are translated by modcc and built into a shared object by the
+// host C++ compiler, by default for the SIMD instruction set of the host.
+// Shared objects are cached under a hash of the sources, tools and flags, such
+// that repeated calls only load the catalogue. Only the CPU back-end is built.
+struct compile_catalogue_options {
+    // modcc and C++ compiler; empty selects those arbor was installed with.
+    std::filesystem::path modcc;
+    std::filesystem::path cxx;
+
+    std::vector<std::string> modcc_flags = {"--simd"};
+    std::vector<std::string> cxx_flags = {"-O3", "-march=native"};
+
+    // Location of arbor's headers; empty selects the installed headers.
+    std::vector<std::filesystem::path> include_dirs;
+
+    // Cache of compiled catalogues; empty selects $XDG_CACHE_HOME/arbor,
+    // $HOME/.cache/arbor, or the system's temporary directory in that order.
+    std::filesystem::path cache_dir;
+};
+
+ARB_ARBOR_API const mechanism_catalogue compile_catalogue(const std::vector<std::string>& nmodl,
+                                                          const compile_catalogue_options& = {});
+
 } // namespace arb
@@ -36,6 +36,11 @@ public:
     msize_t append(msize_t p, const mpoint& prox, const mpoint& dist, int tag);
     msize_t append(msize_t p, const mpoint& dist, int tag);
 
+    // Append n segments given column by column, as if appended one by one.
+    // Parents may refer to segments appended earlier in the same call. If a
+    // parent is invalid, nothing is appended.
+    msize_t append(msize_t n, const msize_t* parents, const mpoint* prox, const mpoint* dist, const int* tags);
+
     // The number of segments in the tree.
     msize_t size() const;
     bool empty() const;
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <ostream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -32,11 +34,48 @@ struct profile {
 
     // the wall time between profile_start() and profile_stop().
     double wall_time;
+
+    // the names of the hardware counters; empty if none were recorded.
+    std::vector<std::string> counter_names;
+
+    // the accumulated value of each hardware counter in each region,
+    // indexed as counters[region][counter].
+    std::vector<std::vector<std::uint64_t>> counters;
+};
+
+// Optional recording in addition to call counts and times, chosen when
+// the profiler is initialized. Disabled recording costs one branch per region.
+struct profiler_options {
+    // Count CPU cycles, instructions and last level cache misses per region
+    // through perf_event_open. Only available on Linux, and subject to the
+    // kernel.perf_event_paranoid setting; otherwise no counters are reported.
+    bool counters = false;
+
+    // Record the start and end of every region on every thread.
+    // See write_profiler_trace.
+    bool trace = false;
+
+    // Maximum number of trace records kept per thread. Once reached, the
+    // oldest records are overwritten.
+    std::size_t trace_capacity = 1 << 18;
 };
 
+// Set once the profiler is initialized; regions are ignored until then.
+ARB_ARBOR_API extern std::atomic<bool> profiler_enabled_flag;
+
+inline bool profiler_enabled() {
+    return profiler_enabled_flag.load(std::memory_order_relaxed);
+}
+
 // TODO: remove declaration and update the docs
 void profiler_clear();
-ARB_ARBOR_API void profiler_initialize(context ctx);
+// Start recording the regions entered on the threads of ctx. Regions entered
+// on other threads are ignored. Clears the results of earlier recordings.
+// Regions entered before the recording starts are not recorded.
+ARB_ARBOR_API void profiler_initialize(context ctx, const profiler_options& options = {});
+// Stop recording; the results are kept. Regions left after the recording
+// stopped are not recorded.
+ARB_ARBOR_API void profiler_finalize();
 ARB_ARBOR_API void profiler_enter(std::size_t region_id);
 ARB_ARBOR_API void profiler_leave();
 
@@ -45,6 +84,10 @@ ARB_ARBOR_API profile profiler_summary();
 ARB_ARBOR_API std::ostream& print_profiler_summary(std::ostream&, double limit=0.0);
 ARB_ARBOR_API std::size_t profiler_region_id(const std::string& name);
 
+// Write the recorded trace in the Chrome trace event format, which can be
+// viewed with Perfetto (ui.perfetto.dev) or chrome://tracing.
+ARB_ARBOR_API std::ostream& write_profiler_trace(std::ostream&);
+
 ARB_ARBOR_API std::ostream& operator<<(std::ostream&, const profile&);
 
 } // namespace profile
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <any>
+#include <cstdint>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -66,6 +67,79 @@ struct cell_connection_base {
 using cell_connection     = cell_connection_base<cell_global_label_type>;
 using ext_cell_connection = cell_connection_base<cell_remote_label_type>;
 
+// Incremental change to the connections terminating on the cells local to a
+// rank, see `simulation::update_connections`.
+struct connection_delta {
+    struct addition {
+        cell_gid_type target_gid;
+        cell_connection connection;
+    };
+
+    // Removes all connections on cell `target_gid` from any lid of the
+    // `source` label to any lid of the `target` label.
+    struct removal {
+        cell_gid_type target_gid;
+        cell_global_label_type source;
+        cell_local_label_type target;
+    };
+
+    std::vector<addition> added;
+    std::vector<removal> removed;
+
+    void add(cell_gid_type target_gid, cell_connection conn) {
+        added.push_back({target_gid, std::move(conn)});
+    }
+
+    void remove(cell_gid_type target_gid, cell_global_label_type source, cell_local_label_type target) {
+        removed.push_back({target_gid, std::move(source), std::move(target)});
+    }
+};
+
+// Connections on a contiguous range of cells [gid_begin, gid_end) in columnar
+// form, see `has_synapses::connections_on_range`. Labels are indices into the
+// recipe's `connection_label_table`. The connections of cell `gid_begin + i`
+// are those in [offsets[i], offsets[i+1]).
+struct connection_columns {
+    std::vector<std::size_t> offsets = {0};
+    std::vector<cell_gid_type> source_gid;
+    std::vector<cell_size_type> source_label;
+    std::vector<lid_selection_policy> source_policy;
+    std::vector<cell_size_type> target_label;
+    std::vector<lid_selection_policy> target_policy;
+    std::vector<float> weight; // [()]
+    std::vector<float> delay;  // [ms]
+
+    std::size_t size() const { return source_gid.size(); }
+
+    void add(cell_gid_type src_gid, cell_size_type src_label, cell_size_type tgt_label, float w, float d,
+             lid_selection_policy src_policy = lid_selection_policy::assert_univalent,
+             lid_selection_policy tgt_policy = lid_selection_policy::assert_univalent) {
+        source_gid.push_back(src_gid);
+        source_label.push_back(src_label);
+        source_policy.push_back(src_policy);
+        target_label.push_back(tgt_label);
+        target_policy.push_back(tgt_policy);
+        weight.push_back(w);
+        delay.push_back(d);
+    }
+
+    // Close the connections of the current cell and start the next one.
+    void next_cell() { offsets.push_back(size()); }
+
+    // Append the connections of the cells following the current ones.
+    void append(const connection_columns& other) {
+        const auto base = size();
+        for (std::size_t i = 1; i < other.offsets.size(); ++i) offsets.push_back(base + other.offsets[i]);
+        source_gid.insert(source_gid.end(), other.source_gid.begin(), other.source_gid.end());
+        source_label.insert(source_label.end(), other.source_label.begin(), other.source_label.end());
+        source_policy.insert(source_policy.end(), other.source_policy.begin(), other.source_policy.end());
+        target_label.insert(target_label.end(), other.target_label.begin(), other.target_label.end());
+        target_policy.insert(target_policy.end(), other.target_policy.begin(), other.target_policy.end());
+        weight.insert(weight.end(), other.weight.begin(), other.weight.end());
+        delay.insert(delay.end(), other.delay.begin(), other.delay.end());
+    }
+};
+
 struct gap_junction_connection {
     cell_global_label_type peer;
     cell_local_label_type local;
@@ -92,6 +166,23 @@ struct ARB_ARBOR_API has_synapses {
     virtual std::optional<arb::network_description> network_description() const {
         return std::nullopt;
     };
+    // Optional bulk interface: if the label table is not empty, connections
+    // are queried by `connections_on_range` for runs of consecutive gids
+    // instead of by `connections_on`. The table is queried once per update of
+    // the connections, such that each label is hashed only once.
+    virtual std::vector<cell_tag_type> connection_label_table() const {
+        return {};
+    }
+    virtual connection_columns connections_on_range(cell_gid_type gid_begin, cell_gid_type gid_end) const {
+        return {};
+    }
+    // Optional fingerprint of all connections, including generated and external
+    // ones. If given, the connection table may be cached across simulations and
+    // is reused while the fingerprint is unchanged, so it must change whenever
+    // the connectivity does.
+    virtual std::optional<std::uint64_t> connectivity_fingerprint() const {
+        return std::nullopt;
+    }
     virtual ~has_synapses() {}
 };
 
@@ -129,6 +220,9 @@ struct ARB_ARBOR_API recipe: public has_gap_junctions, has_probes, connectivity
     virtual cell_size_type num_cells() const = 0;
     // Cell description type will be specific to cell kind of cell with given gid.
     virtual util::unique_any get_cell_description(cell_gid_type gid) const = 0;
+    // Optional batched query of the descriptions of the cells of one group, in the
+    // order of `gids`. If empty, descriptions are queried per gid as above.
+    virtual std::vector<util::unique_any> get_cell_descriptions(const std::vector<cell_gid_type>& gids) const { return {}; }
     // Query cell kind per gid
     virtual cell_kind get_cell_kind(cell_gid_type) const = 0;
     // Global property type will be specific to given cell kind.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <vector>
 #include <functional>
@@ -29,8 +30,13 @@ class simulation_builder;
 
 class ARB_ARBOR_API simulation {
 public:
+    // If `connection_cache` is given, the connection table is loaded from files
+    // at this path written by an earlier simulation with the same connectivity and
+    // domain decomposition. Otherwise, the table is built and written there.
+    // Connectivity is identified by recipe::connectivity_fingerprint; without
+    // one, the cache is not used.
     simulation(const recipe& rec, context ctx, const domain_decomposition& decomp,
-               arb_seed_type seed = 0);
+               arb_seed_type seed = 0, const std::filesystem::path& connection_cache = {});
 
     simulation(const recipe& rec,
                context ctx = make_context(),
@@ -46,6 +52,11 @@ public:
 
     void update(const recipe& rec);
 
+    // Add and remove connections terminating on local cells, without rebuilding
+    // the connection table or event generators from a recipe. Must be called
+    // collectively on all ranks.
+    void update_connections(const connection_delta& delta);
+
     void reset();
 
     time_type run(const units::quantity& tfinal, const units::quantity& dt);
@@ -131,6 +142,11 @@ public:
         return *this;
     }
 
+    simulation_builder& set_connection_cache(std::filesystem::path path) noexcept {
+        connection_cache_ = std::move(path);
+        return *this;
+    }
+
     operator simulation() const { return build(); }
 
     std::unique_ptr<simulation> make_unique() const {
@@ -151,7 +167,7 @@ private:
     }
 
     simulation build(context ctx, domain_decomposition const& decomp) const {
-        return simulation(rec_, ctx, decomp, seed_);
+        return simulation(rec_, ctx, decomp, seed_, connection_cache_);
     }
 
 private:
@@ -159,6 +175,7 @@ private:
     context ctx_;
     std::function<domain_decomposition(const recipe&, context)> balancer_;
     arb_seed_type seed_ = 0u;
+    std::filesystem::path connection_cache_;
 };
 
 // An epoch callback function that prints out a text progress bar.
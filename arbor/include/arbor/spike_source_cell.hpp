@@ -3,20 +3,35 @@
 #include <arbor/common_types.hpp>
 #include <arbor/export.hpp>
 #include <arbor/schedule.hpp>
+#include <arbor/units.hpp>
 
 namespace arb {
 
+// Poisson spike train with rate `rate` on [tstart, tstop), generated by the
+// cell group for all of its cells in a single pass and written straight into
+// its spike buffer. The intervals are drawn from a counter-based generator
+// keyed by `seed` and the gid of the cell, so the train of a cell is
+// independent of the other cells, the partition into groups, and the epochs.
+struct ARB_SYMBOL_VISIBLE poisson_source {
+    units::quantity rate;
+    seed_type seed = default_seed;
+    units::quantity tstart = 0*units::ms;
+    units::quantity tstop = terminal_time*units::ms;
+};
+
 // Cell description returned by recipe::cell_description(gid) for cells with
 // recipe::cell_kind(gid) returning cell_kind::spike_source
 
 struct ARB_SYMBOL_VISIBLE spike_source_cell {
     cell_tag_type source; // Label of source.
     std::vector<schedule> seqs;
+    std::vector<poisson_source> poisson; // Trains generated in bulk, see above.
 
     spike_source_cell() = delete;
     template<typename... Seqs>
     spike_source_cell(cell_tag_type source, Seqs&&... seqs): source(std::move(source)), seqs{std::forward<Seqs>(seqs)...} {}
     spike_source_cell(cell_tag_type source, std::vector<schedule> seqs): source(std::move(source)), seqs(std::move(seqs)) {}
+    spike_source_cell(cell_tag_type source, std::vector<poisson_source> poisson): source(std::move(source)), poisson(std::move(poisson)) {}
 };
 
 } // namespace arb
@@ -36,6 +36,10 @@ public:
 
     std::vector<cell_connection> connections_on(cell_gid_type i) const override;
 
+    std::vector<cell_tag_type> connection_label_table() const override;
+
+    connection_columns connections_on_range(cell_gid_type gid_begin, cell_gid_type gid_end) const override;
+
     std::vector<probe_info> get_probes(cell_gid_type i) const override;
 
     std::any get_global_properties(cell_kind ck) const override;
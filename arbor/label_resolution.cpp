@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <iterator>
 #include <vector>
 #include <numeric>
+#include <tuple>
 
 #include <arbor/assert.hpp>
 #include <arbor/arbexcept.hpp>
@@ -8,8 +10,11 @@
 #include <arbor/util/expected.hpp>
 #include <arbor/util/hash_def.hpp>
 
+#include "distributed_context.hpp"
 #include "label_resolution.hpp"
 #include "util/partition.hpp"
+#include "util/range.hpp"
+#include "util/rangeutil.hpp"
 #include "util/span.hpp"
 
 namespace arb {
@@ -92,44 +97,112 @@ lid_hopefully label_resolution_map::range_set::at(unsigned idx) const {
     return start + offset;
 }
 
+bool label_resolution_map::range_set::contains(cell_lid_type lid) const {
+    return std::any_of(ranges.begin(), ranges.end(),
+                       [lid](const lid_range& r) { return r.begin <= lid && lid < r.end; });
+}
+
+const label_resolution_map::range_set* label_resolution_map::find(cell_gid_type gid, hash_type label) const {
+    const key_type key{gid, label};
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || *it != key) return nullptr;
+    return &sets_[it - keys_.begin()];
+}
+
 const label_resolution_map::range_set& label_resolution_map::at(cell_gid_type gid, const cell_tag_type& tag) const {
-    return map.at(gid).at(hash_value(tag));
+    if (auto set = find(gid, hash_value(tag))) return *set;
+    throw arb::arbor_internal_error("label_resolution_map: unknown label");
 }
 
 std::size_t label_resolution_map::count(cell_gid_type gid, const cell_tag_type& tag) const {
-    if (!map.count(gid)) return 0u;
-    return map.at(gid).count(hash_value(tag));
+    return find(gid, hash_value(tag)) ? 1u : 0u;
+}
+
+label_resolution_map::label_resolution_map(std::vector<entry> entries) {
+    auto key_of = [](const entry& e) { return key_type{e.gid, e.label}; };
+    // Stable, as the order of ranges determines the lids selected by round robin.
+    std::stable_sort(entries.begin(), entries.end(),
+                     [&](const entry& a, const entry& b) { return key_of(a) < key_of(b); });
+
+    for (const auto& e: entries) {
+        if (e.range.end < e.range.begin) {
+            throw arb::arbor_internal_error("label_resolution_map: invalid lid_range");
+        }
+        if (keys_.empty() || keys_.back() != key_of(e)) {
+            keys_.push_back(key_of(e));
+            sets_.emplace_back();
+        }
+        auto& range_set = sets_.back();
+        range_set.ranges.push_back(e.range);
+        range_set.ranges_partition.push_back(range_set.ranges_partition.back() + e.range.end - e.range.begin);
+    }
+}
+
+label_resolution_map::label_resolution_map(const cell_labels_and_gids& clg):
+    label_resolution_map(make_label_entries(clg))
+{
+    auto gids = clg.gids;
+    util::sort(gids);
+    if (std::adjacent_find(gids.begin(), gids.end()) != gids.end()) {
+        throw arb::arbor_internal_error("label_resolution_map: duplicate gid");
+    }
 }
 
-label_resolution_map::label_resolution_map(const cell_labels_and_gids& clg) {
+std::vector<label_resolution_map::entry> make_label_entries(const cell_labels_and_gids& clg) {
     arb_assert(clg.label_range.check_invariant());
     const auto& gids = clg.gids;
     const auto& labels = clg.label_range.labels;
     const auto& ranges = clg.label_range.ranges;
     const auto& sizes = clg.label_range.sizes;
 
+    std::vector<label_resolution_map::entry> entries;
+    entries.reserve(labels.size());
     std::vector<cell_size_type> label_divs;
     auto partn = util::make_partition(label_divs, sizes);
     for (auto i: util::count_along(partn)) {
-        auto gid = gids[i];
-
-        std::unordered_map<hash_type, range_set> m;
         for (auto label_idx: util::make_span(partn[i])) {
-            const auto range = ranges[label_idx];
-            auto size = int(range.end - range.begin);
-            if (size < 0) {
-                throw arb::arbor_internal_error("label_resolution_map: invalid lid_range");
-            }
-            auto& label = labels[label_idx];
-            auto& range_set = m[label];
-            range_set.ranges.push_back(range);
-            range_set.ranges_partition.push_back(range_set.ranges_partition.back() + size);
-        }
-        if (!map.insert({gid, std::move(m)}).second) {
-            throw arb::arbor_internal_error("label_resolution_map: duplicate gid");
+            entries.push_back({gids[i], labels[label_idx], ranges[label_idx]});
         }
     }
+    return entries;
 }
+
+void find_label_entries(const std::vector<label_resolution_map::entry>& entries,
+                        const label_resolution_map::key_type& key,
+                        std::vector<label_resolution_map::entry>& out) {
+    auto key_less = [](const label_resolution_map::entry& e, const label_resolution_map::key_type& k) {
+        return label_resolution_map::key_type{e.gid, e.label} < k;
+    };
+    for (auto it = std::lower_bound(entries.begin(), entries.end(), key, key_less);
+         it != entries.end() && it->gid == key.first && it->label == key.second;
+         ++it) {
+        out.push_back(*it);
+    }
+}
+
+label_resolution_map make_resolution_map(const cell_labels_and_gids& local,
+                                         std::vector<label_resolution_map::key_type> required,
+                                         const std::function<int(cell_gid_type)>& gid_domain,
+                                         const distributed_context& ctx) {
+    util::sort(required);
+    required.erase(std::unique(required.begin(), required.end()), required.end());
+
+    // Bin the requests by the rank owning the gid.
+    const int num_ranks = ctx.size();
+    std::vector<std::vector<label_resolution_map::key_type>> requests(num_ranks);
+    for (const auto& key: required) {
+        const auto rank = gid_domain(key.first);
+        if (rank >= 0 && rank < num_ranks) requests[rank].push_back(key);
+    }
+
+    // Stable, as the order of ranges determines the lids selected by round robin.
+    auto local_entries = make_label_entries(local);
+    std::stable_sort(local_entries.begin(), local_entries.end(),
+                     [](const auto& a, const auto& b) { return std::tie(a.gid, a.label) < std::tie(b.gid, b.label); });
+
+    return label_resolution_map(ctx.exchange_label_requests(local_entries, requests));
+}
+
 // variant state methods
 lid_hopefully round_robin_state::update(const label_resolution_map::range_set& range_set) {
     auto lid = range_set.at(state);
@@ -214,12 +287,12 @@ lid_hopefully update_state(resolver::state_variant& v,
 }
 
 cell_lid_type resolver::resolve(cell_gid_type gid, const cell_local_label_type& label) {
-    const auto& [tag, pol] = label;
-
-    auto hash = hash_value(tag);
+    return resolve(gid, label.tag, hash_value(label.tag), label.policy);
+}
 
-    if (!label_map_->count(gid, tag)) throw arb::bad_connection_label(gid, tag, "label does not exist");
-    const auto& range_set = label_map_->at(gid, tag);
+cell_lid_type resolver::resolve(cell_gid_type gid, const cell_tag_type& tag, hash_type hash, lid_selection_policy pol) {
+    const auto* range_set = label_map_->find(gid, hash);
+    if (!range_set) throw arb::bad_connection_label(gid, tag, "label does not exist");
 
     auto& state = state_map_[gid][hash];
 
@@ -235,7 +308,7 @@ cell_lid_type resolver::resolve(cell_gid_type gid, const cell_local_label_type&
     if (!state.count(pol)) state[pol] = construct_state(pol);
 
     // Update state
-    auto lid = update_state(state[pol], range_set);
+    auto lid = update_state(state[pol], *range_set);
 
     if (!lid) throw arb::bad_connection_label(gid, tag, lid.error());
     return *lid;
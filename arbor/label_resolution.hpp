@@ -1,6 +1,8 @@
 #pragma once
 
+#include <functional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <arbor/export.hpp>
@@ -12,6 +14,8 @@
 
 namespace arb {
 
+class distributed_context;
+
 using lid_hopefully = arb::util::expected<cell_lid_type, std::string>;
 
 // class containing the data required for {cell, label} to lid resolution.
@@ -62,6 +66,9 @@ struct ARB_ARBOR_API cell_labels_and_gids {
 // Class constructed from `cell_labels_and_ranges`:
 // Represents the information in the object in a more
 // structured manner for lid resolution in `resolver`
+//
+// The (gid, label) pairs are kept in a sorted flat array and are found by
+// binary search.
 class ARB_ARBOR_API label_resolution_map {
 public:
     struct range_set {
@@ -69,18 +76,62 @@ public:
         std::vector<unsigned> ranges_partition = {0};
         cell_size_type size() const;
         lid_hopefully at(unsigned idx) const;
+        bool contains(cell_lid_type lid) const;
+    };
+
+    using key_type = std::pair<cell_gid_type, hash_type>;
+
+    // A single lid range of a (gid, label) pair. Trivially copyable, such that
+    // labels can be exchanged between ranks.
+    struct entry {
+        cell_gid_type gid;
+        hash_type label;
+        lid_range range;
     };
 
     label_resolution_map() = default;
     explicit label_resolution_map(const cell_labels_and_gids&);
 
+    // Ranges of the same (gid, label) pair are kept in the order of appearance.
+    explicit label_resolution_map(std::vector<entry>);
+
     const range_set& at(cell_gid_type gid, const cell_tag_type& tag) const;
     std::size_t count(cell_gid_type gid, const cell_tag_type& tag) const;
 
+    // Returns nullptr if the (gid, label) pair is unknown.
+    const range_set* find(cell_gid_type gid, hash_type label) const;
+
+    // The number of (gid, label) pairs.
+    std::size_t size() const { return keys_.size(); }
+
 private:
-    std::unordered_map<cell_gid_type, std::unordered_map<hash_type, range_set>> map;
+    // Sorted in ascending order; sets_[i] holds the lids of keys_[i].
+    std::vector<key_type> keys_;
+    std::vector<range_set> sets_;
 };
 
+// Flatten the labels of the cells in `clg` into entries, in order of appearance.
+ARB_ARBOR_API std::vector<label_resolution_map::entry> make_label_entries(const cell_labels_and_gids& clg);
+
+// Append the entries of the (gid, label) pair `key` to `out`, in order of
+// appearance. `entries` must be stably sorted by (gid, label).
+ARB_ARBOR_API void find_label_entries(const std::vector<label_resolution_map::entry>& entries,
+                                      const label_resolution_map::key_type& key,
+                                      std::vector<label_resolution_map::entry>& out);
+
+// Build the resolution map for the (gid, label) pairs in `required` from the
+// labels of the cells local to each rank, see `local`. Each pair is requested
+// from the rank owning its gid, as given by `gid_domain`, which answers with the
+// matching labels; no other labels are exchanged. Pairs that are not found, or
+// whose gid has no owner (gid_domain returns a negative rank), are omitted, such
+// that resolving them fails.
+//
+// Must be called collectively by all ranks of `ctx`.
+ARB_ARBOR_API label_resolution_map make_resolution_map(const cell_labels_and_gids& local,
+                                                       std::vector<label_resolution_map::key_type> required,
+                                                       const std::function<int(cell_gid_type)>& gid_domain,
+                                                       const distributed_context& ctx);
+
 struct ARB_ARBOR_API round_robin_state {
     cell_lid_type state = 0;
     round_robin_state() : state(0) {};
@@ -108,6 +159,8 @@ struct ARB_ARBOR_API resolver {
     resolver(const label_resolution_map* label_map): label_map_(label_map) {}
     cell_lid_type resolve(const cell_global_label_type& iden);
     cell_lid_type resolve(cell_gid_type gid, const cell_local_label_type& lid);
+    // As above, with the hash of `tag` computed by the caller; `tag` is only used for errors.
+    cell_lid_type resolve(cell_gid_type gid, const cell_tag_type& tag, hash_type hash, lid_selection_policy pol);
 
     using state_variant = std::variant<round_robin_state, round_robin_halt_state, assert_univalent_state>;
 
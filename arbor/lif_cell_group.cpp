@@ -15,8 +15,10 @@ lif_cell_group::lif_cell_group(const std::vector<cell_gid_type>& gids,
                                cell_label_range& cg_targets):
     gids_(gids) {
 
-    for (auto gid: gids_) {
-        const auto& cell = util::any_cast<lif_cell>(rec.get_cell_description(gid));
+    auto batch = batched_cell_descriptions(rec, gids_);
+    for (auto i: util::count_along(gids_)) {
+        const auto gid = gids_[i];
+        const auto& cell = util::any_cast<lif_cell>(batch.empty()? rec.get_cell_description(gid): std::move(batch[i]));
         // set up cell state
         cells_.emplace_back(cell);
         last_time_updated_.push_back(0.0);
@@ -1,7 +1,7 @@
-#include <set>
-#include <vector>
+#include <algorithm>
+#include <functional>
 #include <numeric>
-#include <queue>
+#include <vector>
 
 #include <arbor/common_types.hpp>
 
@@ -39,31 +39,39 @@ void ARB_ARBOR_API linear_merge_events(std::vector<event_span>& sources, pse_vec
 
 // priority-queue based merge.
 void ARB_ARBOR_API pqueue_merge_events(std::vector<event_span>& sources, pse_vector& out) {
-    // Min heap tracking the minimum element from each span
+    // Min heap tracking the minimum element from each span. The storage is
+    // kept per thread, as this is called once per cell and epoch.
     using kv_type = std::pair<spike_event, int>;
-    std::priority_queue<kv_type, std::vector<kv_type>, std::greater<>> heap;
+    thread_local static std::vector<kv_type> heap;
+    heap.clear();
+    auto cmp = std::greater<>{};
 
     // Add the first element from each sorted vector to the min heap
     for (std::size_t ix = 0; ix < sources.size(); ++ix) {
         auto& source = sources[ix];
         if (!source.empty()) {
-            heap.emplace(source.front(), ix);
+            heap.emplace_back(source.front(), ix);
             source.left++;
         }
     }
+    std::make_heap(heap.begin(), heap.end(), cmp);
 
     // Merge by continually popping the minimum element from the min heap
     while (!heap.empty()) {
-        auto [value, ix] = heap.top();
-        heap.pop();
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        auto& [value, ix] = heap.back();
         out.emplace_back(value);
 
         // If the sorted vector from which the minimum element was taken still
-        // has elements, add the next smallest element to the heap
+        // has elements, replace it with the next smallest element
         auto& source = sources[ix];
         if (!source.empty()) {
-            heap.emplace(source.front(), ix);
+            value = source.front();
             source.left++;
+            std::push_heap(heap.begin(), heap.end(), cmp);
+        }
+        else {
+            heap.pop_back();
         }
     }
 }
@@ -189,6 +189,28 @@ msize_t segment_tree::append(msize_t p, const mpoint& dist, int tag) {
     return append(p, segments_[p].dist, dist, tag);
 }
 
+msize_t segment_tree::append(msize_t n, const msize_t* parents, const mpoint* prox, const mpoint* dist, const int* tags) {
+    const auto base = size();
+    for (msize_t i = 0; i<n; ++i) {
+        auto p = parents[i];
+        if (p>=base+i && p!=mnpos) {
+            throw invalid_segment_parent(p, base+i);
+        }
+    }
+
+    segments_.reserve(base+n);
+    parents_.insert(parents_.end(), parents, parents+n);
+    seg_children_.resize(base+n);
+    for (msize_t i = 0; i<n; ++i) {
+        segments_.push_back(msegment{base+i, prox[i], dist[i], tags[i]});
+        if (parents[i]!=mnpos) {
+            seg_children_[parents[i]].increment();
+        }
+    }
+
+    return size()-1;
+}
+
 msize_t segment_tree::size() const {
     return segments_.size();
 }
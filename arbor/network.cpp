@@ -24,6 +24,7 @@ namespace {
 // Different seed for each type to avoid unintentional correlation.
 enum class network_seed : unsigned {
     selection_random = 2058443,
+    selection_random_skip = 730931,
     value_uniform = 48202,
     value_normal = 8405,
     value_truncated_normal = 380237,
@@ -500,6 +501,12 @@ struct network_selection_named_impl: public network_selection_impl {
         return selection->select_target(kind, gid, label);
     }
 
+    std::optional<network_selection_bernoulli> bernoulli() const override {
+        if (!selection)
+            throw arbor_internal_error("Trying to use unitialized named network selection.");
+        return selection->bernoulli();
+    }
+
     void initialize(const network_label_dict& dict) override {
         auto s = dict.selection(selection_name);
         if (!s.has_value())
@@ -624,6 +631,13 @@ struct network_selection_random_impl: public network_selection_impl {
         return true;
     }
 
+    std::optional<network_selection_bernoulli> bernoulli() const override {
+        if (!probability) return std::nullopt;
+        const auto p = probability->constant();
+        if (!p) return std::nullopt;
+        return network_selection_bernoulli{seed, p.value(), {}};
+    }
+
     void initialize(const network_label_dict& dict) override {
         probability = thingify(p_value, dict);
     };
@@ -667,6 +681,19 @@ struct network_selection_intersect_impl: public network_selection_impl {
         return std::nullopt;
     }
 
+    std::optional<network_selection_bernoulli> bernoulli() const override {
+        // Only one side is sampled, the other one is evaluated for selected candidates only.
+        if (auto b = left->bernoulli()) {
+            b->predicates.push_back(right.get());
+            return b;
+        }
+        if (auto b = right->bernoulli()) {
+            b->predicates.push_back(left.get());
+            return b;
+        }
+        return std::nullopt;
+    }
+
     void initialize(const network_label_dict& dict) override {
         left->initialize(dict);
         right->initialize(dict);
@@ -822,6 +849,8 @@ struct network_value_scalar_impl: public network_value_impl {
         return value;
     }
 
+    std::optional<double> constant() const override { return value; }
+
     void print(std::ostream& os) const override { os << "(scalar " << value << ")"; }
 };
 
@@ -954,6 +983,11 @@ struct network_value_named_impl: public network_value_impl {
         return value->get(source, target);
     }
 
+    std::optional<double> constant() const override {
+        if (!value) throw arbor_internal_error("Trying to use unitialized named network value.");
+        return value->constant();
+    }
+
     void initialize(const network_label_dict& dict) override {
         auto v = dict.value(value_name);
         if (!v.has_value())
@@ -1199,6 +1233,38 @@ struct network_value_if_else_impl: public network_value_impl {
 
 }  // namespace
 
+network_skip_sampler::network_skip_sampler(unsigned seed,
+    double p,
+    cell_gid_type source_gid,
+    cell_lid_type source_lid,
+    std::uint64_t block):
+    seed_(seed),
+    source_((std::uint64_t(source_gid) << 32) | std::uint64_t(source_lid)),
+    block_(block),
+    inv_log_q_(1.0 / std::log1p(-p)) {
+    if (!(p > 0.0)) throw arbor_internal_error("Skip sampling requires a positive probability.");
+}
+
+std::uint64_t network_skip_sampler::next() {
+    // Large enough to skip any block, small enough to never overflow when added to an index.
+    constexpr std::uint64_t max_gap = std::uint64_t(1) << 62;
+
+    if (cache_index_ == cache_.size()) {
+        const cbprng::array_type counter = {
+            {unsigned(network_seed::selection_random_skip), seed_, block_, counter_++}};
+        const cbprng::array_type key = {{source_, seed_, seed_ + 1, seed_ + 2}};
+        cbprng::generator gen;
+        const auto r = gen(counter, key);
+        std::copy(r.begin(), r.end(), cache_.begin());
+        cache_index_ = 0;
+    }
+
+    // u is in (0, 1], hence the gap is finite and non-negative.
+    const double u = r123::u01<double>(cache_[cache_index_++]);
+    const double gap = std::floor(std::log(u) * inv_log_q_);
+    return gap < double(max_gap) ? std::uint64_t(gap) : max_gap;
+}
+
 network_selection::network_selection(std::shared_ptr<network_selection_impl> impl):
     impl_(std::move(impl)) {}
 
@@ -22,8 +22,10 @@
 #include <arbor/util/unique_any.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -45,6 +47,23 @@ struct network_site_info_extended {
     cell_lid_type lid;
 };
 
+// Expected number of selected candidates per block for skip sampling. Blocks are sized from global
+// quantities only, such that the random streams do not depend on the domain decomposition, while
+// the number of visited blocks and the draws within them both scale with the selected connections.
+constexpr double skip_sampling_selected_per_block = 16.0;
+
+std::uint64_t skip_sampling_block_gids(double p, std::uint64_t lids_per_gid) {
+    if (!(p > 0.0) || !lids_per_gid) return std::numeric_limits<std::uint64_t>::max();
+    const double n = std::ceil(skip_sampling_selected_per_block / (p * double(lids_per_gid)));
+    return n < double(std::uint64_t(1) << 32) ? std::max<std::uint64_t>(1, n) : std::uint64_t(1) << 32;
+}
+
+// Range of sorted target sites within one block of gids.
+struct target_block {
+    std::uint64_t index;
+    std::size_t begin, end;
+};
+
 void push_back(const domain_decomposition& dom_dec,
     std::vector<connection>& vec,
     const network_site_info_extended& source,
@@ -221,18 +240,53 @@ std::vector<ConnectionType> generate_network_connections_impl(const recipe& rec,
     for (const auto& batch: tgt_site_batches)
         tgt_sites.insert(tgt_sites.end(), batch.begin(), batch.end());
 
-    // create octree
-    const std::size_t max_depth = selection.max_distance().has_value() ? 10 : 1;
-    const std::size_t max_leaf_size = 100;
-    spatial_tree<network_site_info_extended, 3> local_tgt_tree(max_depth,
-        max_leaf_size,
-        std::move(tgt_sites),
-        [](const network_site_info_extended& ex)
-            -> spatial_tree<network_site_info_extended, 3>::point_type {
-            return {
-                ex.info.global_location.x, ex.info.global_location.y, ex.info.global_location.z};
+    // A bernoulli selection with constant probability is sampled by skipping over the virtual index
+    // space of all (gid, lid) target pairs, which are split into blocks of consecutive gids. Only
+    // blocks with local targets are visited and each selected index is looked up in the sorted
+    // local targets. Blocks are sized to hold a fixed expected number of selected candidates, so
+    // the work per source is proportional to its selected connections. Since the index space and
+    // random streams are identical on all ranks, the result does not depend on the number of ranks.
+    std::optional<network_selection_bernoulli> bernoulli;
+    if (!selection.max_distance()) bernoulli = selection.bernoulli();
+
+    std::vector<network_site_info_extended> sorted_tgt_sites;
+    std::vector<target_block> tgt_blocks;
+    std::uint64_t lids_per_gid = 0;
+    std::uint64_t block_gids = 0;
+    if (bernoulli) {
+        sorted_tgt_sites = std::move(tgt_sites);
+        tgt_sites.clear();
+        util::sort_by(sorted_tgt_sites, [](const network_site_info_extended& ex) {
+            return std::make_pair(ex.info.gid, ex.lid);
         });
 
+        cell_lid_type max_lid = 0;
+        for (const auto& site: sorted_tgt_sites) max_lid = std::max(max_lid, site.lid);
+        // must be identical on all ranks
+        lids_per_gid =
+            distributed.max((unsigned long long)(sorted_tgt_sites.empty() ? 0 : max_lid + 1));
+        block_gids = skip_sampling_block_gids(bernoulli->probability, lids_per_gid);
+
+        for (std::size_t i = 0; i < sorted_tgt_sites.size(); ++i) {
+            const std::uint64_t index = sorted_tgt_sites[i].info.gid / block_gids;
+            if (tgt_blocks.empty() || tgt_blocks.back().index != index) {
+                tgt_blocks.push_back({index, i, i});
+            }
+            tgt_blocks.back().end = i + 1;
+        }
+    }
+
+    // create octree
+    using tree_type = spatial_tree<network_site_info_extended, 3>;
+    auto site_location = [](const network_site_info_extended& ex) -> tree_type::point_type {
+        return {ex.info.global_location.x, ex.info.global_location.y, ex.info.global_location.z};
+    };
+    // Only radius queries benefit from a hierarchy, which is then tuned to the query radius.
+    const auto max_distance = selection.max_distance();
+    const tree_type local_tgt_tree =
+        max_distance ? tree_type::for_radius(*max_distance, std::move(tgt_sites), site_location)
+                     : tree_type(1, 0, std::move(tgt_sites), site_location);
+
     // select connections
     std::vector<std::vector<ConnectionType>> connection_batches(num_batches);
 
@@ -253,16 +307,51 @@ std::vector<ConnectionType> generate_network_connections_impl(const recipe& rec,
                     }
                 };
 
-                if (selection.max_distance().has_value()) {
-                    const double d = selection.max_distance().value();
-                    local_tgt_tree.bounding_box_for_each(
-                        decltype(local_tgt_tree)::point_type{source.info.global_location.x - d,
-                            source.info.global_location.y - d,
-                            source.info.global_location.z - d},
-                        decltype(local_tgt_tree)::point_type{source.info.global_location.x + d,
-                            source.info.global_location.y + d,
-                            source.info.global_location.z + d},
-                        sample);
+                if (bernoulli) {
+                    const auto& b = bernoulli.value();
+                    auto sample_if = [&](const network_site_info_extended& target) {
+                        for (const auto* p: b.predicates) {
+                            if (!p->select_connection(source.info, target.info)) return;
+                        }
+                        const auto w = weight.get(source.info, target.info);
+                        const auto d = delay.get(source.info, target.info);
+
+                        push_back(dom_dec, connections, source, target, w, d);
+                    };
+
+                    if (b.probability <= 0.0) return;
+                    if (b.probability >= 1.0) {
+                        for (const auto& target: sorted_tgt_sites) sample_if(target);
+                        return;
+                    }
+
+                    const std::uint64_t block_size = block_gids * lids_per_gid;
+                    for (const auto& block: tgt_blocks) {
+                        const auto first = sorted_tgt_sites.begin() + block.begin;
+                        const auto last = sorted_tgt_sites.begin() + block.end;
+                        const std::uint64_t gid_offset = block.index * block_gids;
+
+                        network_skip_sampler sampler(
+                            b.seed, b.probability, source.info.gid, source.lid, block.index);
+                        for (std::uint64_t idx = sampler.next(); idx < block_size;
+                             idx += 1 + sampler.next()) {
+                            const auto key = std::make_pair(
+                                cell_gid_type(gid_offset + idx / lids_per_gid),
+                                cell_lid_type(idx % lids_per_gid));
+                            const auto it = std::lower_bound(first,
+                                last,
+                                key,
+                                [](const network_site_info_extended& ex, const auto& k) {
+                                    return std::make_pair(ex.info.gid, ex.lid) < k;
+                                });
+                            if (it != last && it->info.gid == key.first && it->lid == key.second)
+                                sample_if(*it);
+                        }
+                    }
+                }
+                else if (max_distance) {
+                    const auto& p = source.info.global_location;
+                    local_tgt_tree.radius_for_each({p.x, p.y, p.z}, *max_distance, sample);
                 }
                 else { local_tgt_tree.for_each(sample); }
             });
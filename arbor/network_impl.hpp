@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <string_view>
 #include <vector>
@@ -21,9 +24,24 @@
 
 namespace arb {
 
+struct network_selection_impl;
+
+// Decomposition of a selection into a single bernoulli draw with constant probability,
+// intersected with further predicates. Such selections are sampled by skipping geometrically
+// distributed gaps over the candidates instead of drawing a random number for each pair.
+struct network_selection_bernoulli {
+    unsigned seed = 0;
+    double probability = 0.0;
+    // Selections, that must also hold for a connection to be selected. Owned by the selection
+    // this decomposition was taken from.
+    std::vector<const network_selection_impl*> predicates;
+};
+
 struct network_selection_impl {
     virtual std::optional<double> max_distance() const { return std::nullopt; }
 
+    virtual std::optional<network_selection_bernoulli> bernoulli() const { return std::nullopt; }
+
     virtual bool select_connection(const network_site_info& source,
         const network_site_info& target) const = 0;
 
@@ -47,6 +65,9 @@ inline std::shared_ptr<network_selection_impl> thingify(network_selection s,
 struct network_value_impl {
     virtual double get(const network_site_info& source, const network_site_info& target) const = 0;
 
+    // Value independent of source and target, if known before evaluation.
+    virtual std::optional<double> constant() const { return std::nullopt; }
+
     virtual void initialize(const network_label_dict& dict){};
 
     virtual void print(std::ostream& os) const = 0;
@@ -60,6 +81,27 @@ inline std::shared_ptr<network_value_impl> thingify(network_value v,
     return v.impl_;
 }
 
+// Generates the gaps between selected indices of a bernoulli selection with constant probability.
+// The sequence of gaps only depends on the seed, the source site and the block of candidates it is
+// drawn for, such that generated connections are independent of the domain decomposition.
+class network_skip_sampler {
+public:
+    network_skip_sampler(unsigned seed,
+        double p,
+        cell_gid_type source_gid,
+        cell_lid_type source_lid,
+        std::uint64_t block);
+
+    // Number of unselected indices before the next selected one.
+    std::uint64_t next();
+
+private:
+    std::uint64_t seed_, source_, block_, counter_ = 0;
+    double inv_log_q_;
+    std::array<std::uint64_t, 4> cache_;
+    unsigned cache_index_ = 4;
+};
+
 std::vector<connection> generate_connections(const recipe& rec,
     const context& ctx,
     const domain_decomposition& dom_dec);
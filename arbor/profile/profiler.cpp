@@ -1,7 +1,19 @@
+#include <array>
+#include <cstdint>
 #include <cstdio>
+#include <memory>
 #include <mutex>
 #include <ostream>
 
+#if defined(__linux__) && defined(__x86_64__)
+#define ARB_PERF_RDPMC
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <arbor/context.hpp>
 #include <arbor/profile/profiler.hpp>
 
@@ -16,7 +28,8 @@ namespace profile {
 using timer_type = timer<>;
 using util::make_span;
 
-#ifdef ARB_HAVE_PROFILING
+ARB_ARBOR_API std::atomic<bool> profiler_enabled_flag{false};
+
 namespace {
     // Check whether a string describes a valid profiler region name.
     bool is_valid_region_string(const std::string& s) {
@@ -43,10 +56,124 @@ namespace {
     }
 }
 
-// Holds the accumulated number of calls and time spent in a region.
+// Hardware counters of the calling thread. The counters are read in user
+// space with rdpmc, such that entering and leaving a region costs no system
+// call. Only available if the kernel grants rdpmc access, see open().
+class perf_counters {
+public:
+    static constexpr std::size_t size = 3;
+    using values = std::array<std::uint64_t, size>;
+
+    static const std::vector<std::string>& names() {
+        static std::vector<std::string> n = {"CYCLES", "INSTR", "LLC-MISS"};
+        return n;
+    }
+
+#ifdef ARB_PERF_RDPMC
+    // Open and map the counters for the calling thread; returns false if
+    // they are unavailable, or cannot be read from user space.
+    bool open() {
+        static constexpr std::uint64_t events[size] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+        };
+        const auto page_size = sysconf(_SC_PAGESIZE);
+        for (std::size_t i = 0; i<size; ++i) {
+            perf_event_attr attr = {};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = events[i];
+            attr.disabled = i==0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_[i] = syscall(SYS_perf_event_open, &attr, 0, -1, i? fd_[0]: -1, 0);
+            if (fd_[i]<0) {
+                close();
+                return false;
+            }
+            void* page = mmap(nullptr, page_size, PROT_READ, MAP_SHARED, fd_[i], 0);
+            if (page==MAP_FAILED) {
+                close();
+                return false;
+            }
+            page_[i] = static_cast<perf_event_mmap_page*>(page);
+        }
+        ioctl(fd_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        for (auto p: page_) {
+            if (!p->cap_user_rdpmc) {
+                close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void read(values& v) const {
+        for (std::size_t i = 0; i<size; ++i) v[i] = read(page_[i]);
+    }
+
+    void close() {
+        const auto page_size = sysconf(_SC_PAGESIZE);
+        for (auto& p: page_) {
+            if (p) munmap(p, page_size);
+            p = nullptr;
+        }
+        for (auto& fd: fd_) {
+            if (fd>=0) ::close(fd);
+            fd = -1;
+        }
+    }
+#else
+    bool open() { return false; }
+    void read(values&) const {}
+    void close() {}
+#endif
+
+    perf_counters() = default;
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+    ~perf_counters() { close(); }
+
+private:
+#ifdef ARB_PERF_RDPMC
+    // See the description of perf_event_mmap_page in linux/perf_event.h.
+    static std::uint64_t read(const volatile perf_event_mmap_page* p) {
+        std::uint32_t seq;
+        std::uint64_t count;
+        do {
+            seq = p->lock;
+            asm volatile("" ::: "memory");
+            count = p->offset;
+            if (auto index = p->index) {
+                std::uint32_t lo, hi;
+                asm volatile("rdpmc" : "=a"(lo), "=d"(hi) : "c"(index - 1));
+                // Sign extend the counter of pmc_width bits.
+                auto shift = 64 - p->pmc_width;
+                count += std::int64_t((std::uint64_t(hi) << 32 | lo) << shift) >> shift;
+            }
+            asm volatile("" ::: "memory");
+        } while (p->lock!=seq);
+        return count;
+    }
+
+    int fd_[size] = {-1, -1, -1};
+    perf_event_mmap_page* page_[size] = {nullptr, nullptr, nullptr};
+#endif
+};
+
+// Holds the accumulated number of calls, time and hardware counts of a region.
 struct profile_accumulator {
     std::size_t count=0;
     double time=0.;
+    perf_counters::values counters = {};
+};
+
+// The entry and exit of a region on one thread.
+struct trace_event {
+    region_id_type index;
+    tick_type begin;
+    tick_type end;
 };
 
 // Records the accumulated time spent in profiler regions on one thread.
@@ -64,27 +191,61 @@ class recorder {
     // One accumulator for call count and wall time for each region.
     std::vector<profile_accumulator> accumulators_;
 
+    // Hardware counters, if enabled and available, and their values on entry.
+    std::unique_ptr<perf_counters> counters_;
+    perf_counters::values start_counters_;
+    bool want_counters_ = false;
+
+    // The last regions entered and left, if tracing is enabled, in a ring
+    // buffer of trace_capacity_ records starting at trace_head_.
+    std::vector<trace_event> trace_;
+    std::size_t trace_head_ = 0;
+    std::size_t trace_capacity_ = 0;
+    bool want_trace_ = false;
+
 public:
+    // Select the optional recording.
+    void configure(const profiler_options& options);
+
     // Return a list of the accumulated call count and wall times for each region.
     const std::vector<profile_accumulator>& accumulators() const;
 
+    // Whether hardware counters were recorded.
+    bool has_counters() const { return !!counters_; }
+
+    // Return the recorded trace, oldest record first.
+    std::vector<trace_event> trace() const;
+
     // Start timing the region with index.
     // Throws std::runtime_error if already timing a region.
     void enter(region_id_type index);
 
     // Stop timing the current region, and add the time taken to the accumulated time.
-    // Throws std::runtime_error if not currently timing a region.
+    // Does nothing if not currently timing a region, which happens if the
+    // region was entered before the recording started.
     void leave();
+};
 
-    // Reset all of the accumulated call counts and times to zero.
-    void clear();
+// The recorders of one recording, from profiler_initialize to profiler_finalize.
+struct recording {
+    std::vector<recorder> recorders;
+    std::unordered_map<std::thread::id, std::size_t> thread_ids;
+
+    // Start of recording, as the origin of the trace.
+    tick_type start_time = 0;
 };
 
 // Manages the thread-local recorders.
 class profiler {
-    std::vector<recorder> recorders_;
+    // All recordings, the last holding the current results. Recordings are
+    // never modified once published, and are kept until the profiler is
+    // destroyed, such that threads entering or leaving regions while the
+    // profiler is initialized or finalized never see a recording that is
+    // being built or destroyed.
+    std::vector<std::unique_ptr<recording>> recordings_;
 
-    std::unordered_map<std::thread::id, std::size_t> thread_ids_;
+    // The recording in progress, or nullptr.
+    std::atomic<recording*> active_ = nullptr;
 
     // Hash table that maps region names to a unique index.
     // The regions are assigned consecutive indexes in the order that they are
@@ -99,19 +260,21 @@ class profiler {
     // Used to protect name_index_, which is shared between all threads.
     std::mutex mutex_;
 
-    // Flag to indicate whether the profiler has been initialized with the task_system
-    bool init_ = false;
+    // The recorder of the calling thread, or nullptr if not recording.
+    recorder* current_recorder();
 
 public:
     profiler();
 
-    void initialize(task_system_handle& ts);
+    void initialize(task_system_handle& ts, const profiler_options& options);
+    void finalize();
     void enter(region_id_type index);
     void enter(const std::string& name);
     void leave();
     const std::vector<std::string>& regions() const;
     region_id_type region_index(const std::string& name);
     profile results() const;
+    std::ostream& write_trace(std::ostream& os) const;
 
     static profiler& get_global_profiler() {
         static profiler p;
@@ -127,17 +290,34 @@ struct profile_node {
     std::string name;
     double time = 0;
     region_id_type count = npos;
+    std::vector<std::uint64_t> counters;
     std::vector<profile_node> children;
 
     profile_node() = default;
-    profile_node(std::string n, double t, region_id_type c):
-        name(std::move(n)), time(t), count(c) {}
+    profile_node(std::string n, double t, region_id_type c, std::vector<std::uint64_t> k = {}):
+        name(std::move(n)), time(t), count(c), counters(std::move(k)) {}
     profile_node(std::string n):
         name(std::move(n)), time(0), count(npos) {}
 };
 
 // recorder implementation
 
+void recorder::configure(const profiler_options& options) {
+    // Counters are opened on first entry, as they count the opening thread.
+    counters_.reset();
+    want_counters_ = options.counters;
+    want_trace_ = options.trace && options.trace_capacity;
+    trace_capacity_ = options.trace_capacity;
+    trace_.clear();
+    trace_head_ = 0;
+}
+
+std::vector<trace_event> recorder::trace() const {
+    std::vector<trace_event> result(trace_.begin() + trace_head_, trace_.end());
+    result.insert(result.end(), trace_.begin(), trace_.begin() + trace_head_);
+    return result;
+}
+
 const std::vector<profile_accumulator>& recorder::accumulators() const {
     return accumulators_;
 }
@@ -150,50 +330,89 @@ void recorder::enter(region_id_type index) {
         accumulators_.resize(index+1);
     }
     index_ = index;
+    if (want_counters_) {
+        if (!counters_) {
+            counters_ = std::make_unique<perf_counters>();
+            if (!counters_->open()) {
+                counters_.reset();
+                want_counters_ = false;
+            }
+        }
+        if (counters_) counters_->read(start_counters_);
+    }
     start_time_ = timer_type::tic();
 }
 
 void recorder::leave() {
     // calculate the elapsed time before any other steps, to increase accuracy.
-    auto delta = timer_type::toc(start_time_);
-
-    if (index_==npos) {
-        throw std::runtime_error("recorder::leave without matching recorder::enter");
+    auto end_time = timer_type::tic();
+    auto delta = (end_time - start_time_)*default_clock::seconds_per_tick();
+
+    // The region was entered while the profiler was disabled.
+    if (index_==npos) return;
+    auto& acc = accumulators_[index_];
+    acc.count++;
+    acc.time += delta;
+    if (counters_) {
+        perf_counters::values end_counters;
+        counters_->read(end_counters);
+        for (std::size_t i = 0; i<perf_counters::size; ++i) {
+            acc.counters[i] += end_counters[i] - start_counters_[i];
+        }
+    }
+    if (want_trace_) {
+        if (trace_.size()<trace_capacity_) {
+            trace_.push_back({index_, start_time_, end_time});
+        }
+        else {
+            trace_[trace_head_] = {index_, start_time_, end_time};
+            trace_head_ = (trace_head_ + 1)%trace_capacity_;
+        }
     }
-    accumulators_[index_].count++;
-    accumulators_[index_].time += delta;
     index_ = npos;
 }
 
-void recorder::clear() {
-    index_ = npos;
-    accumulators_.resize(0);
+// profiler implementation
+
+profiler::profiler() {
+    recordings_.push_back(std::make_unique<recording>());
 }
 
-// profiler implementation
+void profiler::initialize(task_system_handle& ts, const profiler_options& options) {
+    auto rec = std::make_unique<recording>();
+    rec->recorders.resize(ts.get()->get_num_threads());
+    for (auto& r: rec->recorders) r.configure(options);
+    rec->thread_ids = ts.get()->get_thread_ids();
+    rec->start_time = timer_type::tic();
 
-profiler::profiler() {}
+    recordings_.push_back(std::move(rec));
+    active_.store(recordings_.back().get(), std::memory_order_release);
+    profiler_enabled_flag = true;
+}
 
-void profiler::initialize(task_system_handle& ts) {
-    recorders_.resize(ts.get()->get_num_threads());
-    thread_ids_ = ts.get()->get_thread_ids();
-    init_ = true;
+void profiler::finalize() {
+    profiler_enabled_flag = false;
+    active_.store(nullptr, std::memory_order_release);
+}
+
+recorder* profiler::current_recorder() {
+    auto rec = active_.load(std::memory_order_acquire);
+    if (!rec) return nullptr;
+    // Threads outside of the thread pool are not recorded.
+    auto it = rec->thread_ids.find(std::this_thread::get_id());
+    return it==rec->thread_ids.end()? nullptr: &rec->recorders[it->second];
 }
 
 void profiler::enter(region_id_type index) {
-    if (!init_) return;
-    recorders_[thread_ids_.at(std::this_thread::get_id())].enter(index);
+    if (auto r = current_recorder()) r->enter(index);
 }
 
 void profiler::enter(const std::string& name) {
-    if (!init_) return;
-    const auto index = region_index(name);
-    recorders_[thread_ids_.at(std::this_thread::get_id())].enter(index);
+    if (auto r = current_recorder()) r->enter(region_index(name));
 }
 
 void profiler::leave() {
-    if (!init_) return;
-    recorders_[thread_ids_.at(std::this_thread::get_id())].leave();
+    if (auto r = current_recorder()) r->leave();
 }
 
 region_id_type profiler::region_index(const std::string& name) {
@@ -218,9 +437,12 @@ double sort_profile_tree(profile_node& n) {
     // accumulate all time taken in children
     if (!n.children.empty()) {
         n.time = 0;
+        n.counters.clear();
         for (auto &c: n.children) {
             sort_profile_tree(c);
             n.time += c.time;
+            n.counters.resize(c.counters.size());
+            for (auto i: make_span(0, c.counters.size())) n.counters[i] += c.counters[i];
         }
     }
 
@@ -236,9 +458,10 @@ profile profiler::results() const {
     profile p;
     p.names = region_names_;
 
+    const auto& recorders = recordings_.back()->recorders;
     p.times = std::vector<double>(nregions);
     p.counts = std::vector<region_id_type>(nregions);
-    for (auto& r: recorders_) {
+    for (auto& r: recorders) {
         auto& accumulators = r.accumulators();
         for (auto i: make_span(0, accumulators.size())) {
             p.times[i]  += accumulators[i].time;
@@ -246,7 +469,20 @@ profile profiler::results() const {
         }
     }
 
-    p.num_threads = recorders_.size();
+    p.num_threads = recorders.size();
+
+    if (util::any_of(recorders, [](auto& r) { return r.has_counters(); })) {
+        p.counter_names = perf_counters::names();
+        p.counters.assign(nregions, std::vector<std::uint64_t>(perf_counters::size));
+        for (auto& r: recorders) {
+            auto& accumulators = r.accumulators();
+            for (auto i: make_span(0, accumulators.size())) {
+                for (auto j: make_span(0, perf_counters::size)) {
+                    p.counters[i][j] += accumulators[i].counters[j];
+                }
+            }
+        }
+    }
 
     // Remove elements with count == 0
     for(unsigned i=0; i<p.counts.size();) {
@@ -260,6 +496,10 @@ profile profiler::results() const {
         p.counts.pop_back();
         p.times.pop_back();
         p.names.pop_back();
+        if (!p.counters.empty()) {
+            std::swap(p.counters[i], p.counters.back());
+            p.counters.pop_back();
+        }
     }
 
     return p;
@@ -295,7 +535,8 @@ profile_node make_profile_tree(const profile& p) {
                 node = &(*child);
             }
         }
-        node->children.emplace_back(names[idx].back(), p.times[idx], p.counts[idx]);
+        node->children.emplace_back(names[idx].back(), p.times[idx], p.counts[idx],
+                                    p.counters.empty()? std::vector<std::uint64_t>{}: p.counters[idx]);
     }
     sort_profile_tree(tree);
 
@@ -306,12 +547,33 @@ const std::vector<std::string>& profiler::regions() const {
     return region_names_;
 }
 
+std::ostream& profiler::write_trace(std::ostream& os) const {
+    char buf[80];
+    os << "{\"traceEvents\": [";
+    const char* sep = "\n";
+    const auto& rec = *recordings_.back();
+    for (auto tid: make_span(0, rec.recorders.size())) {
+        os << sep << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << tid
+           << ", \"args\": {\"name\": \"thread " << tid << "\"}}";
+        sep = ",\n";
+        for (auto& e: rec.recorders[tid].trace()) {
+            // Timestamps are in microseconds since initialization.
+            snprintf(buf, std::size(buf), "\"ts\": %.3f, \"dur\": %.3f",
+                     (e.begin - rec.start_time)*1e-3, (e.end - e.begin)*1e-3);
+            os << sep << "{\"name\": \"" << region_names_[e.index] << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << tid
+               << ", " << buf << "}";
+        }
+    }
+    return os << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
 struct prof_line {
     std::string name;
     std::string count;
     std::string time;
     std::string thread;
     std::string percent;
+    std::vector<std::string> counters;
 };
 
 void print_lines(std::vector<prof_line>& lines,
@@ -338,6 +600,10 @@ void print_lines(std::vector<prof_line>& lines,
     res.thread = buf;
     snprintf(buf, std::size(buf), "%.1f", float(proportion));
     res.percent = buf;
+    for (auto c: n.counters) {
+        snprintf(buf, std::size(buf), "%.3e", double(c));
+        res.counters.push_back(buf);
+    }
     lines.push_back(res);
     // print each of the children in turn
     for (auto& c: n.children) print_lines(lines, c, wall_time, nthreads, thresh, indent + "  ");
@@ -347,8 +613,9 @@ void print(std::ostream& os,
            profile_node& n,
            float wall_time,
            unsigned nthreads,
-           float thresh) {
-    std::vector<prof_line> lines{{"REGION", "CALLS", "THREAD", "WALL", "\%"}};
+           float thresh,
+           const std::vector<std::string>& counter_names) {
+    std::vector<prof_line> lines{{"REGION", "CALLS", "THREAD", "WALL", "\%", counter_names}};
     print_lines(lines, n, wall_time, nthreads, thresh, "");
     // fixing up lengths here
     std::size_t max_len_name = 0;
@@ -356,23 +623,30 @@ void print(std::ostream& os,
     std::size_t max_len_thread = 0;
     std::size_t max_len_time = 0;
     std::size_t max_len_percent = 0;
+    std::vector<std::size_t> max_len_counters(counter_names.size());
     for (const auto& line: lines) {
         max_len_name = std::max(max_len_name, line.name.size());
         max_len_count = std::max(max_len_count, line.count.size());
         max_len_thread = std::max(max_len_thread, line.thread.size());
         max_len_time = std::max(max_len_time, line.time.size());
         max_len_percent = std::max(max_len_percent, line.percent.size());
+        for (auto i: make_span(0, line.counters.size())) {
+            max_len_counters[i] = std::max(max_len_counters[i], line.counters[i].size());
+        }
     }
 
     auto lpad = [](const std::string& s, std::size_t n) { return std::string(n - s.size(), ' ') + s + "    "; };
     auto rpad = [](const std::string& s, std::size_t n) { return s + std::string(n - s.size(), ' ') + "    "; };
 
-    for (const auto& line: lines) os << rpad(line.name, max_len_name)
-                                     << lpad(line.count, max_len_count)
-                                     << lpad(line.thread, max_len_thread)
-                                     << lpad(line.time, max_len_time)
-                                     << lpad(line.percent, max_len_percent)
-                                     << '\n';
+    for (const auto& line: lines) {
+        os << rpad(line.name, max_len_name)
+           << lpad(line.count, max_len_count)
+           << lpad(line.thread, max_len_thread)
+           << lpad(line.time, max_len_time)
+           << lpad(line.percent, max_len_percent);
+        for (auto i: make_span(0, line.counters.size())) os << lpad(line.counters[i], max_len_counters[i]);
+        os << '\n';
+    }
 };
 
 //
@@ -394,14 +668,22 @@ ARB_ARBOR_API void profiler_enter(region_id_type region_id) {
     profiler::get_global_profiler().enter(region_id);
 }
 
-ARB_ARBOR_API void profiler_initialize(context ctx) {
-    profiler::get_global_profiler().initialize(ctx->thread_pool);
+ARB_ARBOR_API void profiler_initialize(context ctx, const profiler_options& options) {
+    profiler::get_global_profiler().initialize(ctx->thread_pool, options);
+}
+
+ARB_ARBOR_API void profiler_finalize() {
+    profiler::get_global_profiler().finalize();
+}
+
+ARB_ARBOR_API std::ostream& write_profiler_trace(std::ostream& os) {
+    return profiler::get_global_profiler().write_trace(os);
 }
 
 // Print profiler statistics to an ostream
 ARB_ARBOR_API std::ostream& operator<<(std::ostream& o, const profile& prof) {
     auto tree = make_profile_tree(prof);
-    print(o, tree, tree.time, prof.num_threads, 0);
+    print(o, tree, tree.time, prof.num_threads, 0, prof.counter_names);
     return o;
 }
 
@@ -412,22 +694,9 @@ ARB_ARBOR_API profile profiler_summary() {
 ARB_ARBOR_API std::ostream& print_profiler_summary(std::ostream& os, double limit) {
     auto prof = profiler_summary();
     auto tree = make_profile_tree(prof);
-    print(os, tree, tree.time, prof.num_threads, limit);
+    print(os, tree, tree.time, prof.num_threads, limit, prof.counter_names);
     return os;
 }
-    
-#else
-
-ARB_ARBOR_API void profiler_leave() {}
-ARB_ARBOR_API void profiler_enter(region_id_type) {}
-ARB_ARBOR_API profile profiler_summary();
-ARB_ARBOR_API profile profiler_summary() {return profile();}
-ARB_ARBOR_API region_id_type profiler_region_id(const std::string&) {return 0;}
-ARB_ARBOR_API std::ostream& operator<<(std::ostream& o, const profile&) {return o;}
-ARB_ARBOR_API std::ostream& profiler_print_summary(std::ostream& os, double limit) { return os; }
-
-
-#endif // ARB_HAVE_PROFILING
 
 } // namespace profile
 } // namespace arb
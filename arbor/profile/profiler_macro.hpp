@@ -2,22 +2,20 @@
 
 #include <arbor/profile/profiler.hpp>
 
-#ifdef ARB_HAVE_PROFILING
+// The regions are always compiled in; while the profiler is not initialized,
+// entering or leaving a region costs a single load and branch.
 
-    // enter a profiling region
-    #define PE(name) \
-        { \
+// enter a profiling region
+#define PE(name) \
+    { \
+        if (arb::profile::profiler_enabled()) { \
             static std::size_t region_id_ = arb::profile::profiler_region_id(#name); \
             arb::profile::profiler_enter(region_id_); \
-        }
-
-    // leave a profling region
-    #define PL arb::profile::profiler_leave
-
-#else
-
-    #define PE(name)
-    #define PL()
-
-#endif
-
+        } \
+    }
+
+// leave a profling region
+#define PL() \
+    { \
+        if (arb::profile::profiler_enabled()) arb::profile::profiler_leave(); \
+    }
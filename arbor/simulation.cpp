@@ -1,4 +1,7 @@
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <arbor/arbexcept.hpp>
@@ -16,7 +19,8 @@
 #include "cell_group_factory.hpp"
 #include "communication/communicator.hpp"
 #include "merge_events.hpp"
-#include "thread_private_spike_store.hpp"
+#include "event_calendar.hpp"
+#include "group_spike_store.hpp"
 #include "threading/threading.hpp"
 #include "util/maputil.hpp"
 #include "util/span.hpp"
@@ -50,8 +54,9 @@ ARB_ARBOR_API void merge_cell_events(time_type t_from,
         PE(communication:enqueue:setup);
         // Tree-merge events in [t_from, t_to) from old, pending and generator events.
 
-        std::vector<event_span> spanbuf;
-        spanbuf.reserve(2+generators.size());
+        // Reused across cells and epochs to avoid an allocation per cell.
+        thread_local static std::vector<event_span> spanbuf;
+        spanbuf.clear();
 
         auto old_split = split_sorted_range(old_events, t_to, event_time_less());
         auto pending_split = split_sorted_range(pending, t_to, event_time_less());
@@ -85,10 +90,16 @@ ARB_ARBOR_API void merge_cell_events(time_type t_from,
 
 class simulation_state {
 public:
-    simulation_state(const recipe& rec, const domain_decomposition& decomp, context ctx, arb_seed_type seed);
+    simulation_state(const recipe& rec, const domain_decomposition& decomp, context ctx, arb_seed_type seed,
+                     const std::filesystem::path& connection_cache);
 
     void update(const recipe& rec);
 
+    void update_connections(const connection_delta& delta);
+
+    // Set up event buffers and generators after the connections have changed.
+    void update_events(const recipe& rec);
+
     void reset();
 
     time_type run(time_type tfinal, time_type dt);
@@ -114,7 +125,8 @@ public:
     spike_export_function global_export_callback_;
     spike_export_function local_export_callback_;
     epoch_function epoch_callback_;
-    label_resolution_map source_resolution_map_;
+    // Labels of local sources, remote labels are resolved on demand.
+    cell_labels_and_gids local_sources_;
     label_resolution_map target_resolution_map_;
 
 
@@ -139,11 +151,12 @@ public:
     //
     // NOTE(TH): We cannot use ARB_SERDES_ENABLE here for two reasons:
     // - cell_groups contains polymorphic pointers.
-    // - thread_local_storage cannot be assigned to.
+    // - spike stores hold a handle to the thread pool.
     friend void serialize(serializer& ser, const std::string& k, const simulation_state& t) {
         ARB_SERDES_WRITE(t_interval_);
         ARB_SERDES_WRITE(epoch_);
         ARB_SERDES_WRITE(pending_events_);
+        ARB_SERDES_WRITE(event_calendars_);
         ARB_SERDES_WRITE(event_lanes_);
         ARB_SERDES_WRITE(cell_groups_);
         ser.begin_write_array("local_spikes_");
@@ -156,17 +169,19 @@ public:
         ARB_SERDES_READ(t_interval_);
         ARB_SERDES_READ(epoch_);
         ARB_SERDES_READ(pending_events_);
+        ARB_SERDES_READ(event_calendars_);
         ARB_SERDES_READ(event_lanes_);
         ARB_SERDES_READ(cell_groups_);
-        // custom deserialization to avoid ill-defined copy construction.
-        // TODO check whether is OK in actually multi-threaded environments.
+        // Spikes are stored merged; as the buffers are merged again on
+        // gather, it suffices to restore them into the first group.
         ser.begin_read_array("local_spikes_");
-        std::vector<spike> tmp;
-        deserialize(ser, "0", tmp);
-        t.local_spikes_[0].insert(tmp);
-        tmp.clear();
-        deserialize(ser, "1", tmp);
-        t.local_spikes_[1].insert(tmp);
+        for (auto i: {0, 1}) {
+            std::vector<spike> tmp;
+            deserialize(ser, std::to_string(i), tmp);
+            auto& store = t.local_spikes_[i];
+            store.clear();
+            if (!tmp.empty()) store.set(0, tmp);
+        }
         ser.end_read_array();
     }
 
@@ -195,19 +210,22 @@ private:
 
     task_system_handle task_system_;
 
-    // Pending events to be delivered.
+    // Events received in the last exchange, to be filed into the calendars.
     std::vector<pse_vector> pending_events_;
+    // Events to be delivered in later epochs, one calendar per cell.
+    std::vector<event_calendar> event_calendars_;
+    // Events to be delivered in the current and next epoch.
     std::array<std::vector<pse_vector>, 2> event_lanes_;
 
-    // Spikes generated by local cell groups.
-    std::array<thread_private_spike_store, 2> local_spikes_;
+    // Spikes generated by local cell groups, one sorted buffer per group.
+    std::array<group_spike_store, 2> local_spikes_;
 
     // Sampler associations handles are managed by a helper class.
     util::handle_set<sampler_association_handle> sassoc_handles_;
 
     // Accessors to events
     std::vector<pse_vector>& event_lanes(std::ptrdiff_t epoch_id) { return event_lanes_[epoch_id&1]; }
-    thread_private_spike_store& local_spikes(std::ptrdiff_t epoch_id) { return local_spikes_[epoch_id&1]; }
+    group_spike_store& local_spikes(std::ptrdiff_t epoch_id) { return local_spikes_[epoch_id&1]; }
 
     // Apply a functional to each cell group in parallel.
     template <typename L>
@@ -235,13 +253,14 @@ simulation_state::simulation_state(
         const recipe& rec,
         const domain_decomposition& decomp,
         context ctx,
-        arb_seed_type seed
+        arb_seed_type seed,
+        const std::filesystem::path& connection_cache
     ):
     ctx_{ctx},
     ddc_{decomp},
     task_system_(ctx->thread_pool),
-    local_spikes_({thread_private_spike_store(ctx->thread_pool),
-                  thread_private_spike_store(ctx->thread_pool)}) {
+    local_spikes_({group_spike_store(decomp.num_groups(), ctx->thread_pool),
+                  group_spike_store(decomp.num_groups(), ctx->thread_pool)}) {
     // Generate the cell groups in parallel, with one task per cell group.
     auto num_groups = decomp.num_groups();
     cell_groups_.resize(num_groups);
@@ -269,30 +288,54 @@ simulation_state::simulation_state(
     }
     PL();
 
-    PE(init:simulation:source:MPI);
-    auto global_sources = ctx->distributed->gather_cell_labels_and_gids(local_sources);
+    PE(init:simulation:comm);
+    communicator_ = communicator(rec, ddc_, ctx_);
     PL();
 
+    std::optional<std::uint64_t> connectivity_key;
+    if (!connection_cache.empty()) {
+        connectivity_key = communicator_.connectivity_hash(rec, local_sources, local_targets);
+    }
+
     PE(init:simulation:resolvers);
-    source_resolution_map_ = label_resolution_map(std::move(global_sources));
+    local_sources_ = std::move(local_sources);
     target_resolution_map_ = label_resolution_map(std::move(local_targets));
     PL();
 
-    PE(init:simulation:comm);
-    communicator_ = communicator(rec, ddc_, ctx_);
-    PL();
-    update(rec);
+    if (connectivity_key) {
+        if (!communicator_.load_connections(connection_cache, *connectivity_key, ddc_)) {
+            communicator_.update_connections(rec, ddc_, local_sources_, target_resolution_map_);
+            communicator_.save_connections(connection_cache, *connectivity_key);
+        }
+        update_events(rec);
+    }
+    else {
+        update(rec);
+    }
     epoch_.reset();
 }
 
+void simulation_state::update_connections(const connection_delta& delta) {
+    communicator_.update_connections(delta, ddc_, local_sources_, target_resolution_map_);
+    t_interval_ = min_delay()/2;
+    for (auto& calendar: event_calendars_) calendar.set_width(t_interval_);
+}
+
 void simulation_state::update(const recipe& rec) {
-    communicator_.update_connections(rec, ddc_, source_resolution_map_, target_resolution_map_);
+    communicator_.update_connections(rec, ddc_, local_sources_, target_resolution_map_);
+    update_events(rec);
+}
+
+void simulation_state::update_events(const recipe& rec) {
     // Use half minimum delay of the network for max integration interval.
     t_interval_ = min_delay()/2;
 
     const auto num_local_cells = communicator_.num_local_cells();
     // Initialize empty buffers for pending events for each local cell
     pending_events_.resize(num_local_cells);
+    // Bucket future events by epoch.
+    event_calendars_.resize(num_local_cells);
+    for (auto& calendar: event_calendars_) calendar.set_width(t_interval_);
     // Forget old generators, if present
     event_generators_.clear();
     event_generators_.resize(num_local_cells);
@@ -345,6 +388,7 @@ void simulation_state::reset() {
     }
 
     for (auto& lane: pending_events_) lane.clear();
+    for (auto& calendar: event_calendars_) calendar.clear();
     for (auto& spikes: local_spikes_) spikes.clear();
 
     communicator_.reset();
@@ -414,7 +458,7 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
                 group->advance(current, dt, queues);
 
                 PE(advance:spikes);
-                local_spikes(current.id).insert(group->spikes());
+                local_spikes(current.id).set(i, group->spikes());
                 group->clear_spikes();
                 PL();
             });
@@ -443,13 +487,13 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
         PL();
     };
 
-    // Enqueue task: build event_lanes for next epoch from pending events, event-generator events for the
-    // next epoch, and with any unprocessed events from the current event_lanes.
+    // Enqueue task: file pending events into the per-cell event calendars, then build event_lanes for
+    // the next epoch from the calendar events now due and event-generator events for the next epoch.
     auto enqueue = [this](epoch next) {
         foreach_cell(
             [&](cell_size_type i) {
-                // NOTE Despite the superficial optics, we need to sort by the
-                // full key here and _not_ purely by time. With different
+                // NOTE Despite the superficial optics, the calendar needs to
+                // sort by the full key here and _not_ purely by time. With different
                 // parallel distributions, the ordering of events with the same
                 // time may change. Consider synapses like this
                 //
@@ -471,15 +515,18 @@ time_type simulation_state::run(time_type tfinal, time_type dt) {
                 // NET_RECEIVE (weight) {
                 //   state = state + 42
                 // }
+                // Events are filed once by delivery time, so events with long
+                // delays are not copied from lane to lane each epoch.
                 PE(communication:enqueue:sort);
-                util::sort(pending_events_[i]);
+                auto& calendar = event_calendars_[i];
+                auto& due = pending_events_[i];
+                calendar.insert(due);
+                due.clear();
+                calendar.take(next.t1, due);
                 PL();
 
-                event_span pending = util::range_pointer_view(pending_events_[i]);
-                event_span old_events = util::range_pointer_view(event_lanes(next.id-1)[i]);
-
-                merge_cell_events(next.t0, next.t1, old_events, pending, event_generators_[i], event_lanes(next.id)[i]);
-                pending_events_[i].clear();
+                merge_cell_events(next.t0, next.t1, {}, util::range_pointer_view(due), event_generators_[i], event_lanes(next.id)[i]);
+                due.clear();
             });
     };
 
@@ -567,9 +614,10 @@ simulation::simulation(
     const recipe& rec,
     context ctx,
     const domain_decomposition& decomp,
-    arb_seed_type seed)
+    arb_seed_type seed,
+    const std::filesystem::path& connection_cache)
 {
-    impl_.reset(new simulation_state(rec, decomp, ctx, seed));
+    impl_.reset(new simulation_state(rec, decomp, ctx, seed, connection_cache));
 }
 
 void simulation::reset() {
@@ -578,6 +626,8 @@ void simulation::reset() {
 
 void simulation::update(const recipe& rec) { impl_->update(rec); }
 
+void simulation::update_connections(const connection_delta& delta) { impl_->update_connections(delta); }
+
 time_type simulation::run(const units::quantity& tfinal, const units::quantity& dt) {
     auto dt_ms = dt.value_as(units::ms);
     if (dt_ms <= 0.0 || std::isnan(dt_ms)) throw domain_error("Finite time-step must be supplied.");
@@ -1,3 +1,10 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <Random123/threefry.h>
+#include <Random123/uniform.hpp>
+
 #include <arbor/arbexcept.hpp>
 #include <arbor/recipe.hpp>
 #include <arbor/spike_source_cell.hpp>
@@ -11,6 +18,43 @@
 
 namespace arb {
 
+poisson_train::poisson_train(cell_gid_type gid, const poisson_source& src):
+    gid(gid),
+    rate(src.rate.value_as(units::kHz)),
+    tstart(src.tstart.value_as(units::ms)),
+    tstop(src.tstop.value_as(units::ms)),
+    seed(src.seed)
+{
+    if (!std::isfinite(rate) || rate < 0) throw std::domain_error("Poisson source: rate must be >= 0, finite, and in [kHz]");
+    if (!std::isfinite(tstart) || tstart < 0) throw std::domain_error("Poisson source: start must be >= 0, finite, and in [ms]");
+    if (!std::isfinite(tstop) || tstop < tstart) throw std::domain_error("Poisson source: stop must be >= start, finite, and in [ms]");
+    reset();
+}
+
+void poisson_train::reset() {
+    count = 0;
+    next = tstart;
+    step();
+}
+
+void poisson_train::step() {
+    using cbrng = r123::Threefry2x64;
+
+    if (rate<=0) {
+        next = terminal_time;
+        return;
+    }
+
+    // Interval n is taken from word n%2 of the generator output for counter
+    // n/2, so the train depends only on (seed, gid) and not on how the
+    // intervals are drawn across epochs.
+    cbrng::ctr_type ctr = {{count/2, 0}};
+    cbrng::key_type key = {{seed, gid}};
+    auto r = cbrng{}(ctr, key);
+    next -= std::log(r123::u01<double>(r[count%2]))/rate;
+    ++count;
+}
+
 spike_source_cell_group::spike_source_cell_group(
     const std::vector<cell_gid_type>& gids,
     const recipe& rec,
@@ -25,12 +69,15 @@ spike_source_cell_group::spike_source_cell_group(
     }
 
     time_sequences_.reserve(gids.size());
-    for (auto gid: gids_) {
+    auto batch = batched_cell_descriptions(rec, gids_);
+    for (auto i: util::count_along(gids_)) {
+        const auto gid = gids_[i];
         cg_sources.add_cell();
         cg_targets.add_cell();
         try {
-            auto cell = util::any_cast<spike_source_cell>(rec.get_cell_description(gid));
+            auto cell = util::any_cast<spike_source_cell>(batch.empty()? rec.get_cell_description(gid): std::move(batch[i]));
             time_sequences_.emplace_back(cell.seqs);
+            for (const auto& src: cell.poisson) trains_.emplace_back(gid, src);
             cg_sources.add_label(hash_value(cell.source), {0, 1});
         }
         catch (std::bad_any_cast& e) {
@@ -56,6 +103,17 @@ void spike_source_cell_group::advance(epoch ep, time_type dt, const event_lane_s
         }
     }
 
+    // Generate the Poisson trains of all cells in one pass, straight into the
+    // spike buffer.
+    for (auto& p: trains_) {
+        if (ep.t0 >= p.tstop) continue;
+        const auto t1 = std::min(ep.t1, p.tstop);
+        while (p.next < ep.t0) p.step();
+        for (; p.next < t1; p.step()) {
+            spikes_.push_back({{p.gid, 0u}, p.next});
+        }
+    }
+
     PL();
 };
 
@@ -65,6 +123,9 @@ void spike_source_cell_group::reset() {
             s.reset();
         }
     }
+    for (auto& p: trains_) {
+        p.reset();
+    }
     clear_spikes();
 }
 
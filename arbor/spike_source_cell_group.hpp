@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include <arbor/export.hpp>
@@ -8,6 +9,7 @@
 #include <arbor/sampling.hpp>
 #include <arbor/schedule.hpp>
 #include <arbor/spike.hpp>
+#include <arbor/spike_source_cell.hpp>
 
 #include "cell_group.hpp"
 #include "epoch.hpp"
@@ -15,6 +17,28 @@
 
 namespace arb {
 
+// State of a Poisson train generated in bulk, see poisson_source.
+struct ARB_SYMBOL_VISIBLE poisson_train {
+    cell_gid_type gid = 0;
+    time_type rate = 0;       // [kHz]
+    time_type tstart = 0;     // [ms]
+    time_type tstop = 0;      // [ms]
+    std::uint64_t seed = 0;
+    std::uint64_t count = 0;  // Number of intervals drawn so far.
+    time_type next = 0;       // Time of the next spike [ms].
+
+    poisson_train() = default;
+    poisson_train(cell_gid_type gid, const poisson_source& src);
+
+    // Restart the train at tstart.
+    void reset();
+
+    // Draw the next interval.
+    void step();
+
+    ARB_SERDES_ENABLE(poisson_train, gid, rate, tstart, tstop, seed, count, next);
+};
+
 class ARB_ARBOR_API spike_source_cell_group: public cell_group {
 public:
     spike_source_cell_group(const std::vector<cell_gid_type>& gids, const recipe& rec, cell_label_range& cg_sources, cell_label_range& cg_targets);
@@ -35,7 +59,7 @@ public:
 
     void remove_all_samplers() override {}
 
-    ARB_SERDES_ENABLE(spike_source_cell_group, spikes_, gids_, time_sequences_);
+    ARB_SERDES_ENABLE(spike_source_cell_group, spikes_, gids_, time_sequences_, trains_);
 
     virtual void t_serialize(serializer& ser, const std::string& k) const override;
     virtual void t_deserialize(serializer& ser, const std::string& k) override;
@@ -44,6 +68,8 @@ private:
     std::vector<spike> spikes_;
     std::vector<cell_gid_type> gids_;
     std::vector<std::vector<schedule>> time_sequences_;
+    // Poisson trains of all cells.
+    std::vector<poisson_train> trains_;
 };
 
 } // namespace arb
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <arbor/symmetric_recipe.hpp>
 
 namespace arb {
@@ -35,6 +37,29 @@ std::vector<cell_connection> symmetric_recipe::connections_on(cell_gid_type i) c
     return conns;
 }
 
+std::vector<cell_tag_type> symmetric_recipe::connection_label_table() const {
+    return tiled_recipe_->connection_label_table();
+}
+
+// As connections_on, querying the tile once for each part of the range within one copy.
+connection_columns symmetric_recipe::connections_on_range(cell_gid_type gid_begin, cell_gid_type gid_end) const {
+    cell_gid_type n_local = tiled_recipe_->num_cells();
+    cell_gid_type n_global = num_cells();
+
+    connection_columns result;
+    for (auto begin = gid_begin; begin < gid_end;) {
+        auto offset = (begin / n_local) * n_local;
+        auto end = std::min(gid_end, offset + n_local);
+        auto first = result.size();
+        result.append(tiled_recipe_->connections_on_range(begin - offset, end - offset));
+        for (auto j = first; j < result.size(); ++j) {
+            result.source_gid[j] = (result.source_gid[j] + offset) % n_global;
+        }
+        begin = end;
+    }
+    return result;
+}
+
 std::vector<probe_info> symmetric_recipe::get_probes(cell_gid_type i) const {
     i %= tiled_recipe_->num_cells();
     return tiled_recipe_->get_probes(i);
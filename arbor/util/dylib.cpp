@@ -47,5 +47,13 @@ void* dl_get_symbol(const std::filesystem::path& fn, const std::string& symbol)
 }
 } // namespace impl
 
+std::filesystem::path dl_object_path(const void* addr) {
+    Dl_info info;
+    if (!dladdr(addr, &info) || !info.dli_fname) {
+        throw dl_error{"[POSIX] dl_object_path failed to locate address"};
+    }
+    return std::filesystem::absolute(info.dli_fname);
+}
+
 } // namespace util
 } // namespace arb
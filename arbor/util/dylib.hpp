@@ -23,5 +23,9 @@ T dl_get_symbol(const std::filesystem::path& filename, const std::string& symbol
     return reinterpret_cast<T>(impl::dl_get_symbol(filename.string(), symbol));
 }
 
+// Return the path of the binary object, i.e. shared library or executable,
+// holding the code or data at addr. Throws dl_error on error.
+std::filesystem::path dl_object_path(const void* addr);
+
 } // namespace util
 } // namespace arbor
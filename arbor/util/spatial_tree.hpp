@@ -1,21 +1,24 @@
 #pragma once
 
-#include "util/visit_variant.hpp"
-
 #include <arbor/common_types.hpp>
 #include <arbor/math.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <limits>
-#include <type_traits>
 #include <utility>
-#include <variant>
 #include <vector>
 
 namespace arb {
 
 // An immutable spatial data structure for storing and iterating over data in "DIM" dimensional
 // space. If DIM = 1 it's a binary tree, if DIM = 2 it's a quad tree and so on.
+//
+// All nodes are stored in one flat array, where the children of a node are stored contiguously.
+// Values are reordered such that each node covers a contiguous range of them. The coordinates of
+// the values are stored separately for each dimension, which allows for vectorized distance tests
+// in the leaves.
 template <typename T, std::size_t DIM>
 class spatial_tree {
 public:
@@ -23,114 +26,85 @@ public:
 
     using value_type = T;
     using point_type = std::array<double, DIM>;
-    using node_data = std::vector<spatial_tree>;
     using leaf_data = std::vector<T>;
     using location_func_type = point_type (*)(const T &);
 
-    spatial_tree(): size_(0), data_(leaf_data()) {}
+    // Bounds of leaf size of trees created for radius queries: leaves are filtered in a few
+    // vectorized iterations, while the number of nodes to traverse is kept low.
+    static constexpr std::size_t min_radius_leaf_size = 16;
+    static constexpr std::size_t max_radius_leaf_size = 256;
+
+    spatial_tree() = default;
 
     // Create a tree of given maximum depth and target leaf size. If any leaf holds more than the
-    // target size, it is recursively split into up to 2^DIM nodes until reaching the maximum depth.
+    // target size, it is recursively split into up to 2^DIM nodes until reaching the maximum depth
+    // or until the largest extent of the leaf is no greater than min_extent.
     // The "location" function type must have signature (const T&) -> point_type.
     spatial_tree(std::size_t max_depth,
         std::size_t leaf_size_target,
         leaf_data data,
-        location_func_type location):
-        size_(data.size()),
-        data_(std::move(data)),
-        location_(location) {
-        auto &leaf_d = std::get<leaf_data>(data_);
-        if (leaf_d.empty()) return;
-
-        min_.fill(std::numeric_limits<double>::max());
-        max_.fill(std::numeric_limits<double>::lowest());
+        location_func_type location,
+        double min_extent = 0.0) {
+        const auto n = data.size();
+        if (!n) return;
+
+        std::vector<point_type> points;
+        points.reserve(n);
+        for (const auto &d: data) points.emplace_back(location(d));
+
+        std::vector<std::size_t> perm(n);
+        for (std::size_t i = 0; i < n; ++i) perm[i] = i;
+
+        nodes_.push_back({{}, {}, 0, n, 0, 0});
+        split(0, max_depth, leaf_size_target, min_extent, points, perm);
+
+        values_.reserve(n);
+        for (auto &c: coords_) c.reserve(n);
+        for (auto i: perm) {
+            values_.emplace_back(std::move(data[i]));
+            for (std::size_t d = 0; d < DIM; ++d) coords_[d].push_back(points[i][d]);
+        }
+    }
 
-        for (const auto &d: leaf_d) {
+    // Create a tree tuned for queries with balls of the given radius. Depth and leaf size are chosen
+    // from the data: the target leaf size is the expected number of values within the bounding cube
+    // of a ball at average density, and nodes are not split below the radius.
+    static spatial_tree for_radius(double radius, leaf_data data, location_func_type location) {
+        // Limits the depth for degenerate input only, e.g. radius zero.
+        constexpr std::size_t max_depth = 32;
+
+        point_type min, max;
+        min.fill(std::numeric_limits<double>::max());
+        max.fill(std::numeric_limits<double>::lowest());
+        for (const auto &d: data) {
             const auto p = location(d);
             for (std::size_t i = 0; i < DIM; ++i) {
-                if (p[i] < min_[i]) min_[i] = p[i];
-                if (p[i] > max_[i]) max_[i] = p[i];
+                min[i] = std::min(min[i], p[i]);
+                max[i] = std::max(max[i], p[i]);
             }
         }
 
-        point_type mid;
-        for (std::size_t i = 0; i < DIM; ++i) { mid[i] = (max_[i] - min_[i]) / 2.0 + min_[i]; }
-
-        if (max_depth > 1 && leaf_d.size() > leaf_size_target) {
-            constexpr auto divisor = math::pow<std::size_t, std::size_t>(2, DIM);
-
-            // The initial index of the sub node containing p
-            auto sub_node_index = [&](const point_type &p) {
-                std::size_t index = 0;
-                for (std::size_t i = 0; i < DIM; ++i) { index += i * 2 * (p[i] >= mid[i]); }
-                return index;
-            };
-
-            node_data new_nodes;
-            new_nodes.reserve(divisor);
-
-            // assign each point to sub-node
-            std::array<leaf_data, divisor> new_leaf_data;
-            for (const auto &d: leaf_d) {
-                const auto p = location(d);
-                new_leaf_data[sub_node_index(p)].emplace_back(d);
-            }
-
-            // move data into new sub-nodes if not empty
-            for (auto &l_d: new_leaf_data) {
-                if (l_d.size())
-                    new_nodes.emplace_back(max_depth - 1, leaf_size_target, std::move(l_d), location);
-            }
-
-            // replace current data_ with new sub-nodes
-            this->data_ = std::move(new_nodes);
+        // fraction of the bounding box covered by the query, flat dimensions are ignored
+        double fraction = 1.0;
+        for (std::size_t i = 0; i < DIM && !data.empty(); ++i) {
+            const double extent = max[i] - min[i];
+            if (extent > 0.0) fraction *= std::min(1.0, 2.0 * radius / extent);
         }
-    }
+        const double expected = fraction * data.size();
+        const auto leaf_size = std::clamp<std::size_t>(
+            std::size_t(expected), min_radius_leaf_size, max_radius_leaf_size);
 
-    spatial_tree(const spatial_tree &) = default;
-
-    spatial_tree(spatial_tree &&t) noexcept(std::is_nothrow_move_assignable_v<spatial_tree>) {
-        *this = std::move(t);
+        return spatial_tree(max_depth, leaf_size, std::move(data), location, radius);
     }
 
-    spatial_tree &operator=(const spatial_tree &) = default;
-
-    spatial_tree &operator=(spatial_tree &&t) noexcept(
-        std::is_nothrow_default_constructible_v<point_type> &&
-        std::is_nothrow_move_assignable_v<point_type> &&
-        std::is_nothrow_default_constructible_v<leaf_data> &&
-        std::is_nothrow_move_assignable_v<decltype(this->data_)>) {
-
-        data_ = std::move(t.data_);
-        size_ = t.size_;
-        min_ = t.min_;
-        max_ = t.max_;
-        location_ = t.location_;
-
-        t.data_ = leaf_data();
-        t.size_ = 0;
-        t.min_ = point_type();
-        t.max_ = point_type();
-        t.location_ = nullptr;
-
-        return *this;
-    }
-
-    // Iterate over all points recursively.
+    // Iterate over all points.
     // func must have signature `void func(const T&)`.
     template <typename F>
     inline void for_each(const F &func) const {
-        util::visit_variant(
-            data_,
-            [&](const node_data &data) {
-                for (const auto &node: data) { node.for_each(func); }
-            },
-            [&](const leaf_data &data) {
-                for (const auto &d: data) { func(d); }
-            });
+        for (const auto &d: values_) func(d);
     }
 
-    // Iterate over all points within the given bounding box recursively.
+    // Iterate over all points within the given bounding box.
     // func must have signature `void func(const T&)`.
     template <typename F>
     inline void bounding_box_for_each(const point_type &box_min,
@@ -142,49 +116,185 @@ public:
             return result;
         };
 
-        util::visit_variant(
-            data_,
-            [&](const node_data &data) {
-                if (all_smaller_eq(box_min, min_) && all_smaller_eq(max_, box_max)) {
-                    // sub-nodes fully inside box -> call without further boundary
-                    // checks
-                    for (const auto &node: data) { node.template for_each<F>(func); }
-                }
-                else {
-                    // sub-nodes partially overlap bounding box
-                    for (const auto &node: data) {
-                        if (all_smaller_eq(node.min_, box_max) &&
-                            all_smaller_eq(box_min, node.max_))
-                            node.template bounding_box_for_each<F>(box_min, box_max, func);
+        traverse(
+            [&](const node &nd) {
+                if (!(all_smaller_eq(nd.min, box_max) && all_smaller_eq(box_min, nd.max)))
+                    return overlap::none;
+                if (all_smaller_eq(box_min, nd.min) && all_smaller_eq(nd.max, box_max))
+                    return overlap::full;
+                return overlap::partial;
+            },
+            [&](const node &nd) {
+                for (std::size_t i = nd.begin; i < nd.end; ++i) {
+                    bool inside = true;
+                    for (std::size_t d = 0; d < DIM; ++d) {
+                        inside &= box_min[d] <= coords_[d][i] && coords_[d][i] <= box_max[d];
                     }
+                    if (inside) func(values_[i]);
                 }
             },
-            [&](const leaf_data &data) {
-                if (all_smaller_eq(box_min, min_) && all_smaller_eq(max_, box_max)) {
-                    // sub-nodes fully inside box -> call without further boundary
-                    // checks
-                    for (const auto &d: data) { func(d); }
+            func);
+    }
+
+    // Iterate over all points with a distance of at most radius to center.
+    // func must have signature `void func(const T&)`.
+    template <typename F>
+    inline void radius_for_each(const point_type &center, double radius, const F &func) const {
+        const double r2 = radius * radius;
+
+        traverse(
+            [&](const node &nd) {
+                // squared distance to the closest and farthest point of the node box
+                double near2 = 0.0, far2 = 0.0;
+                for (std::size_t d = 0; d < DIM; ++d) {
+                    const double lo = nd.min[d] - center[d];
+                    const double hi = center[d] - nd.max[d];
+                    const double near = std::max({lo, hi, 0.0});
+                    const double far = std::max(-lo, -hi);
+                    near2 += near * near;
+                    far2 += far * far;
                 }
-                else {
-                    // sub-nodes partially overlap bounding box
-                    for (const auto &d: data) {
-                        const auto p = location_(d);
-                        if (all_smaller_eq(p, box_max) && all_smaller_eq(box_min, p)) { func(d); }
+                if (near2 > r2) return overlap::none;
+                if (far2 <= r2) return overlap::full;
+                return overlap::partial;
+            },
+            [&](const node &nd) {
+                constexpr std::size_t chunk = 64;
+                bool inside[chunk];
+                for (std::size_t b = nd.begin; b < nd.end; b += chunk) {
+                    const std::size_t e = std::min(b + chunk, nd.end);
+                    // no dependencies between iterations, vectorized by the compiler
+                    for (std::size_t i = b; i < e; ++i) {
+                        double dist2 = 0.0;
+                        for (std::size_t d = 0; d < DIM; ++d) {
+                            const double x = coords_[d][i] - center[d];
+                            dist2 += x * x;
+                        }
+                        inside[i - b] = dist2 <= r2;
+                    }
+                    for (std::size_t i = b; i < e; ++i) {
+                        if (inside[i - b]) func(values_[i]);
                     }
                 }
-            });
-
+            },
+            func);
     }
 
-    inline std::size_t size() const noexcept { return size_; }
+    inline std::size_t size() const noexcept { return values_.size(); }
 
-    inline bool empty() const noexcept { return !size_; }
+    inline bool empty() const noexcept { return values_.empty(); }
+
+    // Number of nodes including leaves.
+    inline std::size_t num_nodes() const noexcept { return nodes_.size(); }
 
 private:
-    std::size_t size_;
-    point_type min_, max_;
-    std::variant<node_data, leaf_data> data_;
-    location_func_type location_;
+    struct node {
+        point_type min, max;
+        std::size_t begin, end;                 // range of values covered by the node
+        std::size_t first_child, num_children;  // range of child nodes, empty for leaves
+    };
+
+    enum class overlap { none, partial, full };
+
+    std::vector<node> nodes_;
+    std::vector<T> values_;
+    std::array<std::vector<double>, DIM> coords_;
+
+    // Split node n, whose values are given by perm[begin, end) into up to 2^DIM children.
+    void split(std::size_t n,
+        std::size_t depth,
+        std::size_t leaf_size_target,
+        double min_extent,
+        const std::vector<point_type> &points,
+        std::vector<std::size_t> &perm) {
+        constexpr auto divisor = math::pow<std::size_t, std::size_t>(2, DIM);
+
+        const auto begin = nodes_[n].begin;
+        const auto end = nodes_[n].end;
+
+        point_type min, max;
+        min.fill(std::numeric_limits<double>::max());
+        max.fill(std::numeric_limits<double>::lowest());
+        for (auto i = begin; i < end; ++i) {
+            const auto &p = points[perm[i]];
+            for (std::size_t d = 0; d < DIM; ++d) {
+                min[d] = std::min(min[d], p[d]);
+                max[d] = std::max(max[d], p[d]);
+            }
+        }
+        nodes_[n].min = min;
+        nodes_[n].max = max;
+
+        double extent = 0.0;
+        for (std::size_t d = 0; d < DIM; ++d) extent = std::max(extent, max[d] - min[d]);
+
+        // A positive extent guarantees at least two non-empty children.
+        if (depth <= 1 || end - begin <= leaf_size_target || extent <= min_extent ||
+            extent <= 0.0)
+            return;
+
+        point_type mid;
+        for (std::size_t d = 0; d < DIM; ++d) { mid[d] = (max[d] - min[d]) / 2.0 + min[d]; }
+
+        // The index of the sub node containing p
+        auto sub_node_index = [&](const point_type &p) {
+            std::size_t index = 0;
+            for (std::size_t d = 0; d < DIM; ++d) { index |= std::size_t(p[d] >= mid[d]) << d; }
+            return index;
+        };
+
+        // counting sort of values into sub nodes
+        std::array<std::size_t, divisor + 1> offsets = {};
+        for (auto i = begin; i < end; ++i) ++offsets[sub_node_index(points[perm[i]]) + 1];
+        for (std::size_t c = 0; c < divisor; ++c) offsets[c + 1] += offsets[c];
+
+        std::vector<std::size_t> sorted(end - begin);
+        auto pos = offsets;
+        for (auto i = begin; i < end; ++i) sorted[pos[sub_node_index(points[perm[i]])]++] = perm[i];
+        std::copy(sorted.begin(), sorted.end(), perm.begin() + begin);
+
+        // children are stored contiguously, their own children are appended later
+        const auto first_child = nodes_.size();
+        for (std::size_t c = 0; c < divisor; ++c) {
+            if (offsets[c] == offsets[c + 1]) continue;
+            nodes_.push_back({{}, {}, begin + offsets[c], begin + offsets[c + 1], 0, 0});
+        }
+        const auto num_children = nodes_.size() - first_child;
+        nodes_[n].first_child = first_child;
+        nodes_[n].num_children = num_children;
+
+        for (std::size_t c = first_child; c < first_child + num_children; ++c) {
+            split(c, depth - 1, leaf_size_target, min_extent, points, perm);
+        }
+    }
+
+    // Depth first traversal. Nodes fully inside the query region are passed to func without further
+    // tests, leaves partially inside are passed to filter_leaf.
+    template <typename NodeTest, typename LeafFilter, typename F>
+    void traverse(const NodeTest &node_test, const LeafFilter &filter_leaf, const F &func) const {
+        if (nodes_.empty()) return;
+
+        std::vector<std::size_t> stack = {0};
+        while (!stack.empty()) {
+            const auto &nd = nodes_[stack.back()];
+            stack.pop_back();
+
+            switch (node_test(nd)) {
+            case overlap::none: break;
+            case overlap::full:
+                for (auto i = nd.begin; i < nd.end; ++i) func(values_[i]);
+                break;
+            case overlap::partial:
+                if (nd.num_children) {
+                    for (auto c = nd.first_child; c < nd.first_child + nd.num_children; ++c) {
+                        stack.push_back(c);
+                    }
+                }
+                else { filter_leaf(nd); }
+                break;
+            }
+        }
+    }
 };
 
 }  // namespace arb
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/morph/segment_tree.hpp>
+
+#include <arborio/export.hpp>
+
+namespace arborio {
+
+// Binary cache of segment trees, such that morphologies loaded once from text
+// formats can be restored without parsing, e.g.
+//
+//     auto tree = arborio::load_segment_tree("cell.arbmorph");
+//     auto morph = arb::morphology(tree);
+//
+// The segments are stored column by column in native byte order; files are
+// not portable between architectures. Files are memory mapped, and the tree is
+// built from the mapped columns in one go.
+
+// The data is not a segment tree cache of a supported version, is truncated, or
+// does not describe a valid tree.
+struct ARB_SYMBOL_VISIBLE segment_tree_cache_error: arb::arbor_exception {
+    explicit segment_tree_cache_error(const std::string& msg);
+};
+
+ARB_ARBORIO_API void write_segment_tree(std::ostream&, const arb::segment_tree&);
+ARB_ARBORIO_API arb::segment_tree read_segment_tree(std::istream&);
+
+ARB_ARBORIO_API void save_segment_tree(const std::filesystem::path&, const arb::segment_tree&);
+ARB_ARBORIO_API arb::segment_tree load_segment_tree(const std::filesystem::path&);
+
+// Load many caches in parallel on up to num_threads threads, or one per core if
+// zero. If loading fails, the exception for the first failing file in the list
+// is rethrown.
+ARB_ARBORIO_API std::vector<arb::segment_tree> load_segment_trees(const std::vector<std::filesystem::path>&, unsigned num_threads = 0);
+
+} // namespace arborio
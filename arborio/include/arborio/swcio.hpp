@@ -138,4 +138,10 @@ ARB_ARBORIO_API loaded_morphology load_swc_arbor(const std::filesystem::path& fn
 ARB_ARBORIO_API loaded_morphology load_swc_neuron(const swc_data& data);
 ARB_ARBORIO_API loaded_morphology load_swc_neuron(const std::filesystem::path& fn);
 
+// Load many SWC files in parallel on up to num_threads threads, or one per
+// core if zero. Files are memory mapped and parsed in place. If loading fails,
+// the exception for the first failing file in the list is rethrown.
+ARB_ARBORIO_API std::vector<loaded_morphology> load_swc_arbor_files(const std::vector<std::filesystem::path>& fns, unsigned num_threads = 0);
+ARB_ARBORIO_API std::vector<loaded_morphology> load_swc_neuron_files(const std::vector<std::filesystem::path>& fns, unsigned num_threads = 0);
+
 } // namespace arborio
@@ -0,0 +1,45 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <arbor/arbexcept.hpp>
+
+#include "mapped_file.hpp"
+
+namespace arborio {
+
+mapped_file::mapped_file(const std::filesystem::path& path, const std::string& what) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd<0) throw arb::file_not_found_error("unable to open " + what + ": " + path.string());
+
+    struct stat st;
+    if (::fstat(fd, &st)==0 && S_ISREG(st.st_mode) && st.st_size>0) {
+        void* map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map!=MAP_FAILED) {
+            map_ = map;
+            data_ = static_cast<const char*>(map);
+            size_ = st.st_size;
+        }
+    }
+    ::close(fd);
+    if (map_) return;
+
+    // Not mappable: fall back to reading the whole file.
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw arb::file_not_found_error("unable to open " + what + ": " + path.string());
+    buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+mapped_file::~mapped_file() {
+    if (map_) ::munmap(map_, size_);
+}
+
+} // namespace arborio
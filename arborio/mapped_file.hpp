@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace arborio {
+
+// Read-only view of the contents of a file. Regular files are memory mapped;
+// anything else, e.g. a pipe, is read into a buffer. Either way, the data is
+// aligned for any fundamental type.
+class mapped_file {
+public:
+    // Throws arb::file_not_found_error, naming the file as `what`, if the file
+    // can not be opened.
+    mapped_file(const std::filesystem::path& path, const std::string& what);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void* map_ = nullptr;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<char> buffer_;
+};
+
+// Apply load to each path on up to num_threads threads, or one per core if
+// zero. If any call throws, the exception for the first such path in order is
+// rethrown once all threads are done.
+template <typename T, typename F>
+std::vector<T> load_parallel(const std::vector<std::filesystem::path>& paths, unsigned num_threads, F&& load) {
+    const auto n = paths.size();
+    std::vector<T> result(n);
+    std::vector<std::exception_ptr> errors(n);
+
+    if (!num_threads) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = std::min<std::size_t>(num_threads, n);
+
+    auto work = [&](std::size_t first) {
+        for (auto i = first; i<n; i += num_threads) {
+            try {
+                result[i] = load(paths[i]);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t<num_threads; ++t) threads.emplace_back(work, t);
+    if (num_threads) work(0);
+    for (auto& t: threads) t.join();
+
+    for (auto& e: errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return result;
+}
+
+} // namespace arborio
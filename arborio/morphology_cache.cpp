@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#include <arbor/morph/primitives.hpp>
+#include <arbor/morph/segment_tree.hpp>
+
+#include <arborio/morphology_cache.hpp>
+
+#include "mapped_file.hpp"
+
+namespace arborio {
+
+segment_tree_cache_error::segment_tree_cache_error(const std::string& msg):
+    arb::arbor_exception("segment tree cache: " + msg)
+{}
+
+namespace {
+// Files consist of a header followed by the columns of the segments. Each part
+// starts at a multiple of the alignment, such that the file can also be memory
+// mapped.
+constexpr char cache_magic[8] = {'a', 'r', 'b', 'm', 'o', 'r', 'p', 'h'};
+constexpr std::uint32_t cache_version = 1;
+constexpr std::size_t cache_alignment = 64;
+
+struct cache_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t point_size;
+    std::uint64_t num_segments;
+};
+
+std::streamoff padding(std::streamoff pos) {
+    const std::streamoff alignment = cache_alignment;
+    return (alignment - pos%alignment)%alignment;
+}
+
+template <typename T>
+void write_section(std::ostream& out, const T* data, std::size_t n) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static constexpr char zeros[cache_alignment] = {};
+    out.write(reinterpret_cast<const char*>(data), n*sizeof(T));
+    out.write(zeros, padding(out.tellp()));
+}
+
+template <typename T>
+void read_section(std::istream& in, T* data, std::size_t n) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    in.read(reinterpret_cast<char*>(data), n*sizeof(T));
+    if (!in) throw segment_tree_cache_error("unexpected end of data");
+    in.seekg(padding(in.tellg()), std::ios::cur);
+}
+
+// View of the next section of n values in memory, advancing offset past it.
+template <typename T>
+const T* map_section(const char* data, std::size_t size, std::size_t& offset, std::size_t n) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (n > (size - offset)/sizeof(T)) throw segment_tree_cache_error("unexpected end of data");
+    auto section = reinterpret_cast<const T*>(data + offset);
+    offset += n*sizeof(T);
+    offset = std::min<std::size_t>(offset + padding(offset), size);
+    return section;
+}
+
+constexpr std::uint64_t segment_bytes = sizeof(arb::msize_t) + 2*sizeof(arb::mpoint) + sizeof(int);
+
+void check_header(const cache_header& header) {
+    if (std::memcmp(header.magic, cache_magic, sizeof header.magic)) {
+        throw segment_tree_cache_error("not a segment tree cache");
+    }
+    if (header.version != cache_version || header.point_size != sizeof(arb::mpoint)) {
+        throw segment_tree_cache_error("unsupported version " + std::to_string(header.version));
+    }
+}
+
+// Check the segment count against the data before allocating for it.
+void check_size(const cache_header& header, std::uint64_t left) {
+    if (header.num_segments > left/segment_bytes) {
+        throw segment_tree_cache_error("segment count " + std::to_string(header.num_segments) + " exceeds the data");
+    }
+}
+
+arb::segment_tree build_tree(std::size_t n, const arb::msize_t* parents, const arb::mpoint* prox, const arb::mpoint* dist, const int* tags) {
+    // Appending checks that parents precede their children.
+    arb::segment_tree tree;
+    try {
+        tree.append(n, parents, prox, dist, tags);
+    }
+    catch (arb::arbor_exception& e) {
+        throw segment_tree_cache_error(e.what());
+    }
+    return tree;
+}
+
+arb::segment_tree parse_segment_tree(const char* data, std::size_t size) {
+    std::size_t offset = 0;
+    const auto& header = *map_section<cache_header>(data, size, offset, 1);
+    check_header(header);
+    check_size(header, size - offset);
+
+    const std::size_t n = header.num_segments;
+    auto parents = map_section<arb::msize_t>(data, size, offset, n);
+    auto prox = map_section<arb::mpoint>(data, size, offset, n);
+    auto dist = map_section<arb::mpoint>(data, size, offset, n);
+    auto tags = map_section<int>(data, size, offset, n);
+    return build_tree(n, parents, prox, dist, tags);
+}
+
+// Number of bytes left in the stream, or -1 if the stream can not seek.
+std::streamoff remaining(std::istream& in) {
+    auto pos = in.tellg();
+    if (pos < 0 || !in.seekg(0, std::ios::end)) {
+        in.clear();
+        return -1;
+    }
+    auto end = in.tellg();
+    in.seekg(pos);
+    return end - pos;
+}
+} // namespace
+
+ARB_ARBORIO_API void write_segment_tree(std::ostream& out, const arb::segment_tree& tree) {
+    const auto n = tree.size();
+    std::vector<arb::mpoint> prox, dist;
+    std::vector<int> tags;
+    prox.reserve(n);
+    dist.reserve(n);
+    tags.reserve(n);
+    for (const auto& seg: tree.segments()) {
+        prox.push_back(seg.prox);
+        dist.push_back(seg.dist);
+        tags.push_back(seg.tag);
+    }
+
+    cache_header header = {};
+    std::memcpy(header.magic, cache_magic, sizeof header.magic);
+    header.version = cache_version;
+    header.point_size = sizeof(arb::mpoint);
+    header.num_segments = n;
+
+    write_section(out, &header, 1);
+    write_section(out, tree.parents().data(), n);
+    write_section(out, prox.data(), n);
+    write_section(out, dist.data(), n);
+    write_section(out, tags.data(), n);
+}
+
+ARB_ARBORIO_API arb::segment_tree read_segment_tree(std::istream& in) {
+    cache_header header;
+    read_section(in, &header, 1);
+    check_header(header);
+    if (auto left = remaining(in); left >= 0) check_size(header, left);
+
+    const std::size_t n = header.num_segments;
+    std::vector<arb::msize_t> parents(n);
+    std::vector<arb::mpoint> prox(n), dist(n);
+    std::vector<int> tags(n);
+    read_section(in, parents.data(), n);
+    read_section(in, prox.data(), n);
+    read_section(in, dist.data(), n);
+    read_section(in, tags.data(), n);
+    return build_tree(n, parents.data(), prox.data(), dist.data(), tags.data());
+}
+
+ARB_ARBORIO_API void save_segment_tree(const std::filesystem::path& path, const arb::segment_tree& tree) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    write_segment_tree(out, tree);
+    if (!out) throw arb::arbor_exception("unable to write segment tree cache: " + path.string());
+}
+
+ARB_ARBORIO_API arb::segment_tree load_segment_tree(const std::filesystem::path& path) {
+    mapped_file file(path, "segment tree cache");
+    return parse_segment_tree(file.data(), file.size());
+}
+
+ARB_ARBORIO_API std::vector<arb::segment_tree> load_segment_trees(const std::vector<std::filesystem::path>& paths, unsigned num_threads) {
+    return load_parallel<arb::segment_tree>(paths, num_threads, load_segment_tree);
+}
+
+} // namespace arborio
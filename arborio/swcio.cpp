@@ -1,14 +1,18 @@
+#include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
 #include <ios>
+#include <iterator>
 #include <limits>
+#include <locale>
 #include <numeric>
 #include <iostream>
+#include <optional>
 #include <set>
 #include <string>
 #include <sstream>
 #include <fstream>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include <arbor/morph/segment_tree.hpp>
@@ -18,6 +22,8 @@
 
 #include <arborio/swcio.hpp>
 
+#include "mapped_file.hpp"
+
 namespace arborio {
 
 // SWC exceptions:
@@ -66,29 +72,126 @@ ARB_ARBORIO_API std::ostream& operator<<(std::ostream& out, const swc_record& re
     return out;
 }
 
-ARB_ARBORIO_API std::istream& operator>>(std::istream& in, swc_record& record) {
-    std::string line;
-    if (!getline(in, line, '\n')) return in;
+// Fast parsing of record fields from a line of text. Numbers which can be
+// converted exactly are parsed by hand; anything else, e.g. 'inf' or very long
+// mantissas, falls back to stream extraction in the classic locale.
+
+namespace {
+bool is_blank(char c) { return c==' ' || c=='\t' || c=='\r'; }
+bool is_digit(char c) { return c>='0' && c<='9'; }
+
+const char* skip_blanks(const char* p, const char* end) {
+    while (p<end && is_blank(*p)) ++p;
+    return p;
+}
+
+template <typename T>
+const char* parse_with_stream(const char* p, const char* end, T& value) {
+    const char* token_end = p;
+    while (token_end<end && !is_blank(*token_end)) ++token_end;
+    std::istringstream s(std::string(p, token_end));
+    s.imbue(std::locale::classic());
+    T v;
+    if (!(s >> v)) return nullptr;
+    value = v;
+    return p + (s.eof()? token_end-p: std::streamoff(s.tellg()));
+}
+
+const char* parse_value(const char* p, const char* end, int& value) {
+    p = skip_blanks(p, end);
+    if (p<end && *p=='+') ++p;
+    auto [q, ec] = std::from_chars(p, end, value);
+    return ec==std::errc()? q: nullptr;
+}
+
+const char* parse_value(const char* p, const char* end, double& value) {
+    // Powers of ten that are exactly representable as double.
+    constexpr double exact_pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr std::uint64_t max_exact_mantissa = std::uint64_t(1)<<53;
+    constexpr int max_digits = 19;
+
+    p = skip_blanks(p, end);
+    const char* q = p;
+    bool negative = false;
+    if (q<end && (*q=='-' || *q=='+')) negative = *q++=='-';
+
+    std::uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool any_digits = false;
+    auto add_digit = [&](char c) {
+        mantissa = 10*mantissa + (c-'0');
+        digits += mantissa!=0;
+    };
+    for (; q<end && is_digit(*q) && digits<max_digits; ++q) {
+        add_digit(*q);
+        any_digits = true;
+    }
+    if (q<end && *q=='.') {
+        for (++q; q<end && is_digit(*q) && digits<max_digits; ++q) {
+            add_digit(*q);
+            --exponent;
+            any_digits = true;
+        }
+    }
+    if (q<end && (*q=='e' || *q=='E')) {
+        int e = 0;
+        const char* r = q+1;
+        if (r<end && *r=='+') ++r;
+        auto [after, ec] = std::from_chars(r, end, e);
+        if (ec!=std::errc()) return parse_with_stream(p, end, value);
+        exponent += e;
+        q = after;
+    }
+    // Too many digits, or not a decimal number at all.
+    if (!any_digits || (q<end && is_digit(*q))) return parse_with_stream(p, end, value);
+
+    // Both the mantissa and the power of ten are exact, hence the result is correctly rounded.
+    if (mantissa<=max_exact_mantissa && exponent>=-22 && exponent<=22) {
+        double v = exponent<0? mantissa/exact_pow10[-exponent]: mantissa*exact_pow10[exponent];
+        value = negative? -v: v;
+        return q;
+    }
+    return parse_with_stream(p, end, value);
+}
 
+// Parse the fields of a record from [p, end); trailing fields are ignored.
+bool parse_record(const char* p, const char* end, swc_record& record) {
     swc_record r;
-    std::istringstream s(line);
-    s >> r.id >> r.tag >> r.x >> r.y >> r.z >> r.r >> r.parent_id;
-    if (s) {
+    if ((p = parse_value(p, end, r.id))
+        && (p = parse_value(p, end, r.tag))
+        && (p = parse_value(p, end, r.x))
+        && (p = parse_value(p, end, r.y))
+        && (p = parse_value(p, end, r.z))
+        && (p = parse_value(p, end, r.r))
+        && (p = parse_value(p, end, r.parent_id))) {
         record = r;
+        return true;
     }
-    else {
+    return false;
+}
+
+// Read one line, reusing the line buffer.
+std::istream& read_record(std::istream& in, std::string& line, swc_record& record) {
+    if (!getline(in, line, '\n')) return in;
+    if (!parse_record(line.data(), line.data()+line.size(), record)) {
         in.setstate(std::ios_base::failbit);
     }
-
     return in;
 }
+} // namespace
+
+ARB_ARBORIO_API std::istream& operator>>(std::istream& in, swc_record& record) {
+    std::string line;
+    return read_record(in, line, record);
+}
 
 // Parse SWC format data (comments and sequence of SWC records).
 
 static std::vector<swc_record> sort_and_validate_swc(std::vector<swc_record> records) {
     if (records.empty()) return {};
 
-    std::unordered_set<int> seen;
     std::size_t n_rec = records.size();
 
     for (std::size_t i = 0; i<n_rec; ++i) {
@@ -97,17 +200,30 @@ static std::vector<swc_record> sort_and_validate_swc(std::vector<swc_record> rec
         if (r.parent_id>=r.id) {
             throw swc_record_precedes_parent(r.id);
         }
+    }
 
-        if (!seen.insert(r.id).second) {
-            throw swc_duplicate_record_id(r.id);
-        }
+    auto by_id = [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; };
+    // Records are usually stored in order already.
+    if (!std::is_sorted(records.begin(), records.end(), by_id)) {
+        std::stable_sort(records.begin(), records.end(), by_id);
     }
 
-    std::sort(records.begin(), records.end(), [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; });
+    for (std::size_t i = 1; i<n_rec; ++i) {
+        if (records[i].id==records[i-1].id) {
+            throw swc_duplicate_record_id(records[i].id);
+        }
+    }
 
+    // Parents precede their children, so only earlier records need to be searched.
     for (std::size_t i = 0; i<n_rec; ++i) {
         const swc_record& r = records[i];
-        if ((i==0 && r.parent_id!=-1) || (i>0 && !seen.count(r.parent_id))) {
+        if (i==0) {
+            if (r.parent_id!=-1) throw swc_no_such_parent(r.id);
+            continue;
+        }
+        const auto first = records.begin(), last = first+i;
+        auto it = std::lower_bound(first, last, r.parent_id, [](const auto& rec, int id) { return rec.id<id; });
+        if (it==last || it->id!=r.parent_id) {
             throw swc_no_such_parent(r.id);
         }
     }
@@ -150,16 +266,41 @@ ARB_ARBORIO_API swc_data parse_swc(std::istream& in) {
     }
 
     swc_record r;
-    while (in && (in.peek() != '\n') && in >> r) {
+    while (in && (in.peek() != '\n') && read_record(in, line, r)) {
+        records.push_back(r);
+    }
+
+    return swc_data(metadata, std::move(records));
+}
+
+// As above, but parsing directly from the text without a stream.
+static swc_data parse_swc_text(const char* p, const char* end) {
+    std::string metadata;
+    std::vector<swc_record> records;
+
+    auto line_end = [end](const char* p) { return std::find(p, end, '\n'); };
+
+    for (; p<end && *p=='#'; ) {
+        auto eol = line_end(p);
+        auto from = std::find_if(p+1, eol, [](char c) { return c!=' ' && c!='\t'; });
+        metadata.append(from, eol);
+        metadata += '\n';
+        p = eol==end? end: eol+1;
+    }
+
+    swc_record r;
+    for (; p<end && *p!='\n'; ) {
+        auto eol = line_end(p);
+        if (!parse_record(p, eol, r)) break;
         records.push_back(r);
+        p = eol==end? end: eol+1;
     }
 
     return swc_data(metadata, std::move(records));
 }
 
 ARB_ARBORIO_API swc_data parse_swc(const std::string& text) {
-    std::istringstream is(text);
-    return parse_swc(is);
+    return parse_swc_text(text.data(), text.data()+text.size());
 }
 
 arb::segment_tree load_swc_arbor_raw(const swc_data& data) {
@@ -172,8 +313,12 @@ arb::segment_tree load_swc_arbor_raw(const swc_data& data) {
     std::size_t n_seg = records.size()-1;
     tree.reserve(n_seg);
 
-    std::unordered_map<int, std::size_t> id_to_index;
-    id_to_index[records[0].id] = 0;
+    // Records are sorted by id, see swc_data.
+    auto index_of = [&records](int id, std::size_t before) {
+        const auto first = records.begin(), last = first+before;
+        auto it = std::lower_bound(first, last, id, [](const auto& rec, int id) { return rec.id<id; });
+        return it!=last && it->id==id? std::optional<std::size_t>(it-first): std::nullopt;
+    };
 
     // Check whether the first sample has at least one child with the same tag
     bool first_tag_match = false;
@@ -185,9 +330,9 @@ arb::segment_tree load_swc_arbor_raw(const swc_data& data) {
         const auto& dist = records[i];
         first_tag_match |= dist.parent_id==first_id && dist.tag==first_tag;
 
-        auto iter = id_to_index.find(dist.parent_id);
-        if (iter==id_to_index.end()) throw swc_no_such_parent{dist.id};
-        auto parent_idx = iter->second;
+        auto parent = index_of(dist.parent_id, i);
+        if (!parent) throw swc_no_such_parent{dist.id};
+        auto parent_idx = *parent;
 
         const auto& prox = records[parent_idx];
         arb::msize_t seg_parent = parent_idx? parent_idx-1: arb::mnpos;
@@ -196,8 +341,6 @@ arb::segment_tree load_swc_arbor_raw(const swc_data& data) {
             arb::mpoint{prox.x, prox.y, prox.z, prox.r},
             arb::mpoint{dist.x, dist.y, dist.z, dist.r},
             dist.tag);
-
-        id_to_index[dist.id] = i;
     }
 
     if (!first_tag_match) {
@@ -230,20 +373,22 @@ arb::segment_tree load_swc_neuron_raw(const swc_data& data) {
         return load_swc_arbor_raw(data);
     }
 
-    // Make a copy of the records and canonicalise them.
+    // Make a copy of the records and canonicalise them. Records are sorted by
+    // id, so parents are found by binary search among the preceding records.
     auto records = data.records();
-    std::unordered_map<int, int> record_index = {{-1, -1}};
     std::vector<int> old_record_index(n_samples);
 
     for (std::size_t i=0; i<n_samples; ++i) {
         auto& r = records[i];
-        record_index[r.id] = i;
         old_record_index[i] = r.id;
         r.id = i;
-        if (!record_index.count(r.parent_id)) {
+        if (r.parent_id==-1) continue;
+        const auto first = old_record_index.begin(), last = first+i;
+        auto it = std::lower_bound(first, last, r.parent_id);
+        if (it==last || *it!=r.parent_id) {
             throw swc_no_such_parent(r.parent_id);
         }
-        r.parent_id = record_index[r.parent_id];
+        r.parent_id = it-first;
     }
 
     // Calculate meta-data
@@ -280,7 +425,7 @@ arb::segment_tree load_swc_neuron_raw(const swc_data& data) {
     // single-sample sub-trees, which should be rare.
     tree.reserve(n_samples+spherical_soma);
 
-    std::unordered_map<int, arb::msize_t> segmap;
+    std::vector<arb::msize_t> segmap(n_samples, arb::mnpos);
 
     // Construct a soma composed of two cylinders if is represented by a single sample.
     if (spherical_soma) {
@@ -306,20 +451,20 @@ arb::segment_tree load_swc_neuron_raw(const swc_data& data) {
 
         // Constructing a segment inside the soma or a sub-tree.
         if (tag==p.tag) {
-            segmap[i] = tree.append(segmap.at(pid), {p.x, p.y, p.z, p.r}, {r.x, r.y, r.z, r.r}, tag);
+            segmap[i] = tree.append(segmap[pid], {p.x, p.y, p.z, p.r}, {r.x, r.y, r.z, r.r}, tag);
         }
         // The start of a sub-tree.
         else if (child_count[i]) {
             // Do not create a segment, instead set up the segmap so that the
             // first segment in the sub-tree will be connected to the soma with
             // a "zero resistance cable".
-            segmap[i] = segmap.at(pid);
+            segmap[i] = segmap[pid];
         }
         // Sub-tree defined with a single sample.
         else {
             // The sub-tree is composed of a single segment connecting the soma
             // to the sample, with constant radius defined by the sample.
-            segmap[i] = tree.append(segmap.at(pid), {p.x, p.y, p.z, r.r}, {r.x, r.y, r.z, r.r}, tag);
+            segmap[i] = tree.append(segmap[pid], {p.x, p.y, p.z, r.r}, {r.x, r.y, r.z, r.r}, tag);
         }
     }
 
@@ -338,16 +483,28 @@ ARB_ARBORIO_API loaded_morphology load_swc_arbor(const swc_data& data) {
     return {raw, {raw}, ld, swc_metadata{}};
 }
 
+// Parse the file in place from a memory mapping.
+static swc_data parse_swc_file(const std::filesystem::path& path) {
+    mapped_file file(path, "SWC file");
+    return parse_swc_text(file.data(), file.data()+file.size());
+}
+
 ARB_ARBORIO_API loaded_morphology load_swc_arbor(const std::filesystem::path& path) {
-    std::ifstream fd(path);
-    if (!fd) throw arb::file_not_found_error("unable to open SWC file: "+path.string());
-    return load_swc_arbor(parse_swc(fd));
+    return load_swc_arbor(parse_swc_file(path));
 }
 
 ARB_ARBORIO_API loaded_morphology load_swc_neuron(const std::filesystem::path& path) {
-    std::ifstream fd(path);
-    if (!fd) throw arb::file_not_found_error("unable to open SWC file: "+path.string());
-    return load_swc_neuron(parse_swc(fd));
+    return load_swc_neuron(parse_swc_file(path));
+}
+
+ARB_ARBORIO_API std::vector<loaded_morphology> load_swc_arbor_files(const std::vector<std::filesystem::path>& paths, unsigned num_threads) {
+    return load_parallel<loaded_morphology>(paths, num_threads,
+        [](const std::filesystem::path& p) { return load_swc_arbor(p); });
+}
+
+ARB_ARBORIO_API std::vector<loaded_morphology> load_swc_neuron_files(const std::vector<std::filesystem::path>& paths, unsigned num_threads) {
+    return load_parallel<loaded_morphology>(paths, num_threads,
+        [](const std::filesystem::path& p) { return load_swc_neuron(p); });
 }
 
 } // namespace arborio
@@ -41,6 +41,8 @@ struct run_params {
     unsigned num_ranks = 1;
     double min_delay = 10;
     double duration = 100;
+    // If positive, the firing rate [Hz] of the cells on mimicked ranks.
+    double rate = 0;
     cell_parameters cell;
     bool defaulted = true;
 };
@@ -136,7 +138,9 @@ int main(int argc, char** argv) {
         auto ctx = arb::make_context(resources);
 
         if (params.dry_run) {
-            ctx = arb::make_context(resources, arb::dry_run_info(params.num_ranks, params.num_cells_per_rank));
+            arb::dry_run_info info(params.num_ranks, params.num_cells_per_rank);
+            if (params.rate>0) info.rate = [rate = params.rate](cell_gid_type) { return rate; };
+            ctx = arb::make_context(resources, info);
         }
 #ifdef ARB_MPI_ENABLED
         else {
@@ -200,6 +204,14 @@ int main(int argc, char** argv) {
         std::cout << "\n" << ns << " spikes generated at rate of "
                   << params.duration/ns << " ms between spikes\n\n";
 
+        if (params.dry_run) {
+            auto report = arb::dry_run_statistics(ctx);
+            std::cout << "projected spike exchange: " << report.num_exchanges << " exchanges, "
+                      << report.num_spikes << " spikes, "
+                      << report.exchange_time << " s total, "
+                      << report.max_exchange_time << " s max\n\n";
+        }
+
         // Write spikes to file
         if (root) {
             std::ofstream fid("spikes.gdf");
@@ -286,6 +298,7 @@ run_params read_options(int argc, char** argv) {
     param_from_json(params.num_ranks, "num-ranks", json);
     param_from_json(params.duration, "duration", json);
     param_from_json(params.min_delay, "min-delay", json);
+    param_from_json(params.rate, "rate", json);
     params.cell = parse_cell_parameters(json);
 
     if (!json.empty()) {
@@ -113,6 +113,15 @@ enum class solverVariant {
     steadystate
 };
 
+// Nonlinear sparse systems are solved by a fixed number of Newton iterations.
+// With `reuse_jacobian`, the Jacobian is evaluated and reduced once at the
+// initial state, and each iteration only updates the residual (simplified
+// Newton's method).
+struct NewtonSpec {
+    unsigned iterations = 3;
+    bool reuse_jacobian = false;
+};
+
 static std::string to_string(solverMethod m) {
     switch (m) {
         case solverMethod::cnexp:      return std::string("cnexp");
@@ -1191,6 +1200,24 @@ public:
     void accept(Visitor *v) override;
 };
 
+/// describes a TABLE statement: a FUNCTION of one argument is sampled at
+/// n+1 equidistant points on [from, to] and evaluated by linear interpolation,
+/// arguments outside the range are clamped to it.
+/// Functions of constants are sampled by the compiler; functions of global
+/// parameters are sampled when the mechanism is initialised.
+struct TableSpec {
+    Location location;
+    std::vector<std::string> variables; ///< tabulated variables of a PROCEDURE
+    std::vector<std::string> depend; ///< DEPEND list, informative only
+    double from = 0;
+    double to = 0;
+    unsigned n = 0;
+    bool automatic = false;          ///< requested by the compiler, not a TABLE statement
+    std::vector<double> values;      ///< n+1 samples, empty until tabulated
+    bool runtime = false;            ///< sampled by init into the mechanism's table storage
+    unsigned offset = 0;             ///< start of a run-time table in the table storage
+};
+
 class ARB_LIBMODCC_API FunctionExpression : public Symbol {
 public:
     FunctionExpression( Location loc,
@@ -1226,6 +1253,18 @@ public:
         body_ = std::move(new_body);
     }
 
+    /// TABLE specification, nullptr if there is none
+    TableSpec* table() {
+        return table_.n? &table_: nullptr;
+    }
+    void table(TableSpec t) {
+        table_ = std::move(t);
+    }
+    /// calls are replaced by table lookups
+    bool is_tabulated() const {
+        return !table_.values.empty() || table_.runtime;
+    }
+
     FunctionExpression* is_function() override {return this;}
     using Expression::semantic;
     void semantic(scope_type::symbol_map&) override;
@@ -1237,6 +1276,7 @@ private:
 
     std::vector<expression_ptr> args_;
     expression_ptr body_;
+    TableSpec table_;
 };
 
 ////////////////////////////////////////////////////////////
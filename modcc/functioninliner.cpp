@@ -3,6 +3,7 @@
 #include "astmanip.hpp"
 #include "error.hpp"
 #include "functioninliner.hpp"
+#include "functiontable.hpp"
 #include "errorvisitor.hpp"
 #include "symdiff.hpp"
 
@@ -141,7 +142,9 @@ void FunctionInliner::visit(AssignmentExpression* e) {
     // an Assignment Expression.
     // If we find a new function to inline, we can do so, provided we aren't already inlining
     // another function and we haven't inlined a function already.
-    if (!inlining_in_progress_ && !inlining_executed_ && e->rhs()->is_function_call()) {
+    // Calls to tabulated functions are kept and printed as table lookups.
+    if (!inlining_in_progress_ && !inlining_executed_ && e->rhs()->is_function_call() &&
+        !is_table_lookup(e->rhs()->is_function_call())) {
         auto f = e->rhs()->is_function_call();
         auto& fargs = f->function()->args();
         auto& cargs = f->args();
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+#include <arbor/math.hpp>
+
+#include "functiontable.hpp"
+#include "visitor.hpp"
+
+namespace {
+
+struct table_error {
+    std::string what;
+};
+
+// Evaluate a function body for a given value of its argument. Only local
+// variables and the argument may be referenced; anything else throws a
+// table_error.
+class TableEvaluator: public Visitor {
+public:
+    using Visitor::visit;
+
+    TableEvaluator(std::string arg, double x) {
+        env_[std::move(arg)] = x;
+    }
+
+    double value(const std::string& name) const {
+        auto it = env_.find(name);
+        if (it == env_.end()) throw table_error{"the return value is not set"};
+        return it->second;
+    }
+
+    void visit(Expression* e) override {
+        throw table_error{"unsupported statement '" + e->to_string() + "'"};
+    }
+
+    void visit(BlockExpression* e) override {
+        for (auto& s: e->statements()) s->accept(this);
+    }
+
+    void visit(LocalDeclaration*) override {}
+
+    void visit(NumberExpression* e) override {
+        value_ = e->value();
+    }
+
+    void visit(IdentifierExpression* e) override {
+        auto it = env_.find(local_name(e));
+        if (it == env_.end()) throw table_error{"'" + e->spelling() + "' is used before it is set"};
+        value_ = it->second;
+    }
+
+    void visit(IfExpression* e) override {
+        e->condition()->accept(this);
+        if (value_ != 0) {
+            e->true_branch()->accept(this);
+        }
+        else if (e->false_branch()) {
+            e->false_branch()->accept(this);
+        }
+    }
+
+    void visit(AssignmentExpression* e) override {
+        auto lhs = e->lhs()->is_identifier();
+        if (!lhs) throw table_error{"unsupported assignment '" + e->to_string() + "'"};
+        e->rhs()->accept(this);
+        env_[local_name(lhs)] = value_;
+    }
+
+    void visit(UnaryExpression* e) override {
+        e->expression()->accept(this);
+        auto x = value_;
+        switch (e->op()) {
+        case tok::minus:      value_ = -x; break;
+        case tok::exp:        value_ = std::exp(x); break;
+        case tok::sin:        value_ = std::sin(x); break;
+        case tok::cos:        value_ = std::cos(x); break;
+        case tok::log:        value_ = std::log(x); break;
+        case tok::abs:        value_ = std::abs(x); break;
+        case tok::sqrt:       value_ = std::sqrt(x); break;
+        case tok::exprelr:    value_ = arb::math::exprelr(x); break;
+        case tok::safeinv:    value_ = arb::math::safeinv(x); break;
+        case tok::step_right: value_ = x >= 0.; break;
+        case tok::step_left:  value_ = x > 0.; break;
+        case tok::step:       value_ = 0.5*((0. < x) - (x < 0.) + 1); break;
+        case tok::signum:     value_ = (0. < x) - (x < 0.); break;
+        case tok::tanh:       value_ = std::tanh(x); break;
+        case tok::sigmoid:    value_ = 1.0/(1.0 + std::exp(-x)); break;
+        case tok::relu:       value_ = std::max(0.0, x); break;
+        default:
+            throw table_error{"unsupported operator in '" + e->to_string() + "'"};
+        }
+    }
+
+    void visit(BinaryExpression* e) override {
+        e->lhs()->accept(this);
+        auto x = value_;
+        e->rhs()->accept(this);
+        auto y = value_;
+        switch (e->op()) {
+        case tok::plus:     value_ = x + y; break;
+        case tok::minus:    value_ = x - y; break;
+        case tok::times:    value_ = x*y; break;
+        case tok::divide:   value_ = x/y; break;
+        case tok::pow:      value_ = std::pow(x, y); break;
+        case tok::min:      value_ = std::min(x, y); break;
+        case tok::max:      value_ = std::max(x, y); break;
+        case tok::lt:       value_ = x < y; break;
+        case tok::lte:      value_ = x <= y; break;
+        case tok::gt:       value_ = x > y; break;
+        case tok::gte:      value_ = x >= y; break;
+        case tok::equality: value_ = x == y; break;
+        case tok::ne:       value_ = x != y; break;
+        case tok::land:     value_ = x && y; break;
+        case tok::lor:      value_ = x || y; break;
+        default:
+            throw table_error{"unsupported operator in '" + e->to_string() + "'"};
+        }
+    }
+
+private:
+    std::unordered_map<std::string, double> env_;
+    double value_ = 0;
+
+    // Every variable must be local to the function, including its argument
+    // and return value.
+    static std::string local_name(IdentifierExpression* e) {
+        auto s = e->symbol();
+        if (!s || s->kind() != symbolKind::local_variable) {
+            throw table_error{"it depends on '" + e->spelling() + "'"};
+        }
+        return e->spelling();
+    }
+};
+
+// Check all identifiers, including those in branches that are never taken at
+// the sample points, and record whether the function depends on global
+// parameters, which are only known when the mechanism is instantiated.
+class DependencyFinder: public Visitor {
+public:
+    using Visitor::visit;
+
+    bool globals = false;
+
+    void visit(Expression* e) override {}
+
+    void visit(BlockExpression* e) override {
+        for (auto& s: e->statements()) s->accept(this);
+    }
+
+    void visit(IfExpression* e) override {
+        e->condition()->accept(this);
+        e->true_branch()->accept(this);
+        if (e->false_branch()) e->false_branch()->accept(this);
+    }
+
+    void visit(UnaryExpression* e) override {
+        e->expression()->accept(this);
+    }
+
+    void visit(BinaryExpression* e) override {
+        e->lhs()->accept(this);
+        e->rhs()->accept(this);
+    }
+
+    void visit(CallExpression* e) override {
+        throw table_error{"it calls '" + e->name() + "'"};
+    }
+
+    void visit(IdentifierExpression* e) override {
+        auto s = e->symbol();
+        if (s && s->kind() == symbolKind::local_variable) return;
+
+        // Global parameters are fixed once the mechanism is instantiated;
+        // the time step is not.
+        auto v = s? s->is_variable(): nullptr;
+        if (v && v->is_scalar() && !v->is_writeable() && v->name() != "dt") {
+            globals = true;
+            return;
+        }
+        throw table_error{"it depends on '" + e->spelling() + "'"};
+    }
+};
+
+} // namespace
+
+ARB_LIBMODCC_API std::string tabulate_function(FunctionExpression* f) {
+    auto table = f->table();
+    if (!table) return "it has no TABLE statement";
+    if (f->args().size() != 1) return "it does not have exactly one argument";
+
+    auto arg = f->args().front()->is_argument()->spelling();
+    std::vector<double> values;
+    try {
+        DependencyFinder deps;
+        f->body()->accept(&deps);
+        if (deps.globals) {
+            table->runtime = true;
+            return {};
+        }
+
+        const unsigned n = table->n;
+        const double dx = (table->to - table->from)/n;
+        for (unsigned i = 0; i <= n; ++i) {
+            double x = i==n? table->to: table->from + i*dx;
+            TableEvaluator eval(arg, x);
+            f->body()->accept(&eval);
+            double y = eval.value(f->name());
+            if (!std::isfinite(y)) {
+                throw table_error{pprintf("its value at % is not finite", x)};
+            }
+            values.push_back(y);
+        }
+    }
+    catch (table_error& e) {
+        return e.what;
+    }
+
+    table->values = std::move(values);
+    return {};
+}
+
+ARB_LIBMODCC_API bool is_table_lookup(CallExpression* e) {
+    auto f = e->is_function_call()? e->function(): nullptr;
+    if (!f || !f->is_tabulated()) return false;
+    if (!f->table()->automatic) return true;
+
+    auto id = e->args().front()->is_identifier();
+    return id && id->spelling() == "v";
+}
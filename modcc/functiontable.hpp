@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "expression.hpp"
+#include <libmodcc/export.hpp>
+
+// Sample a FUNCTION of one argument at the points given by its TABLE
+// specification, storing the values in the specification.
+// The function body must depend on its argument and constants only, and
+// all calls must have been inlined. Functions that also depend on global
+// parameters are marked to be sampled at run time instead.
+// Returns an empty string on success, or the reason why the function can't
+// be tabulated, in which case it is left untouched.
+ARB_LIBMODCC_API std::string tabulate_function(FunctionExpression* f);
+
+// Calls to tabulated functions are not inlined but evaluated by table lookup.
+// Automatic tables are only used for calls with the membrane potential `v`
+// as argument.
+ARB_LIBMODCC_API bool is_table_lookup(CallExpression* e);
+
+// Name of the generated lookup function for the tabulated function f.
+inline std::string table_lookup_name(const std::string& f) {
+    return f + "_table_";
+}
@@ -7,6 +7,8 @@
 
 #include <tinyopt/tinyopt.h>
 
+#include <arbor/version.hpp>
+
 #include "printer/cprinter.hpp"
 #include "printer/gpuprinter.hpp"
 #include "printer/infoprinter.hpp"
@@ -78,6 +80,8 @@ struct Options {
     bool verbose = false;
     bool analysis = false;
     std::unordered_set<targetKind> targets;
+    TableSpec tabulate;
+    NewtonSpec newton;
 };
 
 // Helper for formatting tabulated output (option reporting).
@@ -105,7 +109,13 @@ std::ostream& operator<<(std::ostream& out, const Options& opt) {
     out << table_prefix{"output"}   << (opt.outprefix.empty() ? "-" : opt.outprefix) << line_end
         << table_prefix{"verbose"}  << noyes[opt.verbose] << line_end
         << table_prefix{"targets"}  << targets << line_end
-        << table_prefix{"analysis"} << noyes[opt.analysis] << line_end;
+        << table_prefix{"analysis"} << noyes[opt.analysis] << line_end
+        << table_prefix{"newton iterations"} << opt.newton.iterations << line_end
+        << table_prefix{"reuse jacobian"} << noyes[opt.newton.reuse_jacobian] << line_end;
+    if (opt.tabulate.n) {
+        out << table_prefix{"tabulate"}
+            << fmt::format("{}:{}:{}", opt.tabulate.from, opt.tabulate.to, opt.tabulate.n) << line_end;
+    }
     return out;
 }
 
@@ -132,6 +142,18 @@ std::istream& operator>> (std::istream& i, simd_spec& spec) {
     return i;
 }
 
+// Default table for one-argument FUNCTIONs as FROM:TO:N, e.g. '-100:100:200'.
+std::istream& operator>> (std::istream& i, TableSpec& spec) {
+    char sep1 = 0, sep2 = 0;
+    long n = 0;
+    i >> spec.from >> sep1 >> spec.to >> sep2 >> n;
+    if (sep1!=':' || sep2!=':' || n<1 || !(spec.from<spec.to)) {
+        i.setstate(std::ios::failbit);
+    }
+    spec.n = n;
+    return i;
+}
+
 const char* usage_str =
         "\n"
         "-o|--output            [Prefix for output file names]\n"
@@ -143,6 +165,10 @@ const char* usage_str =
         "-A|--analyse           [Toggle analysis mode]\n"
         "-r|--raw               [Add raw (CXX) mechanisms]\n"
         "-T|--trace-codegen     [Leave trace marks in generated source]\n"
+        "--version              [Print the version and exit]\n"
+        "--tabulate             [Tabulate one-argument FUNCTIONs of the membrane potential without a TABLE statement, given as FROM:TO:N, e.g. '-100:100:200']\n"
+        "--newton-iterations    [Number of Newton iterations for nonlinear sparse systems; default 3]\n"
+        "--reuse-jacobian       [Reduce the Jacobian of nonlinear sparse systems once per step and reuse it in every Newton iteration]\n"
         "<filenames>            [Files to be compiled]\n";
 
 int main(int argc, char **argv) {
@@ -163,6 +189,10 @@ int main(int argc, char **argv) {
 
         auto add_target = [&opt](targetKind t) { opt.targets.insert(t); };
 
+        auto version = [] {
+            std::cout << "modcc " << ARB_VERSION << " (" << ARB_SOURCE_ID << ")\n";
+        };
+
         to::option options[] = {
                 { to::push_back(opt.modfiles)},
                 { opt.outprefix,                                         "-o", "--output-dir" },
@@ -173,8 +203,12 @@ int main(int argc, char **argv) {
                 { to::action(enable_simd), to::flag,                     "-s", "--simd" },
                 { popt.simd,                                             "-S", "--simd-abi" },
                 { to::set(popt.trace_codegen), to::flag,                 "-T", "--trace-codegen"},
+                { opt.tabulate,                                          "--tabulate"},
+                { opt.newton.iterations,                                 "--newton-iterations"},
+                { to::set(opt.newton.reuse_jacobian), to::flag,          "--reuse-jacobian"},
                 { to::action(add_target, to::keywords(targetKindMap)),   "-t", "--target" },
                 { to::push_back(opt.rawfiles),                           "-r", "--raw"},
+                { to::action(version), to::flag, to::exit,               "--version" },
                 { to::action(help), to::flag, to::exit,                  "-h", "--help" }
         };
 
@@ -185,6 +219,12 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    // Without an iteration the nonlinear system would not be solved at all.
+    if (opt.newton.iterations<1) {
+        to::usage_error(argv[0], usage_str, "--newton-iterations must be at least 1");
+        return 1;
+    }
+
     if (!opt.catalogue.empty()) popt.cpp_namespace += "::" + opt.catalogue + "_catalogue";
 
     std::vector<std::pair<std::string, std::string>> modules;
@@ -220,6 +260,8 @@ int main(int argc, char **argv) {
             if (!p.parse()) return 1;
 
             emit_header("semantic analysis");
+            if (opt.tabulate.n) m.default_table(opt.tabulate);
+            m.newton(opt.newton);
             m.semantic();
             if (m.has_warning()) {
                 std::cerr << yellow("Warnings:\n")
@@ -10,6 +10,7 @@
 #include "errorvisitor.hpp"
 #include "functionexpander.hpp"
 #include "functioninliner.hpp"
+#include "functiontable.hpp"
 #include "procinliner.hpp"
 #include "kineticrewriter.hpp"
 #include "linearrewriter.hpp"
@@ -483,7 +484,7 @@ bool Module::semantic() {
                 solver = std::make_unique<SparseSolverVisitor>(solve_expression->variant());
             }
             else {
-                solver = std::make_unique<SparseNonlinearSolverVisitor>();
+                solver = std::make_unique<SparseNonlinearSolverVisitor>(newton_);
             }
             break;
         }
@@ -992,6 +993,10 @@ int Module::semantic_func_proc() {
         }
     }
 
+    // Function bodies are now self-contained and can be sampled; calls to
+    // tabulated functions are not inlined into procedures below.
+    tabulate_functions();
+
     // Once all functions are inlined internally; we can inline
     // function calls in the bodies of procedures
     for(auto& e : symbols_) {
@@ -1026,6 +1031,47 @@ int Module::semantic_func_proc() {
     return errors;
 }
 
+void Module::tabulate_functions() {
+    for (auto& e: symbols_) {
+        auto f = e.second->is_function();
+        if (!f) continue;
+
+        if (!f->table() && default_table_.n && f->args().size()==1) {
+            auto table = default_table_;
+            table.automatic = true;
+            f->table(std::move(table));
+        }
+        // semantic_func_proc runs more than once; sample each function once.
+        if (!f->table() || f->is_tabulated()) continue;
+
+        auto reason = tabulate_function(f);
+        if (!reason.empty()) {
+            if (!f->table()->automatic) {
+                warning(pprintf("TABLE for FUNCTION '%' is ignored, as %", f->name(), reason), f->table()->location);
+            }
+            f->table(TableSpec{});
+        }
+    }
+
+    // Run-time tables are stored back to back, each with n+2 values.
+    table_values_ = 0;
+    for (auto f: runtime_tables()) {
+        f->table()->offset = table_values_;
+        table_values_ += f->table()->n + 2;
+    }
+}
+
+std::vector<FunctionExpression*> Module::runtime_tables() const {
+    std::vector<FunctionExpression*> funcs;
+    for (auto& e: symbols_) {
+        auto f = e.second->is_function();
+        if (f && f->table() && f->table()->runtime) funcs.push_back(f);
+    }
+    std::sort(funcs.begin(), funcs.end(),
+        [](auto a, auto b) { return a->name() < b->name(); });
+    return funcs;
+}
+
 void Module::check_revpot_mechanism() {
     int n_write_revpot = 0;
     for (auto& iondep: neuron_block_.ions) {
@@ -96,6 +96,14 @@ public:
 
     std::string warning_string() const;
 
+    // Tabulate FUNCTIONs of one argument without a TABLE statement over the
+    // given range where possible; set before semantic analysis.
+    void default_table(const TableSpec& t) { default_table_ = t; }
+
+    // Newton's method for nonlinear sparse systems; set before semantic
+    // analysis.
+    void newton(const NewtonSpec& n) { newton_ = n; }
+
     // Perform semantic analysis pass.
     bool semantic();
 
@@ -114,6 +122,11 @@ public:
     bool is_linear() const { return linear_; }
     bool has_post_events() const { return post_events_; }
 
+    // FUNCTIONs sampled when the mechanism is initialised, sorted by name,
+    // and the number of values they occupy in the mechanism's table storage.
+    std::vector<FunctionExpression*> runtime_tables() const;
+    unsigned table_values() const { return table_values_; }
+
 private:
     moduleKind kind_;
     std::string title_;
@@ -129,6 +142,9 @@ private:
     WhiteNoiseBlock white_noise_block_;
     bool linear_;
     bool post_events_;
+    TableSpec default_table_;
+    unsigned table_values_ = 0;
+    NewtonSpec newton_;
 
     // AST storage.
     std::vector<symbol_ptr> callables_;
@@ -156,6 +172,9 @@ private:
     // Check requirements for reversal potential setters.
     void check_revpot_mechanism();
 
+    // Sample FUNCTIONs with a TABLE statement, or the default table.
+    void tabulate_functions();
+
     // Perform semantic analysis on functions and procedures.
     // Returns the number of errors that were encountered.
     int semantic_func_proc();
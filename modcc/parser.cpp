@@ -1016,9 +1016,23 @@ symbol_ptr Parser::parse_procedure() {
     if (!expect(tok::lbrace)) return nullptr;
 
     // parse the body of the function
+    table_ = {};
     expression_ptr body = parse_block(false);
     if (body == nullptr) return nullptr;
 
+    if (table_.n) {
+        if (kind != procedureKind::normal) {
+            error("TABLE statements are only allowed in FUNCTION and PROCEDURE blocks", table_.location);
+            return nullptr;
+        }
+        // Values set by a PROCEDURE are not tabulated: they are computed
+        // directly. Many published models carry such tables, so don't reject
+        // them.
+        if (module_) {
+            module_->warning("TABLE statement in PROCEDURE is ignored, use a FUNCTION per tabulated value instead", table_.location);
+        }
+    }
+
     auto proto = p->is_prototype();
     if(kind == procedureKind::net_receive) {
         return make_symbol<NetReceiveExpression> (proto->location(), proto->name(), std::move(proto->args()), std::move(body));
@@ -1051,11 +1065,24 @@ symbol_ptr Parser::parse_function() {
     if (!expect(tok::lbrace)) return nullptr;
 
     // parse the body of the function
+    table_ = {};
     auto body = parse_block(false);
     if (body == nullptr) return nullptr;
 
     PrototypeExpression* proto = p->is_prototype();
-    return make_symbol<FunctionExpression>(proto->location(), proto->name(), std::move(proto->args()), std::move(body));
+    if (table_.n) {
+        if (!table_.variables.empty()) {
+            error("TABLE statements in a FUNCTION tabulate its value and take no variable list", table_.location);
+            return nullptr;
+        }
+        if (proto->args().size() != 1) {
+            error("TABLE statements are only supported in a FUNCTION of one argument", table_.location);
+            return nullptr;
+        }
+    }
+    auto f = make_symbol<FunctionExpression>(proto->location(), proto->name(), std::move(proto->args()), std::move(body));
+    f->is_function()->table(std::move(table_));
+    return f;
 }
 
 // this is the first port of call when parsing a new line inside a verb block
@@ -1783,6 +1810,56 @@ expression_ptr Parser::parse_if() {
     return make_expression<IfExpression>(if_token.location, std::move(cond), std::move(true_branch), std::move(false_branch));
 }
 
+// TABLE [variables] [DEPEND variables] FROM lo TO hi WITH n
+bool Parser::parse_table() {
+    table_ = {};
+    table_.location = token_.location;
+
+    auto names = [](const std::vector<Token>& tokens) {
+        std::vector<std::string> r;
+        for (auto& t: tokens) r.push_back(t.spelling);
+        return r;
+    };
+
+    // the list of tabulated variables starts on the same line as TABLE
+    if (peek().type == tok::identifier) {
+        table_.variables = names(comma_separated_identifiers());
+    }
+    else {
+        get_token(); // consume TABLE
+    }
+    if (status_ == lexerStatus::error) return false;
+
+    if (token_.type == tok::depend) {
+        if (peek().type != tok::identifier) {
+            error(pprintf("DEPEND must be followed by a list of variables, found '%'", peek()));
+            return false;
+        }
+        table_.depend = names(comma_separated_identifiers());
+        if (status_ == lexerStatus::error) return false;
+    }
+
+    auto [lo, hi] = from_to_description();
+    if (status_ == lexerStatus::error) return false;
+
+    if (token_.type != tok::with) {
+        error(pprintf("TABLE range must be followed by WITH <number of intervals>, found '%'", token_));
+        return false;
+    }
+    get_token(); // consume WITH
+    auto n = value_signed_integer();
+    if (status_ == lexerStatus::error) return false;
+
+    table_.from = std::stod(lo);
+    table_.to = std::stod(hi);
+    if (n < 1 || !(table_.from < table_.to)) {
+        error(pprintf("TABLE requires FROM < TO and at least one interval, found FROM % TO % WITH %", lo, hi, n), table_.location);
+        return false;
+    }
+    table_.n = n;
+    return true;
+}
+
 // takes a flag indicating whether the block is at procedure/function body,
 // or lower. Can be used to check for illegal statements inside a nested block,
 // e.g. LOCAL declarations.
@@ -1797,6 +1874,15 @@ expression_ptr Parser::parse_block(bool is_nested) {
 
     expr_list_type body;
     while (token_.type != tok::rbrace) {
+        if (token_.type == tok::table) {
+            if (is_nested) {
+                error("TABLE statements are not allowed inside a nested scope");
+                return nullptr;
+            }
+            if (!parse_table()) return nullptr;
+            continue;
+        }
+
         auto e = parse_statement();
         if (!e) return e;
 
@@ -41,6 +41,7 @@ public:
     expression_ptr parse_initial();
     expression_ptr parse_compartment_statement();
     expression_ptr parse_if();
+    bool parse_table();
 
     symbol_ptr parse_procedure();
     symbol_ptr parse_function();
@@ -66,6 +67,9 @@ public:
 private:
     Module* module_;
 
+    // TABLE statement of the FUNCTION or PROCEDURE being parsed.
+    TableSpec table_;
+
     std::vector<Token> comma_separated_identifiers();
     std::vector<Token> unit_description();
     std::string value_literal();
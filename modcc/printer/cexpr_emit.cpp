@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "printerutil.hpp"
+#include "functiontable.hpp"
 #include "cexpr_emit.hpp"
 #include "error.hpp"
 #include "lexer.hpp"
@@ -397,6 +398,12 @@ void SimdExprEmitter::visit(BlockExpression* block) {
 }
 
 void SimdExprEmitter::visit(CallExpression* e) {
+    if (is_table_lookup(e)) {
+        out_ << table_lookup_open(e->function());
+        e->args().front()->accept(this);
+        out_ << ")";
+        return;
+    }
     if(is_indirect_)
         out_ << e->name() << "(pp, index_";
     else
@@ -7,6 +7,7 @@
 #include "expression.hpp"
 #include "io/ostream_wrappers.hpp"
 #include "io/prefixbuf.hpp"
+#include "functiontable.hpp"
 #include "printer/cexpr_emit.hpp"
 #include "printer/cprinter.hpp"
 #include "printer/printeropt.hpp"
@@ -50,6 +51,7 @@ struct index_prop {
 };
 
 void emit_api_body(std::ostream&, APIMethod*, const ApiFlags& flags={});
+void emit_table_fill(std::ostream&, FunctionExpression*);
 void emit_simd_api_body(std::ostream&, APIMethod*, const std::vector<VariableExpression*>& scalars, const ApiFlags&);
 void emit_simd_index_initialize(std::ostream& out, const std::list<index_prop>& indices, simd_expr_constraint constraint);
 
@@ -90,6 +92,7 @@ struct simdprint {
     bool is_indirect_ = false; // For choosing between "index_" and "i_" as an index. Depends on whether
                                // we are in a procedure or handling a simd constraint in an API call.
     bool is_masked_ = false;
+    bool is_gathered_ = false;
     std::unordered_set<std::string> scalars_;
 
     explicit simdprint(Expression* expr, const std::vector<VariableExpression*>& scalars): expr_(expr) {
@@ -104,6 +107,9 @@ struct simdprint {
     void set_masked() {
         is_masked_ = true;
     }
+    void set_gathered() {
+        is_gathered_ = true;
+    }
 
     friend std::ostream& operator<<(std::ostream& out, const simdprint& w) {
         SimdPrinter printer(out);
@@ -111,6 +117,7 @@ struct simdprint {
             printer.set_input_mask("mask_input_");
         }
         printer.set_var_indexed(w.is_indirect_);
+        printer.set_gathered(w.is_gathered_);
         printer.save_scalar_names(w.scalars_);
         return w.expr_->accept(&printer), out;
     }
@@ -221,22 +228,57 @@ ARB_LIBMODCC_API std::string emit_cpp_source(const Module& module_, const printe
               "\n";
     }
 
+    // Tabulated functions; calls to these are printed as lookups.
+    for (auto f: tabulated_functions(module_)) {
+        emit_table_lookup(out, f, "static");
+        if (with_simd) {
+            auto table = f->table();
+            auto name = table_lookup_name(f->name());
+            auto data = table->runtime? std::string("data"): name + "data_";
+            out << "inline simd_value " << name << "("
+                << (table->runtime? "const arb_value_type* data, ": "") << "const simd_value& x) {\n" << indent
+                << "simd_value u = S::mul(S::sub(x, simd_cast<simd_value>(" << as_c_double(table->from) << ")), "
+                << "simd_cast<simd_value>(" << as_c_double(table->n/(table->to - table->from)) << "));\n"
+                << "simd_value c = simd_cast<simd_value>(0.0);\n"
+                << "S::where(S::cmp_gt(u, c), c) = u;\n"
+                << "u = simd_cast<simd_value>(" << as_c_double(table->n) << ");\n"
+                << "S::where(S::cmp_lt(c, u), u) = c;\n"
+                << "simd_index i = simd_cast<simd_index>(u);\n"
+                << "simd_value w = S::sub(u, simd_cast<simd_value>(i));\n"
+                << "simd_value y0 = simd_cast<simd_value>(indirect(" << data << ", i, simd_width_));\n"
+                << "simd_value y1 = simd_cast<simd_value>(indirect(" << data << "+1, i, simd_width_));\n"
+                << "return S::fma(w, S::sub(y1, y0), y0);\n"
+                << popindent << "}\n\n";
+        }
+    }
+
+    const auto& [state_ids, global_ids, param_ids, white_noise_ids] = public_variable_ids(module_);
+    const auto& assigned_ids = module_.assigned_block().parameters;
+
+    // Range parameters are read as scalars by the kernel variants for
+    // parameters that are uniform across the mechanism instance.
+    std::vector<VariableExpression*> range_params;
+    for (const auto& id: param_ids) {
+        range_params.push_back(module_.symbols().at(id.name())->is_variable());
+    }
+    auto uniform_scalars = vars.scalars;
+    uniform_scalars.insert(uniform_scalars.end(), range_params.begin(), range_params.end());
+
     // Make implementations
-    auto emit_body = [&](APIMethod *p, bool add=false) {
+    auto emit_body = [&](APIMethod *p, bool add=false, bool uniform=false) {
         auto flags = ApiFlags{}
             .additive(add)
             .point(moduleKind::point == module_.kind())
-            .voltage(moduleKind::voltage == module_.kind());
+            .voltage(moduleKind::voltage == module_.kind())
+            .uniform(uniform);
         if (with_simd) {
-            emit_simd_api_body(out, p, vars.scalars, flags);
+            emit_simd_api_body(out, p, uniform? uniform_scalars: vars.scalars, flags);
         } else {
             emit_api_body(out, p, flags);
         }
     };
 
-    const auto& [state_ids, global_ids, param_ids, white_noise_ids] = public_variable_ids(module_);
-    const auto& assigned_ids = module_.assigned_block().parameters;
-    out << fmt::format(FMT_COMPILE("#define PPACK_IFACE_BLOCK \\\n"
+    out << fmt::format(FMT_COMPILE("#define PPACK_IFACE_COMMON \\\n"
                                    "[[maybe_unused]] auto {0}width                                                 = pp->width;\\\n"
                                    "[[maybe_unused]] auto {0}n_detectors                                           = pp->n_detectors;\\\n"
                                    "[[maybe_unused]] auto {0}dt                                                    = pp->dt;\\\n"
@@ -269,6 +311,7 @@ ARB_LIBMODCC_API std::string emit_cpp_source(const Module& module_, const printe
         global++;
     }
     out << fmt::format("[[maybe_unused]] auto const * const * {}random_numbers = pp->random_numbers;\\\n", pp_var_pfx);
+    out << fmt::format("[[maybe_unused]] arb_value_type* __restrict__ {}tables = pp->tables;\\\n", pp_var_pfx);
     auto param = 0, state = 0;
     for (const auto& array: state_ids) {
         out << fmt::format("[[maybe_unused]] arb_value_type* __restrict__ {}{} = pp->state_vars[{}];\\\n", pp_var_pfx, array.name(), state);
@@ -278,20 +321,47 @@ ARB_LIBMODCC_API std::string emit_cpp_source(const Module& module_, const printe
         out << fmt::format("[[maybe_unused]] arb_value_type* __restrict__ {}{} = pp->state_vars[{}];\\\n", pp_var_pfx, array.name(), state);
         state++;
     }
-    for (const auto& array: param_ids) {
-        out << fmt::format("[[maybe_unused]] arb_value_type* __restrict__ {}{} = pp->parameters[{}];\\\n", pp_var_pfx, array.name(), param);
-        param++;
-    }
     auto idx = 0;
     for (const auto& ion: module_.ion_deps()) {
         out << fmt::format("[[maybe_unused]] auto& {}{} = pp->ion_states[{}];\\\n",       pp_var_pfx, ion_field(ion), idx);
         out << fmt::format("[[maybe_unused]] auto* __restrict__ {}{} = pp->ion_states[{}].index;\\\n", pp_var_pfx, ion_index(ion), idx);
         idx++;
     }
-    out << "//End of IFACEBLOCK\n\n"
-        << "\n"
+    out << "//End of IFACECOMMON\n\n";
+
+    out << "#define PPACK_IFACE_BLOCK \\\n"
+        << "PPACK_IFACE_COMMON \\\n";
+    for (const auto& array: param_ids) {
+        out << fmt::format("[[maybe_unused]] arb_value_type* __restrict__ {}{} = pp->parameters[{}];\\\n", pp_var_pfx, array.name(), param);
+        param++;
+    }
+    out << "//End of IFACEBLOCK\n\n";
+
+    // Uniform parameters are the same for all instances; read the first.
+    if (!range_params.empty()) {
+        out << "#define PPACK_UNIFORM_IFACE_BLOCK \\\n"
+            << "PPACK_IFACE_COMMON \\\n";
+        param = 0;
+        for (const auto& array: param_ids) {
+            out << fmt::format("[[maybe_unused]] arb_value_type {}{} = pp->parameters[{}][0];\\\n", pp_var_pfx, array.name(), param);
+            param++;
+        }
+        out << "//End of UNIFORM IFACEBLOCK\n\n";
+    }
+
+    // Tables of functions of global parameters.
+    auto runtime_tables = module_.runtime_tables();
+    if (!runtime_tables.empty()) {
+        out << "static void fill_tables(arb_mechanism_ppack* pp) {\n" << indent
+            << "PPACK_IFACE_BLOCK;\n";
+        for (auto f: runtime_tables) emit_table_fill(out, f);
+        out << popindent << "}\n\n";
+    }
+
+    out << "\n"
         << "// interface methods\n"
         << "static void init(arb_mechanism_ppack* pp) {\n" << indent;
+    if (!runtime_tables.empty()) out << "fill_tables(pp);\n";
     emit_body(init_api);
     if (init_api && init_api->body() && !init_api->body()->statements().empty()) {
         auto n = std::count_if(vars.arrays.begin(), vars.arrays.end(),
@@ -319,7 +389,72 @@ ARB_LIBMODCC_API std::string emit_cpp_source(const Module& module_, const printe
     emit_body(write_ions_api);
     out << popindent << "}\n\n";
 
-    if (net_receive_api) {
+    // Variants of the per-step kernels for uniform parameters, printing the
+    // range parameters as scalars.
+    if (!range_params.empty()) {
+        for (auto p: range_params) p->range(rangeKind::scalar);
+
+        out << "static void advance_state_uniform(arb_mechanism_ppack* pp) {\n" << indent;
+        emit_body(state_api, true, true);
+        out << popindent << "}\n\n";
+
+        out << "static void compute_currents_uniform(arb_mechanism_ppack* pp) {\n" << indent;
+        emit_body(current_api, true, true);
+        out << popindent << "}\n\n";
+
+        for (auto p: range_params) p->range(rangeKind::range);
+    }
+
+    // Events arrive sorted by instance. If the NET_RECEIVE block is additive in
+    // the weight, the events of each instance are summed and applied once, and
+    // with SIMD the sums are applied to batches of distinct instances.
+    bool additive_events = is_additive_net_receive(net_receive_api);
+    if (net_receive_api && additive_events && with_simd && indexed_locals(net_receive_api->scope()).empty()) {
+        auto weight = net_receive_api->args().front()->is_argument()->name();
+        out << fmt::format(FMT_COMPILE("static void apply_events(arb_mechanism_ppack* pp, arb_deliverable_event_stream* stream_ptr) {{\n"
+                                       "    PPACK_IFACE_BLOCK;\n"
+                                       "    auto [begin_, end_] = *stream_ptr;\n"
+                                       "    arb_index_type index_buf_[simd_width_];\n"
+                                       "    arb_value_type weight_buf_[simd_width_];\n"
+                                       "    unsigned n_ = 0;\n"
+                                       "    while (begin_<end_) {{\n"
+                                       "        auto i_ = begin_->mech_index;\n"
+                                       "        arb_value_type w_ = 0;\n"
+                                       "        for (; begin_<end_ && begin_->mech_index==i_; ++begin_) w_ += begin_->weight;\n"
+                                       "        index_buf_[n_] = i_;\n"
+                                       "        weight_buf_[n_] = w_;\n"
+                                       "        if (++n_==simd_width_) {{\n"
+                                       "            n_ = 0;\n"
+                                       "            simd_index index_ = simd_cast<simd_index>(indirect(index_buf_, simd_width_));\n"
+                                       "            simd_value {0} = simd_cast<simd_value>(indirect(weight_buf_, simd_width_));\n"),
+                           weight);
+        auto printer = simdprint(net_receive_api->body(), vars.scalars);
+        printer.set_gathered();
+        out << indent << indent << indent << printer << popindent << popindent << popindent;
+        out << fmt::format(FMT_COMPILE("        }}\n"
+                                       "    }}\n"
+                                       "    for (unsigned k_ = 0; k_<n_; ++k_) {{\n"
+                                       "        [[maybe_unused]] auto i_ = index_buf_[k_];\n"
+                                       "        [[maybe_unused]] auto {0} = weight_buf_[k_];\n"),
+                           weight);
+        out << indent << indent;
+        emit_api_body(out, net_receive_api, net_recv_flags);
+        out << popindent << "}\n" << popindent << "}\n\n";
+    }
+    else if (net_receive_api && additive_events) {
+        out << fmt::format(FMT_COMPILE("static void apply_events(arb_mechanism_ppack* pp, arb_deliverable_event_stream* stream_ptr) {{\n"
+                                       "    PPACK_IFACE_BLOCK;\n"
+                                       "    auto [begin_, end_] = *stream_ptr;\n"
+                                       "    while (begin_<end_) {{\n"
+                                       "        [[maybe_unused]] auto i_ = begin_->mech_index;\n"
+                                       "        [[maybe_unused]] arb_value_type {0} = 0;\n"
+                                       "        for (; begin_<end_ && begin_->mech_index==i_; ++begin_) {0} += begin_->weight;\n"),
+                           net_receive_api->args().front()->is_argument()->name());
+        out << indent << indent;
+        emit_api_body(out, net_receive_api, net_recv_flags);
+        out << popindent << "}\n" << popindent << "}\n\n";
+    }
+    else if (net_receive_api) {
         out << fmt::format(FMT_COMPILE("static void apply_events(arb_mechanism_ppack* pp, arb_deliverable_event_stream* stream_ptr) {{\n"
                                        "    PPACK_IFACE_BLOCK;\n"
                                        "    auto [begin_, end_] = *stream_ptr;\n"
@@ -355,6 +490,8 @@ ARB_LIBMODCC_API std::string emit_cpp_source(const Module& module_, const printe
 
     out << popindent
         << "#undef PPACK_IFACE_BLOCK\n"
+        << (range_params.empty()? "": "#undef PPACK_UNIFORM_IFACE_BLOCK\n")
+        << "#undef PPACK_IFACE_COMMON\n"
         << "} // namespace kernel_" << name
         << "\n"
         << namespace_declaration_close(ns_components)
@@ -376,13 +513,17 @@ ARB_LIBMODCC_API std::string emit_cpp_source(const Module& module_, const printe
                                    "    result.advance_state = {3}advance_state;\n"
                                    "    result.write_ions = {3}write_ions;\n"
                                    "    result.post_event = {3}post_event;\n"
+                                   "    result.compute_currents_uniform = {4};\n"
+                                   "    result.advance_state_uniform = {5};\n"
                                    "    return &result;\n"
                                    "  }}\n"
                                    "}}\n\n"),
                        std::regex_replace(opt.cpp_namespace, std::regex{"::"}, "_"),
                        name,
                        "arb_backend_kind_cpu",
-                       ss.str());
+                       ss.str(),
+                       range_params.empty()? "nullptr": ss.str() + "compute_currents_uniform",
+                       range_params.empty()? "nullptr": ss.str() + "advance_state_uniform");
 
     EXIT(out);
     return out.str();
@@ -408,6 +549,12 @@ void CPrinter::visit(VariableExpression *sym) {
 
 
 void CPrinter::visit(CallExpression* e) {
+    if (is_table_lookup(e)) {
+        out_ << table_lookup_open(e->function());
+        e->args().front()->accept(this);
+        out_ << ")";
+        return;
+    }
     out_ << e->name() << "(pp, i_";
     for (auto& arg: e->args()) {
         out_ << ", ";
@@ -440,6 +587,38 @@ void CPrinter::visit(BlockExpression* block) {
     EXITM(out_, "c:block");
 }
 
+namespace {
+// The return value of a function is a plain symbol in its body.
+class TableFillPrinter: public CPrinter {
+public:
+    TableFillPrinter(std::ostream& out): CPrinter(out) {}
+
+    using CPrinter::visit;
+    void visit(Symbol* sym) override {
+        out_ << sym->name();
+    }
+};
+}
+
+// Sample the function at the points given by its table, as in the compiler,
+// and repeat the last value, see emit_table_lookup.
+void emit_table_fill(std::ostream& out, FunctionExpression* f) {
+    auto table = f->table();
+    auto n = table->n;
+    auto arg = f->args().front()->is_argument()->spelling();
+
+    out << "for (arb_size_type i_ = 0; i_ <= " << n << "; ++i_) {\n" << indent
+        << "arb_value_type " << arg << " = i_==" << n << "? " << as_c_double(table->to) << ": "
+        << as_c_double(table->from) << " + i_*" << as_c_double((table->to - table->from)/n) << ";\n"
+        << "arb_value_type " << f->name() << ";\n";
+    TableFillPrinter printer(out);
+    f->body()->accept(&printer);
+    out << pp_var_pfx << "tables[" << table->offset << " + i_] = " << f->name() << ";\n"
+        << popindent << "}\n"
+        << pp_var_pfx << "tables[" << table->offset + n + 1 << "] = "
+        << pp_var_pfx << "tables[" << table->offset + n << "];\n";
+}
+
 static std::string index_i_name(const std::string& index_var) {
     return index_var+"i_";
 }
@@ -516,7 +695,7 @@ void emit_api_body(std::ostream& out, APIMethod* method, const ApiFlags& flags)
 
     std::list<index_prop> indices = gather_indexed_vars(indexed_vars, "i_");
     if (!body->statements().empty()) {
-        if (flags.ppack_iface) out << "PPACK_IFACE_BLOCK;\n";
+        if (flags.ppack_iface) out << (flags.uniform_params? "PPACK_UNIFORM_IFACE_BLOCK;\n": "PPACK_IFACE_BLOCK;\n");
         if (flags.cv_loop) {
             out << fmt::format("for (arb_size_type i_ = 0; i_ < {}width; ++i_) {{\n",
                                pp_var_pfx)
@@ -600,8 +779,7 @@ void SimdPrinter::visit(LocalVariable* sym) {
 void SimdPrinter::visit(VariableExpression *sym) {
     ENTERM(out_, "variable");
     if (sym->is_range()) {
-        auto index = is_indirect_? "index_": "i_";
-        out_ << "simd_cast<simd_value>(indirect(" << pp_var_pfx << sym->name() << "+" << index << ", simd_width_))";
+        out_ << "simd_cast<simd_value>(" << range_access(sym->name()) << ")";
     }
     else {
         out_ << pp_var_pfx << sym->name();
@@ -609,6 +787,13 @@ void SimdPrinter::visit(VariableExpression *sym) {
     EXITM(out_, "variable");
 }
 
+std::string SimdPrinter::range_access(const std::string& name) const {
+    if (is_gathered_) {
+        return fmt::format("indirect({}{}, index_, simd_width_, index_constraint::independent)", pp_var_pfx, name);
+    }
+    return fmt::format("indirect({}{}+{}, simd_width_)", pp_var_pfx, name, is_indirect_? "index_": "i_");
+}
+
 void SimdPrinter::visit(WhiteNoise* sym) {
     auto index = is_indirect_? "index_": "i_";
     out_ << fmt::format("simd_cast<simd_value>(indirect({}random_numbers[{}]+{}, simd_width_))",
@@ -623,7 +808,6 @@ void SimdPrinter::visit(AssignmentExpression* e) {
 
     Symbol* lhs = e->lhs()->is_identifier()->symbol();
     std::string pfx = lhs->is_local_variable() ? "" : pp_var_pfx;
-    std::string index = is_indirect_ ? "index_" : "i_";
 
     // lhs should not be an IndexedVariable, only a VariableExpression or LocalVariable.
     // IndexedVariables are only assigned in API calls and are handled in a special way.
@@ -633,7 +817,7 @@ void SimdPrinter::visit(AssignmentExpression* e) {
     // If lhs is a VariableExpression, it must be a range variable. Non-range variables
     // are scalars and read-only.
     if (lhs->is_variable() && lhs->is_variable()->is_range()) {
-        out_ << "indirect(" << pfx << lhs->name() << "+" << index << ", simd_width_) = ";
+        out_ << range_access(lhs->name()) << " = ";
         if (!input_mask_.empty())
             out_ << "S::where(" << input_mask_ << ", ";
 
@@ -660,7 +844,7 @@ void SimdPrinter::visit(AssignmentExpression* e) {
             if (auto sym = rhs->symbol()) {
                 // We shouldn't call the rhs visitor in this case because it automatically casts indirect expressions
                 if (sym->is_variable() && sym->is_variable()->is_range()) {
-                    out_ << "indirect(" << pp_var_pfx << rhs->name() << "+" << index << ", simd_width_))";
+                    out_ << range_access(rhs->name()) << ")";
                     return;
                 }
             }
@@ -673,6 +857,13 @@ void SimdPrinter::visit(AssignmentExpression* e) {
 
 void SimdPrinter::visit(CallExpression* e) {
     ENTERM(out_, "call");
+    if (is_table_lookup(e)) {
+        out_ << table_lookup_open(e->function());
+        e->args().front()->accept(this);
+        out_ << ")";
+        EXITM(out_, "call");
+        return;
+    }
     if(is_indirect_)
         out_ << e->name() << "(pp, index_";
     else
@@ -1000,7 +1191,7 @@ void emit_simd_api_body(std::ostream& out, APIMethod* method,
         }
     }
     if (!body->statements().empty()) {
-        out << "PPACK_IFACE_BLOCK;\n";
+        out << (flags.uniform_params? "PPACK_UNIFORM_IFACE_BLOCK;\n": "PPACK_IFACE_BLOCK;\n");
         out << "assert(simd_width_ <= (unsigned)S::width(simd_cast<simd_value>(0)));\n";
         if (!indices.empty()) {
             out << "index_constraint constraint_category_;\n\n";
@@ -52,12 +52,14 @@ struct ApiFlags {
     bool use_additive=false;
     bool is_point=false;
     bool can_write_voltage=false;
+    bool uniform_params=false;
 
     ApiFlags& loop(bool v) { cv_loop = v; return *this; }
     ApiFlags& iface(bool v) { ppack_iface = v; return *this; }
     ApiFlags& additive(bool v) { use_additive = v; return *this; }
     ApiFlags& point(bool v) { is_point = v; return *this; }
     ApiFlags& voltage(bool v) { can_write_voltage = v; return *this; }
+    ApiFlags& uniform(bool v) { uniform_params = v; return *this; }
 };
 
 const ApiFlags net_recv_flags = {false, false, true}; // No CV loop, no PPACK, use additive
@@ -79,6 +81,9 @@ public:
     void save_scalar_names(const std::unordered_set<std::string>& scalars) {
         scalars_ = scalars;
     }
+    void set_gathered(bool is_gathered) {
+        is_gathered_ = is_gathered;
+    }
     using Visitor::visit;
     void visit(BlockExpression*) override;
     void visit(CallExpression*) override;
@@ -98,5 +103,9 @@ private:
     std::string input_mask_;
     bool is_indirect_ = false; // For choosing between "index_" and "i_" as an index. Depends on whether
                                // we are in a procedure or handling a simd constraint in an API call.
+    bool is_gathered_ = false; // Range variables are gathered from and scattered to the distinct
+                               // instances in the simd_index `index_`, e.g. when applying events.
     std::unordered_set<std::string> scalars_;
+
+    std::string range_access(const std::string& name) const;
 };
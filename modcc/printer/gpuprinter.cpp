@@ -12,6 +12,7 @@
 #include "expression.hpp"
 #include "io/ostream_wrappers.hpp"
 #include "io/prefixbuf.hpp"
+#include "functiontable.hpp"
 #include "printer/cexpr_emit.hpp"
 #include "printer/printerutil.hpp"
 
@@ -31,6 +32,7 @@ static std::string scaled(double coeff) {
 void emit_api_body_cu(std::ostream& out, APIMethod* method, const ApiFlags&);
 void emit_state_read_cu(std::ostream& out, LocalVariable* local, const ApiFlags&);
 void emit_state_update_cu(std::ostream& out, Symbol* from, IndexedVariable* external, const ApiFlags&);
+void emit_table_fill_cu(std::ostream& out, FunctionExpression* f);
 
 const char* index_id(Symbol *s);
 
@@ -160,6 +162,7 @@ ARB_LIBMODCC_API std::string emit_gpu_cu_source(const Module& module_, const pri
         global++;
     }
     out << fmt::format("auto const * const * {}random_numbers  __attribute__((unused)) = params_.random_numbers;\\\n", pp_var_pfx);
+    out << fmt::format("arb_value_type * __restrict__ {}tables __attribute__((unused)) = params_.tables;\\\n", pp_var_pfx);
     auto param = 0, state = 0;
     for (const auto& array: state_ids) {
         out << fmt::format("arb_value_type * __restrict__ {}{} __attribute__((unused)) = params_.state_vars[{}];\\\n", pp_var_pfx, array.name(), state);
@@ -191,6 +194,11 @@ ARB_LIBMODCC_API std::string emit_gpu_cu_source(const Module& module_, const pri
         << "using ::arb::gpu::min;\n"
         << "using ::arb::gpu::max;\n\n";
 
+    // Tabulated functions; calls to these are printed as lookups.
+    for (auto f: tabulated_functions(module_)) {
+        emit_table_lookup(out, f, "__device__");
+    }
+
     // API methods as __global__ kernels.
     auto emit_api_kernel = [&] (APIMethod* e, bool additive=false) {
         // Only print the kernel if the method is not empty.
@@ -207,6 +215,21 @@ ARB_LIBMODCC_API std::string emit_gpu_cu_source(const Module& module_, const pri
     auto n_state_vars = std::count_if(vars.arrays.begin(), vars.arrays.end(),
                                       [] (const auto& v) { return v->is_state(); });
 
+    // Tables of functions of global parameters, one sample per thread.
+    auto runtime_tables = module_.runtime_tables();
+    unsigned n_samples = 0;
+    if (!runtime_tables.empty()) {
+        out << "__global__\n"
+            << "void fill_tables(arb_mechanism_ppack params_) {\n" << indent
+            << "PPACK_IFACE_BLOCK;\n"
+            << "unsigned tid_ = threadIdx.x + blockDim.x*blockIdx.x;\n";
+        for (auto f: runtime_tables) {
+            emit_table_fill_cu(out, f);
+            n_samples = std::max(n_samples, f->table()->n + 1);
+        }
+        out << popindent << "}\n\n";
+    }
+
 
     emit_api_kernel(init_api);
     if (init_api && !init_api->body()->statements().empty() && n_state_vars > 0) {
@@ -289,6 +312,11 @@ ARB_LIBMODCC_API std::string emit_gpu_cu_source(const Module& module_, const pri
     {
         auto api_name = init_api->name();
         out << fmt::format(FMT_COMPILE("void {}_{}_(arb_mechanism_ppack* p) {{"), class_name, api_name);
+        if (n_samples) {
+            out << fmt::format(FMT_COMPILE("\n"
+                                           "    if (p->width) ::arb::gpu::launch_1d({}, 128, fill_tables, *p);"),
+                               n_samples);
+        }
         if(!init_api->body()->statements().empty()) {
             out << fmt::format(FMT_COMPILE("\n"
                                            "    auto n = p->{0};\n"
@@ -302,6 +330,9 @@ ARB_LIBMODCC_API std::string emit_gpu_cu_source(const Module& module_, const pri
             if (n_state_vars) out << fmt::format(FMT_COMPILE("    ::arb::gpu::launch({{grid_dim, {}}}, block_dim, multiply, *p);\n"),
                                                  n_state_vars);
         }
+        else if (n_samples) {
+            out << "\n";
+        }
         out << "}\n\n";
     }
 
@@ -511,6 +542,12 @@ void GpuPrinter::visit(VariableExpression *sym) {
 }
 
 void GpuPrinter::visit(CallExpression* e) {
+    if (is_table_lookup(e)) {
+        out_ << table_lookup_open(e->function());
+        e->args().front()->accept(this);
+        out_ << ")";
+        return;
+    }
     out_ << e->name() << "(params_, tid_";
     for (auto& arg: e->args()) {
         out_ << ", ";
@@ -519,6 +556,37 @@ void GpuPrinter::visit(CallExpression* e) {
     out_ << ")";
 }
 
+namespace {
+// The return value of a function is a plain symbol in its body.
+class TableFillPrinter: public GpuPrinter {
+public:
+    TableFillPrinter(std::ostream& out): GpuPrinter(out) {}
+
+    using GpuPrinter::visit;
+    void visit(Symbol* sym) override {
+        out_ << sym->name();
+    }
+};
+}
+
+// Sample the function at the points given by its table as the CPU back end
+// does, one point per thread.
+void emit_table_fill_cu(std::ostream& out, FunctionExpression* f) {
+    auto table = f->table();
+    auto n = table->n;
+    auto arg = f->args().front()->is_argument()->spelling();
+
+    out << "if (tid_ <= " << n << ") {\n" << indent
+        << "arb_value_type " << arg << " = tid_==" << n << "? " << as_c_double(table->to) << ": "
+        << as_c_double(table->from) << " + tid_*" << as_c_double((table->to - table->from)/n) << ";\n"
+        << "arb_value_type " << f->name() << ";\n";
+    TableFillPrinter printer(out);
+    f->body()->accept(&printer);
+    out << pp_var_pfx << "tables[" << table->offset << " + tid_] = " << f->name() << ";\n"
+        << "if (tid_ == " << n << ") " << pp_var_pfx << "tables[" << table->offset + n + 1 << "] = " << f->name() << ";\n"
+        << popindent << "}\n";
+}
+
 void GpuPrinter::visit(WhiteNoise* sym) {
     out_ << fmt::format("{}random_numbers[{}][tid_]", pp_var_pfx, sym->index());
 }
@@ -106,6 +106,7 @@ ARB_LIBMODCC_API std::string build_info_header(const Module& m, const printer_op
                                    "    result.n_parameters=n_parameters;\n"
                                    "    result.random_variables=random_variables;\n"
                                    "    result.n_random_variables=n_random_variables;\n"
+                                   "    result.n_table_values={5};\n"
                                    "    return result;\n"
                                    "  }}\n"
                                    "\n"),
@@ -113,7 +114,8 @@ ARB_LIBMODCC_API std::string build_info_header(const Module& m, const printer_op
                        fingerprint,
                        module_kind_str(m),
                        m.is_linear(),
-                       m.has_post_events())
+                       m.has_post_events(),
+                       m.table_values())
         << fmt::format("  arb_mechanism_interface* make_{0}_{1}_interface_multicore();\n"
                        "  arb_mechanism_interface* make_{0}_{1}_interface_gpu();\n"
                        "\n"
@@ -1,10 +1,16 @@
+#include <algorithm>
 #include <regex>
+#include <set>
 #include <string>
 #include <unordered_set>
 
+#include "cexpr_emit.hpp"
 #include "expression.hpp"
+#include "functiontable.hpp"
 #include "module.hpp"
 #include "printerutil.hpp"
+#include "symdiff.hpp"
+#include "visitor.hpp"
 
 ARB_LIBMODCC_API std::vector<std::string> namespace_components(const std::string& ns) {
     static std::regex ns_regex("([^:]+)(?:::|$)");
@@ -111,6 +117,124 @@ ARB_LIBMODCC_API std::vector<ProcedureExpression*> module_normal_procedures(cons
     return procs;
 }
 
+namespace {
+// Collect the functions evaluated by table lookup in a block.
+class TableLookupFinder: public Visitor {
+public:
+    std::set<FunctionExpression*> functions;
+
+    void visit(Expression* e) override {}
+
+    void visit(BlockExpression* e) override {
+        for (auto& s: e->statements()) s->accept(this);
+    }
+
+    void visit(IfExpression* e) override {
+        e->condition()->accept(this);
+        e->true_branch()->accept(this);
+        if (e->false_branch()) e->false_branch()->accept(this);
+    }
+
+    void visit(AssignmentExpression* e) override {
+        e->rhs()->accept(this);
+    }
+
+    void visit(UnaryExpression* e) override {
+        e->expression()->accept(this);
+    }
+
+    void visit(BinaryExpression* e) override {
+        e->lhs()->accept(this);
+        e->rhs()->accept(this);
+    }
+
+    void visit(CallExpression* e) override {
+        if (is_table_lookup(e)) functions.insert(e->function());
+        for (auto& a: e->args()) a->accept(this);
+    }
+};
+} // namespace
+
+ARB_LIBMODCC_API std::vector<FunctionExpression*> tabulated_functions(const Module& m) {
+    TableLookupFinder finder;
+    for (auto api: {"init", "advance_state", "compute_currents", "write_ions", "net_rec_api", "post_event_api"}) {
+        if (auto method = find_api_method(m, api)) {
+            method->body()->accept(&finder);
+        }
+    }
+
+    std::vector<FunctionExpression*> funcs(finder.functions.begin(), finder.functions.end());
+    std::sort(funcs.begin(), funcs.end(),
+        [](auto a, auto b) { return a->name() < b->name(); });
+
+    return funcs;
+}
+
+ARB_LIBMODCC_API void emit_table_lookup(std::ostream& out, FunctionExpression* f, const std::string& qualifier) {
+    auto table = f->table();
+    auto name = table_lookup_name(f->name());
+    auto n = table->n;
+
+    // Run-time tables are passed the location of their values.
+    std::string data = "data";
+    if (!table->runtime) {
+        // The last value is repeated, such that the upper end point needs no
+        // special treatment below.
+        data = name + "data_";
+        out << qualifier << " const arb_value_type " << data << "[" << n+2 << "] = {\n";
+        for (auto y: table->values) {
+            out << "    " << as_c_double(y) << ",\n";
+        }
+        out << "    " << as_c_double(table->values.back()) << "};\n\n";
+    }
+
+    out << qualifier << " inline arb_value_type " << name << "("
+        << (table->runtime? "const arb_value_type* data, ": "") << "arb_value_type x) {\n"
+        << "    arb_value_type u = (x - " << as_c_double(table->from) << ")*"
+        << as_c_double(n/(table->to - table->from)) << ";\n"
+        << "    u = u > 0? u: 0;\n"
+        << "    u = u < " << n << "? u: " << n << ";\n"
+        << "    int i = (int)u;\n"
+        << "    arb_value_type w = u - i;\n"
+        << "    return " << data << "[i] + w*(" << data << "[i+1] - " << data << "[i]);\n"
+        << "}\n\n";
+}
+
+ARB_LIBMODCC_API std::string table_lookup_open(FunctionExpression* f) {
+    auto call = table_lookup_name(f->name()) + "(";
+    if (f->table()->runtime) {
+        call += pp_var_pfx + "tables+" + std::to_string(f->table()->offset) + ", ";
+    }
+    return call;
+}
+
+ARB_LIBMODCC_API bool is_additive_net_receive(APIMethod* net_receive) {
+    if (!net_receive || net_receive->args().size()!=1) return false;
+    auto weight = net_receive->args().front()->is_argument()->name();
+
+    std::vector<std::pair<std::string, Expression*>> updates;
+    identifier_set written = {weight};
+    for (auto& s: net_receive->body()->statements()) {
+        auto a = s->is_assignment();
+        auto id = a? a->lhs()->is_identifier(): nullptr;
+        auto var = id && id->symbol()? id->symbol()->is_variable(): nullptr;
+        if (!var || !var->is_range()) return false;
+
+        auto name = var->name();
+        if (std::count(written.begin(), written.end(), name)) return false;
+        written.push_back(name);
+        updates.push_back({name, a->rhs()});
+    }
+
+    for (auto& [name, rhs]: updates) {
+        auto r = linear_test(rhs, {name, weight});
+        if (!r.is_linear || !r.is_homogeneous) return false;
+        if (!r.coef.count(name) || expr_value(r.coef[name])!=1) return false;
+        if (!r.coef.count(weight) || involves_identifier(r.coef[weight], written)) return false;
+    }
+    return !updates.empty();
+}
+
 ARB_LIBMODCC_API APIMethod* find_api_method(const Module& m, const char* which) {
     auto it = m.symbols().find(which);
     return  it==m.symbols().end()? nullptr: it->second->is_api_method();
@@ -119,6 +119,32 @@ ARB_LIBMODCC_API module_variables_t local_module_variables(const Module&);
 
 ARB_LIBMODCC_API std::vector<ProcedureExpression*> module_normal_procedures(const Module& m);
 
+// FUNCTIONs evaluated by table lookup in any of the API methods, sorted by
+// name.
+
+ARB_LIBMODCC_API std::vector<FunctionExpression*> tabulated_functions(const Module& m);
+
+// Emit the sampled values of a tabulated function and a scalar lookup
+// `<name>_table_(x)` interpolating linearly between them. Arguments outside
+// of the table are clamped to its end points. Both declarations are prefixed
+// with `qualifier`, e.g. `static`. Tables sampled at run time have no values
+// to emit; their lookup takes the location of the values as first argument,
+// `<name>_table_(data, x)`.
+
+ARB_LIBMODCC_API void emit_table_lookup(std::ostream& out, FunctionExpression* f, const std::string& qualifier);
+
+// The start of a call to the lookup of f, up to its argument x, e.g.
+// `f_table_(` or `f_table_(_pp_var_tables+12, `.
+
+ARB_LIBMODCC_API std::string table_lookup_open(FunctionExpression* f);
+
+// True if the NET_RECEIVE API method only has statements `x = x + c*weight`,
+// each writing a different range variable x, where c depends on neither the
+// weight nor the variables written. Then several events for an instance act
+// like a single event with the summed weight.
+
+ARB_LIBMODCC_API bool is_additive_net_receive(APIMethod* net_receive);
+
 // Extract key procedures from module.
 
 ARB_LIBMODCC_API APIMethod* find_api_method(const Module& m, const char* which);
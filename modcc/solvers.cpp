@@ -937,22 +937,36 @@ void SparseNonlinearSolverVisitor::finalize() {
     // Row by row:
     // Generate entries of the system and declare and assign as local variables
     // Generate normalizing terms and normalize the row
-    std::vector<expression_ptr> S_;
+    //
+    // Each row ends with its entry in the augmented column, which depends on
+    // F(xn). If the Jacobian is reused, these updates are kept in R_ and
+    // repeated in every iteration, while the reduction of J in S_ is done once.
+    bool reuse = newton_.reuse_jacobian;
+    std::vector<expression_ptr> S_, R_;
+    auto append = [&](std::vector<expression_ptr>& updates) {
+        for (unsigned k = 0; k < updates.size(); ++k) {
+            bool rhs = reuse && k+1 == updates.size();
+            (rhs? R_: S_).push_back(std::move(updates[k]));
+        }
+    };
     for (auto& row: row_symbols) {
         auto entries = system_.generate_row_updates(block_scope_, row);
+        std::vector<expression_ptr> updates;
         for (auto& l: entries) {
             statements_.push_back(std::move(l.local_decl));
-            S_.push_back(std::move(l.assignment));
+            updates.push_back(std::move(l.assignment));
         }
+        append(updates);
 
         // If size of system > 5 normalize the row updates
         if (system_.size() > 5) {
-            auto norm_term = system_.generate_normalizing_term(block_scope_, row);
+            std::vector<symge::symbol> lhs(row.begin(), reuse? row.end()-1: row.end());
+            auto norm_term = system_.generate_normalizing_term(block_scope_, lhs);
             auto norm_assigns = system_.generate_normalizing_assignments(norm_term.id->clone(), row);
 
             statements_.push_back(std::move(norm_term.local_decl));
             S_.push_back(std::move(norm_term.assignment));
-            std::move(std::begin(norm_assigns), std::end(norm_assigns), std::back_inserter(S_));
+            append(norm_assigns);
         }
     }
 
@@ -968,21 +982,25 @@ void SparseNonlinearSolverVisitor::finalize() {
                 make_expression<SubBinaryExpression>(u->location(), lhs->clone(), rhs->clone()));
     }
 
-    // Do 3 Newton iterations
-    for (unsigned n = 0; n < 3; n++) {
-        // Print out the statements that calulate F(xn), J(xn), solve J(xn)^-1*F(xn), update xn -> xn+1
-        for (auto &s: F_) {
-            statements_.push_back(s->clone());
-        }
-        for (auto &s: J_) {
-            statements_.push_back(s->clone());
-        }
-        for (auto &s: S_) {
-            statements_.push_back(s->clone());
-        }
-        for (auto &s: U_) {
-            statements_.push_back(s->clone());
+    auto emit = [this](const std::vector<expression_ptr>& stmts) {
+        for (auto& s: stmts) statements_.push_back(s->clone());
+    };
+
+    // Do a fixed number of Newton iterations: calculate F(xn) and J(xn),
+    // solve J(xn)^-1*F(xn), and update xn -> xn+1. A reused Jacobian is
+    // calculated and reduced at x0 only.
+    if (reuse) {
+        emit(J_);
+        emit(S_);
+    }
+    for (unsigned n = 0; n < newton_.iterations; n++) {
+        emit(F_);
+        if (!reuse) {
+            emit(J_);
+            emit(S_);
         }
+        emit(R_);
+        emit(U_);
     }
 
     Location loc;
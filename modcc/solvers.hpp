@@ -210,10 +210,12 @@ protected:
     // System Solver helper
     SystemSolver system_;
 
+    NewtonSpec newton_;
+
 public:
     using SolverVisitorBase::visit;
 
-    SparseNonlinearSolverVisitor() {}
+    explicit SparseNonlinearSolverVisitor(NewtonSpec newton = {}): newton_(newton) {}
     SparseNonlinearSolverVisitor(scope_ptr enclosing): SolverVisitorBase(enclosing) {}
 
     virtual void visit(BlockExpression* e) override;
@@ -60,6 +60,9 @@ static Keyword keywords[] = {
     {"STEADYSTATE",         tok::steadystate},
     {"FROM",                tok::from},
     {"TO",                  tok::to},
+    {"TABLE",               tok::table},
+    {"DEPEND",              tok::depend},
+    {"WITH",                tok::with},
     {"if",                  tok::if_stmt},
     {"IF",                  tok::if_stmt},
     {"else",                tok::else_stmt},
@@ -152,6 +155,9 @@ static TokenString token_strings[] = {
     {"COMPARTMENT",         tok::compartment},
     {"METHOD",              tok::method},
     {"STEADYSTATE",         tok::steadystate},
+    {"TABLE",               tok::table},
+    {"DEPEND",              tok::depend},
+    {"WITH",                tok::with},
     {"if",                  tok::if_stmt},
     {"else",                tok::else_stmt},
     {"eof",                 tok::eof},
@@ -66,6 +66,7 @@ enum class tok {
     threadsafe, global,
     point_process, junction_process, voltage_process,
     from, to,
+    table, depend, with,
 
     // prefix binary operators
     min, max,
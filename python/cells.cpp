@@ -235,26 +235,31 @@ void register_cells(py::module& m) {
 
     benchmark_cell
         .def(py::init<>(
-            [](arb::cell_tag_type source_label, arb::cell_tag_type target_label, const regular_schedule_shim& sched, double ratio){
-                return arb::benchmark_cell{std::move(source_label), std::move(target_label), sched.schedule(), ratio};}),
-            "source_label"_a, "target_label"_a,"schedule"_a, "realtime_ratio"_a=1.0,
+            [](arb::cell_tag_type source_label, arb::cell_tag_type target_label, const regular_schedule_shim& sched, double ratio, bool busy_wait){
+                return arb::benchmark_cell{std::move(source_label), std::move(target_label), sched.schedule(), ratio, busy_wait};}),
+            "source_label"_a, "target_label"_a,"schedule"_a, "realtime_ratio"_a=1.0, "busy_wait"_a=true,
             "Construct a benchmark cell that generates spikes on 'source_label' at regular intervals.\n"
             "The cell has one source labeled 'source_label', and one target labeled 'target_label'.")
         .def(py::init<>(
-            [](arb::cell_tag_type source_label, arb::cell_tag_type target_label, const explicit_schedule_shim& sched, double ratio){
-                return arb::benchmark_cell{std::move(source_label), std::move(target_label),sched.schedule(), ratio};}),
-            "source_label"_a, "target_label"_a, "schedule"_a, "realtime_ratio"_a=1.0,
+            [](arb::cell_tag_type source_label, arb::cell_tag_type target_label, const explicit_schedule_shim& sched, double ratio, bool busy_wait){
+                return arb::benchmark_cell{std::move(source_label), std::move(target_label),sched.schedule(), ratio, busy_wait};}),
+            "source_label"_a, "target_label"_a, "schedule"_a, "realtime_ratio"_a=1.0, "busy_wait"_a=true,
             "Construct a benchmark cell that generates spikes on 'source_label' at a sequence of user-defined times.\n"
             "The cell has one source labeled 'source_label', and one target labeled 'target_label'.")
         .def(py::init<>(
-            [](arb::cell_tag_type source_label, arb::cell_tag_type target_label, const poisson_schedule_shim& sched, double ratio){
-                return arb::benchmark_cell{std::move(source_label), std::move(target_label), sched.schedule(), ratio};}),
-            "source_label"_a, "target_label"_a, "schedule"_a, "realtime_ratio"_a=1.0,
+            [](arb::cell_tag_type source_label, arb::cell_tag_type target_label, const poisson_schedule_shim& sched, double ratio, bool busy_wait){
+                return arb::benchmark_cell{std::move(source_label), std::move(target_label), sched.schedule(), ratio, busy_wait};}),
+            "source_label"_a, "target_label"_a, "schedule"_a, "realtime_ratio"_a=1.0, "busy_wait"_a=true,
             "Construct a benchmark cell that generates spikeson 'source_label' at times defined by a Poisson sequence.\n"
             "The cell has one source labeled 'source_label', and one target labeled 'target_label'.")
+        .def_readwrite("busy_wait", &arb::benchmark_cell::busy_wait,
+            "Emulate the cost by spinning if true, else only add it to benchmark_modelled_time().")
         .def("__repr__", [](const arb::benchmark_cell&){return "<arbor.benchmark_cell>";})
         .def("__str__",  [](const arb::benchmark_cell&){return "<arbor.benchmark_cell>";});
 
+    m.def("benchmark_modelled_time", &arb::benchmark_modelled_time,
+          "Modelled cost in seconds of the benchmark cells with busy_wait unset advanced by this process.");
+
     lif_cell
         .def(py::init<>(
             [](arb::cell_tag_type source_label,
@@ -41,11 +41,8 @@ pybind11::dict config() {
 #else
     dict[pybind11::str("vectorize")] = pybind11::bool_(false);
 #endif
-#ifdef ARB_PROFILE_ENABLED
+    // The profiler is always built, and switched on by profiler_initialize.
     dict[pybind11::str("profiling")] = pybind11::bool_(true);
-#else
-    dict[pybind11::str("profiling")] = pybind11::bool_(false);
-#endif
     dict[pybind11::str("neuroml")] = pybind11::bool_(true);
 #ifdef ARB_BUNDLED_ENABLED
     dict[pybind11::str("bundled")] = pybind11::bool_(true);
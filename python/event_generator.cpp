@@ -5,8 +5,10 @@
 #include <arbor/common_types.hpp>
 #include <arbor/schedule.hpp>
 
+#include "error.hpp"
 #include "event_generator.hpp"
 #include "schedule.hpp"
+#include "strprintf.hpp"
 
 namespace pyarb {
 
@@ -15,6 +17,14 @@ void register_event_generators(pybind11::module& m) {
 
     pybind11::class_<event_generator_shim> event_generator(m, "event_generator");
 
+    // Accessors for the target and weight of a generator with a single target.
+    auto single = [](event_generator_shim& g) -> event_generator_shim::target_weight& {
+        if (g.targets.size()!=1) {
+            throw pyarb_error(util::pprintf("event_generator has {} targets, use targets instead", g.targets.size()));
+        }
+        return g.targets.front();
+    };
+
     event_generator
         .def(pybind11::init<>(
             [](arb::cell_local_label_type target, double weight, const schedule_shim_base& sched) {
@@ -24,10 +34,23 @@ void register_event_generators(pybind11::module& m) {
             "  target: The target synapse label and selection policy.\n"
             "  weight: The weight of events to deliver.\n"
             "  sched:  A schedule of the events.")
-        .def_readwrite("target", &event_generator_shim::target,
-             "The target synapse (gid, local_id).")
-        .def_readwrite("weight", &event_generator_shim::weight,
-             "The weight of events to deliver.")
+        .def(pybind11::init<>(
+            [](std::vector<event_generator_shim::target_weight> targets, const schedule_shim_base& sched) {
+                return event_generator_shim(std::move(targets), sched.schedule()); }),
+            "targets"_a, "sched"_a,
+            "Construct an event generator delivering each event to several targets, with arguments:\n"
+            "  targets: A list of (target, weight) pairs of synapse labels and the weights of events to deliver.\n"
+            "  sched:   A schedule of the events.")
+        .def_property("target",
+            [single](event_generator_shim& g) { return single(g).first; },
+            [single](event_generator_shim& g, arb::cell_local_label_type target) { single(g).first = std::move(target); },
+            "The target synapse label and selection policy of a generator with a single target.")
+        .def_property("weight",
+            [single](event_generator_shim& g) { return single(g).second; },
+            [single](event_generator_shim& g, float weight) { single(g).second = weight; },
+            "The weight of events to deliver of a generator with a single target.")
+        .def_readwrite("targets", &event_generator_shim::targets,
+             "The list of (target, weight) pairs events are delivered to.")
         .def("__str__", [](const event_generator_shim&){return "<arbor.event_generator>";})
         .def("__repr__", [](const event_generator_shim&){return "<arbor.event_generator>";});
 }
@@ -1,20 +1,32 @@
 #pragma once
 
+#include <vector>
+
 #include <arbor/common_types.hpp>
+#include <arbor/event_generator.hpp>
 #include <arbor/schedule.hpp>
 
 namespace pyarb {
 
 struct event_generator_shim {
-    arb::cell_local_label_type target;
-    double weight;
+    using target_weight = arb::event_generator::target_weight;
+
+    std::vector<target_weight> targets;
     arb::schedule time_sched;
 
     event_generator_shim(arb::cell_local_label_type event_target, double event_weight, arb::schedule sched):
-        target(std::move(event_target)),
-        weight(event_weight),
+        targets{{std::move(event_target), event_weight}},
+        time_sched(std::move(sched))
+    {}
+
+    event_generator_shim(std::vector<target_weight> event_targets, arb::schedule sched):
+        targets(std::move(event_targets)),
         time_sched(std::move(sched))
     {}
+
+    arb::event_generator generator() const {
+        return arb::event_generator(targets, time_sched);
+    }
 };
 
 } // namespace pyarb
@@ -200,6 +200,35 @@ void register_mechanisms(pybind11::module& m) {
     m.def("bbp_catalogue", [](){return arb::global_bbp_catalogue();});
     m.def("stochastic_catalogue", [](){return arb::global_stochastic_catalogue();});
     m.def("load_catalogue", [](pybind11::object fn) { return arb::load_catalogue(util::to_string(fn)); });
+    m.def("compile_catalogue",
+          [](const std::vector<std::string>& sources,
+             std::optional<pybind11::object> modcc,
+             std::optional<pybind11::object> cxx,
+             std::optional<std::vector<std::string>> modcc_flags,
+             std::optional<std::vector<std::string>> cxx_flags,
+             std::optional<std::vector<pybind11::object>> include_dirs,
+             std::optional<pybind11::object> cache_dir) {
+              arb::compile_catalogue_options opt;
+              if (modcc) opt.modcc = util::to_path(*modcc);
+              if (cxx) opt.cxx = util::to_path(*cxx);
+              if (modcc_flags) opt.modcc_flags = *modcc_flags;
+              if (cxx_flags) opt.cxx_flags = *cxx_flags;
+              if (include_dirs) {
+                  for (const auto& d: *include_dirs) opt.include_dirs.push_back(util::to_path(d));
+              }
+              if (cache_dir) opt.cache_dir = util::to_path(*cache_dir);
+              return arb::compile_catalogue(sources, opt);
+          },
+          "sources"_a,
+          pybind11::kw_only(),
+          "modcc"_a=pybind11::none(),
+          "cxx"_a=pybind11::none(),
+          "modcc_flags"_a=pybind11::none(),
+          "cxx_flags"_a=pybind11::none(),
+          "include_dirs"_a=pybind11::none(),
+          "cache_dir"_a=pybind11::none(),
+          "Compile a catalogue from a list of NMODL sources for the host CPU.\n"
+          "The shared object is cached; unset options select the tools of the arbor installation.");
 
     // arb::mechanism_desc
     // For specifying a mechanism in the cable_cell interface.
@@ -138,6 +138,33 @@ struct recorder_cable_vector_point_info: recorder_cable_vector<std::vector<arb::
         recorder_cable_vector(meta_ptr, std::ptrdiff_t(meta_ptr->size())) {}
 };
 
+struct recorder_cable_vector_mpoint: recorder_cable_vector<std::vector<arb::mpoint>> {
+    explicit recorder_cable_vector_mpoint(const std::vector<arb::mpoint>* meta_ptr):
+        recorder_cable_vector(meta_ptr, std::ptrdiff_t(meta_ptr->size())) {}
+};
+
+// Reductions are scalar, or one value per bin for histograms.
+struct recorder_cable_reduction: recorder_base<arb::cable_probe_reduction_info> {
+    explicit recorder_cable_reduction(const arb::cable_probe_reduction_info* meta_ptr):
+        recorder_base(meta_ptr, meta_ptr->edges.empty()? 1: std::ptrdiff_t(meta_ptr->edges.size()-1)) {}
+
+    void record(any_ptr, std::size_t n_sample, const arb::sample_record* records) override {
+        for (std::size_t i = 0; i<n_sample; ++i) {
+            if (auto* v_ptr = any_cast<const double*>(records[i].data)) {
+                sample_raw_.push_back(records[i].time);
+                sample_raw_.push_back(*v_ptr);
+            }
+            else if (auto* r_ptr = any_cast<const arb::cable_sample_range*>(records[i].data)) {
+                sample_raw_.push_back(records[i].time);
+                sample_raw_.insert(sample_raw_.end(), r_ptr->first, r_ptr->second);
+            }
+            else {
+                throw arb::arbor_internal_error("unexpected sample type");
+            }
+        }
+    }
+};
+
 // Helper for registering sample recorder factories and (trivial) metadata conversions.
 
 template <typename Meta, typename Recorder>
@@ -179,6 +206,26 @@ arb::probe_info cable_probe_total_current_cell(const std::string& tag) {
     return {arb::cable_probe_total_current_cell{}, tag};
 }
 
+arb::probe_info cable_probe_extracellular_potential(const std::vector<arb::mpoint>& electrodes, double sigma, const std::string& tag, double cutoff) {
+    return {arb::cable_probe_extracellular_potential{electrodes, sigma, cutoff}, tag};
+}
+
+arb::probe_info cable_probe_membrane_voltage_mean(const char* where, const std::string& tag) {
+    return {arb::cable_probe_membrane_voltage_mean{arborio::parse_region_expression(where).unwrap()}, tag};
+}
+
+arb::probe_info cable_probe_membrane_voltage_histogram(const char* where, const std::vector<double>& edges, const std::string& tag) {
+    return {arb::cable_probe_membrane_voltage_histogram{arborio::parse_region_expression(where).unwrap(), edges}, tag};
+}
+
+arb::probe_info cable_probe_total_ion_current_sum(const char* where, const std::string& tag) {
+    return {arb::cable_probe_total_ion_current_sum{arborio::parse_region_expression(where).unwrap()}, tag};
+}
+
+arb::probe_info cable_probe_point_state_sum(const char* mechanism, const char* state, const std::string& tag) {
+    return {arb::cable_probe_point_state_sum{mechanism, state}, tag};
+}
+
 arb::probe_info cable_probe_stimulus_current_cell(const std::string& tag) {
     return {arb::cable_probe_stimulus_current_cell{}, tag};
 }
@@ -267,6 +314,20 @@ void register_cable_probes(pybind11::module& m, pyarb_global_ptr global_ptr) {
         .def("__repr__",[](arb::cable_probe_point_info m) {
             return pprintf("<arbor.cable_probe_point_info: target {}, multiplicity {}, location {}>", m.target, m.multiplicity, m.loc);});
 
+    py::class_<arb::cable_probe_reduction_info> cable_probe_reduction_info(m,
+                                                                           "cable_probe_reduction_info",
+                                                                           "Probe metadata associated with a cable cell reduction probe.");
+
+    cable_probe_reduction_info
+        .def_readonly("cables", &arb::cable_probe_reduction_info::cables,
+            "Cables of the membrane contributing to the reduction.")
+        .def_readonly("points", &arb::cable_probe_reduction_info::points,
+            "Point process instances contributing to the reduction.")
+        .def_readonly("edges", &arb::cable_probe_reduction_info::edges,
+            "Histogram bin edges; empty for scalar reductions.")
+        .def("__repr__",[](const arb::cable_probe_reduction_info& m) {
+            return pprintf("<arbor.cable_probe_reduction_info: {} cables, {} points, {} edges>", m.cables.size(), m.points.size(), m.edges.size());});
+
     // Probe address constructors:
 
     m.def("lif_probe_voltage", &lif_probe_voltage,
@@ -292,6 +353,12 @@ void register_cable_probes(pybind11::module& m, pyarb_global_ptr global_ptr) {
           &cable_probe_total_current_cell,
           "Probe specification for cable cell total transmembrane current for each cable in each CV.",
           "tag"_a);
+    m.def("cable_probe_extracellular_potential",
+          &cable_probe_extracellular_potential,
+          "Probe specification for the extracellular potential [mV] at electrode positions [μm] due to the total\n"
+          "transmembrane current of the cell, treating each CV as a line source in a medium of conductivity sigma [S/m].\n"
+          "The currents of CVs whose transfer to an electrode is below cutoff times the largest one are ignored.",
+          "electrodes"_a, "sigma"_a, "tag"_a, "cutoff"_a=0.);
     m.def("cable_probe_stimulus_current_cell",
           &cable_probe_stimulus_current_cell,
           "Probe specification for cable cell stimulus current across each cable in each CV.",
@@ -345,12 +412,32 @@ void register_cable_probes(pybind11::module& m, pyarb_global_ptr global_ptr) {
           "Probe specification for cable cell external ionic concentration for each cable in each CV.",
           "ion"_a, "tag"_a);
 
+    m.def("cable_probe_membrane_voltage_mean",
+          &cable_probe_membrane_voltage_mean,
+          "Probe specification for cable cell membrane voltage averaged over the membrane area of a region.",
+          "where"_a, "tag"_a);
+    m.def("cable_probe_membrane_voltage_histogram",
+          &cable_probe_membrane_voltage_histogram,
+          "Probe specification for the fraction of the membrane area of a region with membrane voltage in each bin\n"
+          "[edges[i], edges[i+1]).",
+          "where"_a, "edges"_a, "tag"_a);
+    m.def("cable_probe_total_ion_current_sum",
+          &cable_probe_total_ion_current_sum,
+          "Probe specification for cable cell total ionic current across the membrane of a region.",
+          "where"_a, "tag"_a);
+    m.def("cable_probe_point_state_sum",
+          &cable_probe_point_state_sum,
+          "Probe specification for a cable cell point mechanism state variable summed over all instances on the cell.",
+          "mechanism"_a, "state"_a, "tag"_a);
+
     // Add probe metadata to maps for converters and recorders.
 
     register_probe_meta_maps<arb::mlocation, recorder_cable_scalar_mlocation>(global_ptr);
     register_probe_meta_maps<arb::cable_probe_point_info, recorder_cable_scalar_point_info>(global_ptr);
     register_probe_meta_maps<arb::mcable_list, recorder_cable_vector_mcable>(global_ptr);
     register_probe_meta_maps<std::vector<arb::cable_probe_point_info>, recorder_cable_vector_point_info>(global_ptr);
+    register_probe_meta_maps<std::vector<arb::mpoint>, recorder_cable_vector_mpoint>(global_ptr);
+    register_probe_meta_maps<arb::cable_probe_reduction_info, recorder_cable_reduction>(global_ptr);
     register_probe_meta_maps<arb::lif_probe_metadata, recorder_lif>(global_ptr);
 }
 
@@ -53,10 +53,13 @@ void register_profiler(pybind11::module& m) {
         .def("__str__",  [](arb::profile::meter_report& r){return util::pprintf("{}", r);})
         .def("__repr__", [](arb::profile::meter_report& r){return "<arbor.meter_report>";});
 
-#ifdef ARB_PROFILE_ENABLED
-    m.def("profiler_initialize", [](context_shim& ctx) {
-        arb::profile::profiler_initialize(ctx.context);
-    });
+    m.def("profiler_initialize",
+          [](context_shim& ctx, bool counters, bool trace, std::size_t trace_capacity) {
+              arb::profile::profiler_initialize(ctx.context, {counters, trace, trace_capacity});
+          },
+          "context"_a, "counters"_a=false, "trace"_a=false, "trace_capacity"_a=arb::profile::profiler_options{}.trace_capacity,
+          "Initialize the profiler. Optionally record hardware counters per region (Linux on x86-64 only),\n"
+          "and a trace of the last trace_capacity regions on each thread.");
     m.def("profiler_summary",
           [](double limit){
               std::stringstream stream;
@@ -65,7 +68,13 @@ void register_profiler(pybind11::module& m) {
           },
           "limit"_a=0.0,
           "Show summary of the profile; printing contributions above `limit` percent. Defaults to showing all.");
-#endif
+    m.def("profiler_trace",
+          [](){
+              std::stringstream stream;
+              arb::profile::write_profiler_trace(stream);
+              return stream.str();
+          },
+          "Return the recorded trace in the Chrome trace event format, as read by Perfetto.");
 }
 
 } // namespace pyarb
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>
@@ -54,6 +57,21 @@ static arb::util::unique_any convert_cell(pybind11::object o) {
                       + "\" which does not describe a known Arbor cell type");
 }
 
+recipe_shim::recipe_shim(std::shared_ptr<::pyarb::recipe> r): impl_(std::move(r)) {
+    // The shim is constructed with the GIL released, see simulation.
+    pybind11::gil_scoped_acquire guard;
+    auto overridden = [&](const char* name) {
+        return bool(pybind11::get_override(static_cast<const ::pyarb::recipe*>(impl_.get()), name));
+    };
+    overrides_.cell_descriptions = overridden("cell_descriptions");
+    overrides_.event_generators = overridden("event_generators");
+    overrides_.connections_on = overridden("connections_on");
+    overrides_.external_connections_on = overridden("external_connections_on");
+    overrides_.gap_junctions_on = overridden("gap_junctions_on");
+    overrides_.probes = overridden("probes");
+    overrides_.cell_isometry = overridden("cell_isometry");
+}
+
 // The py::recipe::cell_decription returns a pybind11::object, that is
 // unwrapped and copied into a arb::util::unique_any.
  arb::util::unique_any recipe_shim::get_cell_description(arb::cell_gid_type gid) const {
@@ -64,6 +82,24 @@ static arb::util::unique_any convert_cell(pybind11::object o) {
         "Python error already thrown");
 }
 
+// As above, for all cells of a group while holding the GIL once.
+std::vector<arb::util::unique_any> recipe_shim::get_cell_descriptions(const std::vector<arb::cell_gid_type>& gids) const {
+    if (!overrides_.cell_descriptions) return {};
+    return try_catch_pyexception([&](){
+        pybind11::gil_scoped_acquire guard;
+        auto descriptions = impl_->cell_descriptions(pybind11::array_t<arb::cell_gid_type>(gids.size(), gids.data()));
+        std::vector<arb::util::unique_any> cells;
+        if (descriptions.is_none()) return cells;
+        cells.reserve(gids.size());
+        for (auto d: descriptions) cells.push_back(convert_cell(pybind11::reinterpret_borrow<pybind11::object>(d)));
+        if (cells.size() != gids.size()) {
+            throw pyarb_error(util::pprintf("recipe.cell_descriptions returned {} descriptions for {} cells", cells.size(), gids.size()));
+        }
+        return cells;
+    },
+        "Python error already thrown");
+}
+
 // Convert global properties inside a Python object to a
 // std::any, as required by the recipe interface.
 // This helper is only to called while holding the GIL, see above.
@@ -107,13 +143,14 @@ static std::vector<arb::event_generator> convert_gen(std::vector<pybind11::objec
         auto& p = cast<const pyarb::event_generator_shim&>(g);
 
         // convert the event_generator to an arb::event_generator
-        gens.push_back(arb::event_generator(p.target, p.weight, std::move(p.time_sched)));
+        gens.push_back(p.generator());
     }
 
     return gens;
 }
 
 std::vector<arb::event_generator> recipe_shim::event_generators(arb::cell_gid_type gid) const {
+    if (!overrides_.event_generators) return {};
     return try_catch_pyexception([&](){
         pybind11::gil_scoped_acquire guard;
         return convert_gen(impl_->event_generators(gid), gid);
@@ -131,6 +168,54 @@ std::string gj_to_string(const arb::gap_junction_connection& gc) {
          gc.peer.gid, gc.peer.label.tag, gc.peer.label.policy, gc.local.tag, gc.local.policy, gc.weight);
 }
 
+// Copy a one dimensional array, converting the element type if needed.
+template <typename T>
+std::vector<T> column_from_array(pybind11::object o, const char* name) {
+    using array_type = pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>;
+    auto a = array_type::ensure(o);
+    if (!a || a.ndim() != 1) throw pyarb_error(util::pprintf("connection_columns: {} must be a one dimensional array", name));
+    return {a.data(), a.data() + a.size()};
+}
+
+arb::connection_columns make_connection_columns(pybind11::object offsets,
+                                                pybind11::object source_gid,
+                                                pybind11::object source_label,
+                                                pybind11::object target_label,
+                                                pybind11::object weight,
+                                                pybind11::object delay,
+                                                pybind11::object source_policy,
+                                                pybind11::object target_policy) {
+    using policy_type = std::underlying_type_t<arb::lid_selection_policy>;
+    arb::connection_columns cols;
+    cols.offsets = column_from_array<std::size_t>(offsets, "offsets");
+    cols.source_gid = column_from_array<arb::cell_gid_type>(source_gid, "source_gid");
+    cols.source_label = column_from_array<arb::cell_size_type>(source_label, "source_label");
+    cols.target_label = column_from_array<arb::cell_size_type>(target_label, "target_label");
+    cols.weight = column_from_array<float>(weight, "weight");
+    cols.delay = column_from_array<float>(delay, "delay");
+    // Policies are given per connection or default to univalent.
+    auto policies = [&](pybind11::object o, const char* name) {
+        std::vector<arb::lid_selection_policy> result(cols.size(), arb::lid_selection_policy::assert_univalent);
+        if (o.is_none()) return result;
+        if (pybind11::isinstance<arb::lid_selection_policy>(o)) {
+            std::fill(result.begin(), result.end(), o.cast<arb::lid_selection_policy>());
+            return result;
+        }
+        result.clear();
+        constexpr auto max_policy = static_cast<policy_type>(arb::lid_selection_policy::assert_univalent);
+        for (auto p: column_from_array<policy_type>(o, name)) {
+            if (p < 0 || p > max_policy) {
+                throw pyarb_error(util::pprintf("connection_columns: {} contains {}, which is not a selection_policy", name, p));
+            }
+            result.push_back(arb::lid_selection_policy(p));
+        }
+        return result;
+    };
+    cols.source_policy = policies(source_policy, "source_policy");
+    cols.target_policy = policies(target_policy, "target_policy");
+    return cols;
+}
+
 void register_recipe(pybind11::module& m) {
     using namespace pybind11::literals;
 
@@ -180,6 +265,26 @@ void register_recipe(pybind11::module& m) {
         .def("__repr__", &con_to_string);
 
 
+    pybind11::class_<arb::connection_columns> connection_columns(m, "connection_columns",
+        "The connections on a contiguous range of cells in columnar form, as returned by recipe.connections_on_range.\n"
+        "  Labels are given as indices into the table returned by recipe.connection_label_table.");
+    connection_columns
+        .def(pybind11::init(&make_connection_columns),
+            "offsets"_a, "source_gid"_a, "source_label"_a, "target_label"_a, "weight"_a, "delay"_a,
+            "source_policy"_a=pybind11::none(), "target_policy"_a=pybind11::none(),
+            "Construct from one dimensional arrays, e.g. numpy arrays, with arguments:\n"
+            "  offsets:       The connections on the i-th cell of the range are [offsets[i], offsets[i+1]).\n"
+            "  source_gid:    The gids of the sources.\n"
+            "  source_label:  The source labels as indices into the label table.\n"
+            "  target_label:  The target labels as indices into the label table.\n"
+            "  weight:        The weights delivered to the target synapses.\n"
+            "  delay:         The delays of the connections [ms].\n"
+            "  source_policy: The selection policies of the sources, either one per connection or a single one (default: univalent).\n"
+            "  target_policy: The selection policies of the targets, either one per connection or a single one (default: univalent).")
+        .def("__len__", &arb::connection_columns::size)
+        .def("__str__",  [](const arb::connection_columns& c) { return util::pprintf("<arbor.connection_columns: {} connections>", c.size()); })
+        .def("__repr__", [](const arb::connection_columns& c) { return util::pprintf("<arbor.connection_columns: {} connections>", c.size()); });
+
     // Gap Junction Connections
     pybind11::class_<arb::gap_junction_connection> gap_junction_connection(m, "gap_junction_connection",
         "Describes a gap junction between two gap junction sites.");
@@ -211,6 +316,10 @@ void register_recipe(pybind11::module& m) {
         .def("cell_description", &recipe::cell_description, pybind11::return_value_policy::copy,
             "gid"_a,
             "High level description of the cell with global identifier gid.")
+        .def("cell_descriptions", &recipe::cell_descriptions,
+            "gids"_a,
+            "Optional: a list of the descriptions of the cells with the global identifiers in the array gids.\n"
+            "If provided, it is called once per cell group instead of cell_description.")
         .def("cell_kind",
              &recipe::cell_kind,
             "gid"_a,
@@ -222,6 +331,15 @@ void register_recipe(pybind11::module& m) {
              pybind11::call_guard<pybind11::gil_scoped_release>(),
             "gid"_a,
             "A list of all the incoming connections to gid, [] by default.")
+        .def("connection_label_table", &recipe::connection_label_table,
+            "The labels of connection end points referred to by connections_on_range, [] by default.\n"
+            "If not empty, connections are queried by connections_on_range instead of connections_on.")
+        .def("connections_on_range", &recipe::connections_on_range,
+            "gid_begin"_a, "gid_end"_a,
+            "The incoming connections to the cells [gid_begin, gid_end) as connection_columns.")
+        .def("connectivity_fingerprint", &recipe::connectivity_fingerprint,
+            "An integer identifying all connections, None by default. If given, the connection table\n"
+            "may be cached by the simulation; it must change whenever the connections do.")
         .def("external_connections_on", &recipe::external_connections_on,
             "gid"_a,
             "A list of all the incoming connections from _remote_ locations to gid, [] by default.")
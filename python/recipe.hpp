@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <optional>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>
@@ -35,12 +37,26 @@ public:
     virtual pybind11::object cell_description(arb::cell_gid_type gid) const = 0;
     virtual arb::cell_kind cell_kind(arb::cell_gid_type gid) const = 0;
 
+    // Optional batched query, returns a list of descriptions for an array of gids.
+    virtual pybind11::object cell_descriptions(pybind11::array_t<arb::cell_gid_type> gids) const {
+        return pybind11::none();
+    }
+
     virtual std::vector<pybind11::object> event_generators(arb::cell_gid_type gid) const {
         return {};
     }
     virtual std::vector<arb::cell_connection> connections_on(arb::cell_gid_type gid) const {
         return {};
     }
+    virtual std::vector<arb::cell_tag_type> connection_label_table() const {
+        return {};
+    }
+    virtual arb::connection_columns connections_on_range(arb::cell_gid_type gid_begin, arb::cell_gid_type gid_end) const {
+        return {};
+    }
+    virtual std::optional<std::uint64_t> connectivity_fingerprint() const {
+        return std::nullopt;
+    }
     virtual std::vector<arb::ext_cell_connection> external_connections_on(arb::cell_gid_type gid) const {
         return {};
     }
@@ -71,6 +87,10 @@ public:
         PYBIND11_OVERRIDE_PURE(pybind11::object, recipe, cell_description, gid);
     }
 
+    pybind11::object cell_descriptions(pybind11::array_t<arb::cell_gid_type> gids) const override {
+        PYBIND11_OVERRIDE(pybind11::object, recipe, cell_descriptions, gids);
+    }
+
     arb::cell_kind cell_kind(arb::cell_gid_type gid) const override {
         try {
             PYBIND11_OVERRIDE_PURE(arb::cell_kind, recipe, cell_kind, gid);
@@ -88,6 +108,18 @@ public:
         PYBIND11_OVERRIDE(std::vector<arb::cell_connection>, recipe, connections_on, gid);
     }
 
+    std::vector<arb::cell_tag_type> connection_label_table() const override {
+        PYBIND11_OVERRIDE(std::vector<arb::cell_tag_type>, recipe, connection_label_table);
+    }
+
+    arb::connection_columns connections_on_range(arb::cell_gid_type gid_begin, arb::cell_gid_type gid_end) const override {
+        PYBIND11_OVERRIDE(arb::connection_columns, recipe, connections_on_range, gid_begin, gid_end);
+    }
+
+    std::optional<std::uint64_t> connectivity_fingerprint() const override {
+        PYBIND11_OVERRIDE(std::optional<std::uint64_t>, recipe, connectivity_fingerprint);
+    }
+
     std::vector<arb::ext_cell_connection> external_connections_on(arb::cell_gid_type gid) const override {
         PYBIND11_OVERRIDE(std::vector<arb::ext_cell_connection>, recipe, external_connections_on, gid);
     }
@@ -118,15 +150,29 @@ public:
 // to arb::recipe.
 // For example, unwrap cell descriptions stored in PyObject, and rewrap
 // in util::unique_any.
+//
+// Optional queries per gid which the python recipe does not override are
+// answered without taking the GIL.
 
 class recipe_shim: public ::arb::recipe {
     // pointer to the python recipe implementation
     std::shared_ptr<::pyarb::recipe> impl_;
 
+    // Optional methods overridden in python.
+    struct overrides {
+        bool cell_descriptions = true;
+        bool event_generators = true;
+        bool connections_on = true;
+        bool external_connections_on = true;
+        bool gap_junctions_on = true;
+        bool probes = true;
+        bool cell_isometry = true;
+    } overrides_;
+
 public:
     using ::arb::recipe::recipe;
 
-    recipe_shim(std::shared_ptr<::pyarb::recipe> r): impl_(std::move(r)) {}
+    recipe_shim(std::shared_ptr<::pyarb::recipe> r);
 
     const char* msg = "Python error already thrown";
 
@@ -138,6 +184,9 @@ public:
     // unwrapped and copied into a util::unique_any.
     arb::util::unique_any get_cell_description(arb::cell_gid_type gid) const override;
 
+    // Descriptions of a cell group in a single call, if the python recipe provides cell_descriptions.
+    std::vector<arb::util::unique_any> get_cell_descriptions(const std::vector<arb::cell_gid_type>& gids) const override;
+
     arb::cell_kind get_cell_kind(arb::cell_gid_type gid) const override {
         return try_catch_pyexception([&](){ return impl_->cell_kind(gid); }, msg);
     }
@@ -145,18 +194,34 @@ public:
     std::vector<arb::event_generator> event_generators(arb::cell_gid_type gid) const override;
 
     std::vector<arb::cell_connection> connections_on(arb::cell_gid_type gid) const override {
+        if (!overrides_.connections_on) return {};
         return try_catch_pyexception([&](){ return impl_->connections_on(gid); }, msg);
     }
 
+    std::vector<arb::cell_tag_type> connection_label_table() const override {
+        return try_catch_pyexception([&](){ return impl_->connection_label_table(); }, msg);
+    }
+
+    arb::connection_columns connections_on_range(arb::cell_gid_type gid_begin, arb::cell_gid_type gid_end) const override {
+        return try_catch_pyexception([&](){ return impl_->connections_on_range(gid_begin, gid_end); }, msg);
+    }
+
+    std::optional<std::uint64_t> connectivity_fingerprint() const override {
+        return try_catch_pyexception([&](){ return impl_->connectivity_fingerprint(); }, msg);
+    }
+
     std::vector<arb::ext_cell_connection> external_connections_on(arb::cell_gid_type gid) const override {
+        if (!overrides_.external_connections_on) return {};
         return try_catch_pyexception([&](){ return impl_->external_connections_on(gid); }, msg);
     }
 
     std::vector<arb::gap_junction_connection> gap_junctions_on(arb::cell_gid_type gid) const override {
+        if (!overrides_.gap_junctions_on) return {};
         return try_catch_pyexception([&](){ return impl_->gap_junctions_on(gid); }, msg);
     }
 
     std::vector<arb::probe_info> get_probes(arb::cell_gid_type gid) const override {
+        if (!overrides_.probes) return {};
         return try_catch_pyexception([&](){ return impl_->probes(gid); }, msg);
     }
 
@@ -167,6 +232,7 @@ public:
     };
 
     arb::isometry get_cell_isometry(arb::cell_gid_type gid) const override {
+        if (!overrides_.cell_isometry) return {};
         return try_catch_pyexception([&]() { return impl_->cell_isometry(gid); }, msg);
     };
 };
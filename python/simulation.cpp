@@ -60,11 +60,12 @@ class simulation_shim {
     std::unordered_map<arb::sampler_association_handle, sampler_callback> sampler_map_;
 
 public:
-    simulation_shim(std::shared_ptr<recipe>& rec, const context_shim& ctx, const arb::domain_decomposition& decomp, std::uint64_t seed, pyarb_global_ptr global_ptr):
+    simulation_shim(std::shared_ptr<recipe>& rec, const context_shim& ctx, const arb::domain_decomposition& decomp, std::uint64_t seed,
+                    const std::string& connection_cache, pyarb_global_ptr global_ptr):
         global_ptr_(global_ptr)
     {
         try {
-            sim_.reset(new arb::simulation(recipe_shim(rec), ctx.context, decomp, seed));
+            sim_.reset(new arb::simulation(recipe_shim(rec), ctx.context, decomp, seed, connection_cache));
         }
         catch (...) {
             py_reset_and_throw();
@@ -82,6 +83,14 @@ public:
         }
     }
 
+    void update_connections(const std::vector<std::pair<arb::cell_gid_type, arb::cell_connection>>& added,
+                            const std::vector<std::tuple<arb::cell_gid_type, arb::cell_global_label_type, arb::cell_local_label_type>>& removed) {
+        arb::connection_delta delta;
+        for (const auto& [gid, conn]: added) delta.add(gid, conn);
+        for (const auto& [gid, source, target]: removed) delta.remove(gid, source, target);
+        sim_->update_connections(delta);
+    }
+
 
     std::string serialize() {
         arborio::json_serdes writer;
@@ -222,11 +231,12 @@ void register_simulation(py::module& m, pyarb_global_ptr global_ptr) {
                  [global_ptr](std::shared_ptr<recipe>& rec,
                               std::optional<std::shared_ptr<context_shim>> ctx_,
                               std::optional<arb::domain_decomposition> decomp,
-                              std::uint64_t seed) {
+                              std::uint64_t seed,
+                              std::optional<std::string> connection_cache) {
                      try {
                          auto ctx = ctx_.value_or(std::make_shared<context_shim>(make_context_shim()));
                          auto dec = decomp.value_or(arb::partition_load_balance(recipe_shim(rec), ctx->context));
-                         return new simulation_shim(rec, *ctx, dec, seed, global_ptr);
+                         return new simulation_shim(rec, *ctx, dec, seed, connection_cache.value_or(""), global_ptr);
                      }
                      catch (...) {
                          py_reset_and_throw();
@@ -239,9 +249,12 @@ void register_simulation(py::module& m, pyarb_global_ptr global_ptr) {
              "context"_a=py::none(),
              "domains"_a=py::none(),
              "seed"_a=0u,
+             "connection_cache"_a=py::none(),
              "Initialize the model described by a recipe, with cells and network distributed\n"
              "according to the domain decomposition and computational resources described by a\n"
-             "context. Initialize PRNG using seed")
+             "context. Initialize PRNG using seed. If connection_cache is given, load the connection\n"
+             "table from files at this path if they match the recipe's connectivity_fingerprint, else\n"
+             "build the table and store it there.")
         .def("set_remote_spike_filter",
              &simulation_shim::set_remote_spike_filter,
              "pred"_a,
@@ -253,6 +266,15 @@ void register_simulation(py::module& m, pyarb_global_ptr global_ptr) {
              "Rebuild the connection table from recipe::connections_on and the event"
              "generators based on recipe::event_generators.",
              "recipe"_a)
+        .def("update_connections", &simulation_shim::update_connections,
+             py::call_guard<py::gil_scoped_release>(),
+             "Add and remove connections terminating on local cells without rebuilding the connection table.\n"
+             "added: list of (target gid, connection) pairs.\n"
+             "removed: list of (target gid, source, target label) triples; all connections on the target cell\n"
+             "from any lid of the source label to any lid of the target label are removed.\n"
+             "Removals are applied before additions. Must be called on all ranks.",
+             "added"_a=std::vector<std::pair<arb::cell_gid_type, arb::cell_connection>>{},
+             "removed"_a=std::vector<std::tuple<arb::cell_gid_type, arb::cell_global_label_type, arb::cell_local_label_type>>{})
         .def("deserialize", &simulation_shim::deserialize,
              py::call_guard<py::gil_scoped_release>(),
              "Deserialize the simulation object from a JSON string."
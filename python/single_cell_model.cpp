@@ -277,8 +277,7 @@ void register_single_cell(pybind11::module& m) {
              " frequency: The target frequency at which to sample [kHz].")
         .def("event_generator",
             [](single_cell_model& m, const pyarb::event_generator_shim& event_generator) {
-                m.event_generator(arb::event_generator(
-                    event_generator.target, event_generator.weight, event_generator.time_sched));},
+                m.event_generator(event_generator.generator());},
             "event_generator"_a,
             "Register an event generator.\n"
             " event_generator: An Arbor event generator.")
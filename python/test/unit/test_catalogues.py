@@ -1,4 +1,7 @@
 from .. import fixtures
+import os
+import shutil
+import tempfile
 import unittest
 import arbor as A
 from arbor import units as U
@@ -106,3 +109,29 @@ class TestCatalogues(unittest.TestCase):
             hash_(cat),
             "Extending empty with prefixed cat should not yield cat",
         )
+
+
+@unittest.skipIf(shutil.which("modcc") is None, "modcc not found")
+class TestCompileCatalogue(unittest.TestCase):
+    pas = """
+        NEURON { SUFFIX jit_pas NONSPECIFIC_CURRENT i RANGE g }
+        PARAMETER { g = 0.001 e = -70 }
+        BREAKPOINT { i = g*(v - e) }
+    """
+
+    def test_compile(self):
+        with tempfile.TemporaryDirectory() as cache:
+            cat = A.compile_catalogue([self.pas], cache_dir=cache)
+            self.assertEqual(["jit_pas"], list(cat))
+            self.assertIn("g", cat["jit_pas"].parameters)
+            self.assertEqual(1, len(os.listdir(cache)))
+
+            # The second request is served from the cache.
+            cat = A.compile_catalogue([self.pas], cache_dir=cache)
+            self.assertEqual(["jit_pas"], list(cat))
+            self.assertEqual(1, len(os.listdir(cache)))
+
+            # Failed builds raise and leave nothing behind.
+            with self.assertRaises(RuntimeError):
+                A.compile_catalogue(["NEURON { SUFFIX"], cache_dir=cache)
+            self.assertEqual(1, len(os.listdir(cache)))
@@ -0,0 +1,86 @@
+# -*- coding: utf-8 -*-
+#
+# test_cell_descriptions.py
+
+import unittest
+
+import arbor as A
+from arbor import units as U
+
+"""
+Tests for recipe.cell_descriptions, the query for all cells of a group
+"""
+
+
+class batch_recipe(A.recipe):
+    """
+    LIF cells receiving one event of 7.5 mV at 1 ms. Cells from cell_description
+    stay below threshold, those from cell_descriptions fire. Returning None from
+    cell_descriptions falls back to cell_description.
+    """
+
+    def __init__(self, ncells, batched):
+        A.recipe.__init__(self)
+        self.ncells = ncells
+        self.batched = batched
+        self.single = []
+        self.batches = []
+
+    def num_cells(self):
+        return self.ncells
+
+    def cell_kind(self, gid):
+        return A.cell_kind.lif
+
+    def cell_description(self, gid):
+        self.single.append(gid)
+        return A.lif_cell("src", "tgt")
+
+    def cell_descriptions(self, gids):
+        self.batches.append(gids.tolist())
+        if not self.batched:
+            return None
+        cells = []
+        for gid in gids:
+            cell = A.lif_cell("src", "tgt")
+            cell.V_th = 5 * U.mV
+            cells.append(cell)
+        return cells
+
+    def event_generators(self, gid):
+        return [A.event_generator("tgt", 150, A.explicit_schedule([1 * U.ms]))]
+
+    def global_properties(self, kind):
+        return None
+
+
+class TestCellDescriptions(unittest.TestCase):
+    def run_recipe(self, rec):
+        sim = A.simulation(rec)
+        sim.record(A.spike_recording.all)
+        sim.run(2 * U.ms, 0.025 * U.ms)
+        return sorted(s for s, _ in sim.spikes().tolist())
+
+    def test_batched(self):
+        rec = batch_recipe(4, True)
+        spikes = self.run_recipe(rec)
+
+        # All cells come from cell_descriptions, none from cell_description.
+        self.assertEqual([], rec.single)
+        self.assertEqual(list(range(4)), sorted(g for b in rec.batches for g in b))
+        self.assertEqual([(gid, 0) for gid in range(4)], spikes)
+
+    def test_fallback(self):
+        rec = batch_recipe(4, False)
+        spikes = self.run_recipe(rec)
+
+        self.assertEqual(list(range(4)), sorted(rec.single))
+        self.assertEqual([], spikes)
+
+    def test_wrong_count(self):
+        class short_recipe(batch_recipe):
+            def cell_descriptions(self, gids):
+                return super().cell_descriptions(gids)[1:]
+
+        with self.assertRaisesRegex(RuntimeError, "descriptions for"):
+            A.simulation(short_recipe(4, True))
@@ -0,0 +1,118 @@
+# -*- coding: utf-8 -*-
+#
+# test_connection_columns.py
+
+import unittest
+import numpy as np
+
+import arbor as A
+from arbor import units as U
+
+"""
+Tests for the bulk connection interface: connection_columns and
+recipe.connections_on_range
+"""
+
+
+class ring_recipe(A.recipe):
+    """
+    A ring of LIF cells, each firing its successor, started by an event on gid 0.
+    Connections are given by connections_on if `bulk` is False, and else by
+    connections_on_range.
+    """
+
+    def __init__(self, ncells, bulk, weight=400, delay=1):
+        A.recipe.__init__(self)
+        self.ncells = ncells
+        self.bulk = bulk
+        self.weight = weight
+        self.delay = delay
+
+    def num_cells(self):
+        return self.ncells
+
+    def cell_kind(self, gid):
+        return A.cell_kind.lif
+
+    def cell_description(self, gid):
+        return A.lif_cell("src", "tgt")
+
+    def connections_on(self, gid):
+        src = (gid + self.ncells - 1) % self.ncells
+        return [A.connection((src, "src"), "tgt", self.weight, self.delay * U.ms)]
+
+    def connection_label_table(self):
+        return ["tgt", "src"] if self.bulk else []
+
+    def connections_on_range(self, gid_begin, gid_end):
+        n = gid_end - gid_begin
+        gids = np.arange(gid_begin, gid_end)
+        return A.connection_columns(
+            offsets=np.arange(n + 1),
+            source_gid=(gids + self.ncells - 1) % self.ncells,
+            source_label=np.ones(n),
+            target_label=np.zeros(n),
+            weight=np.full(n, self.weight),
+            delay=np.full(n, self.delay),
+        )
+
+    def event_generators(self, gid):
+        if gid != 0:
+            return []
+        return [A.event_generator("tgt", 400, A.explicit_schedule([1 * U.ms]))]
+
+    def global_properties(self, kind):
+        return None
+
+
+class TestConnectionColumns(unittest.TestCase):
+    def test_construction(self):
+        cols = A.connection_columns(
+            offsets=[0, 2, 3],
+            source_gid=[1, 2, 0],
+            source_label=[1, 1, 1],
+            target_label=[0, 0, 0],
+            weight=[0.5, 0.5, 0.5],
+            delay=[1, 1, 1],
+        )
+        self.assertEqual(3, len(cols))
+
+        # Policies are given once for all connections, or per connection.
+        cols = A.connection_columns(
+            [0, 1], [0], [0], [0], [1], [1], A.selection_policy.round_robin
+        )
+        self.assertEqual(1, len(cols))
+        rr = int(A.selection_policy.round_robin)
+        cols = A.connection_columns(
+            [0, 1], [0], [0], [0], [1], [1], target_policy=np.array([rr])
+        )
+        self.assertEqual(1, len(cols))
+
+    def test_invalid(self):
+        with self.assertRaisesRegex(RuntimeError, "one dimensional"):
+            A.connection_columns(np.zeros((2, 2)), [0], [0], [0], [1], [1])
+        with self.assertRaisesRegex(RuntimeError, "not a selection_policy"):
+            A.connection_columns([0, 1], [0], [0], [0], [1], [1], np.array([7]))
+        with self.assertRaisesRegex(RuntimeError, "not a selection_policy"):
+            A.connection_columns(
+                [0, 1], [0], [0], [0], [1], [1], target_policy=np.array([-1])
+            )
+
+    def test_ring(self):
+        def run(rec):
+            sim = A.simulation(rec)
+            sim.record(A.spike_recording.all)
+            sim.run(4.5 * U.ms, 0.025 * U.ms)
+            return sim.spikes().tolist()
+
+        spikes = run(ring_recipe(4, True))
+        self.assertEqual([(g, 0) for g in range(4)], [s for s, t in spikes])
+        np.testing.assert_allclose([1, 2, 3, 4], [t for s, t in spikes])
+
+        # Both interfaces describe the same network.
+        self.assertEqual(run(ring_recipe(4, False)), spikes)
+
+    def test_nonfinite(self):
+        for weight, delay in [(np.inf, 1), (np.nan, 1), (400, np.inf)]:
+            with self.assertRaisesRegex(RuntimeError, "not finite"):
+                A.simulation(ring_recipe(4, True, weight, delay))
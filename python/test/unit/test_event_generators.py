@@ -35,3 +35,58 @@ class TestEventGenerator(unittest.TestCase):
         self.assertEqual(pg.target.label, "tgt2")
         self.assertEqual(pg.target.policy, arb.selection_policy.univalent)
         self.assertEqual(pg.weight, 42.0)
+
+    def test_event_generator_targets(self):
+        rs = arb.regular_schedule(2.0 * U.ms, 1.0 * U.ms, 100.0 * U.ms)
+        eg = arb.event_generator(
+            [("tgt0", 0.5), (arb.cell_local_label("tgt1", arb.selection_policy.round_robin), 0.25)],
+            rs,
+        )
+        self.assertEqual(2, len(eg.targets))
+        (t0, w0), (t1, w1) = eg.targets
+        self.assertEqual(t0.label, "tgt0")
+        self.assertEqual(t0.policy, arb.selection_policy.univalent)
+        self.assertAlmostEqual(w0, 0.5)
+        self.assertEqual(t1.label, "tgt1")
+        self.assertEqual(t1.policy, arb.selection_policy.round_robin)
+        self.assertAlmostEqual(w1, 0.25)
+        # target and weight are only defined for a single target.
+        with self.assertRaisesRegex(RuntimeError, "use targets instead"):
+            eg.weight
+
+        eg = arb.event_generator("tgt2", 42.0, rs)
+        self.assertEqual(1, len(eg.targets))
+        self.assertEqual(eg.targets[0][0].label, "tgt2")
+
+    def test_event_generator_targets_delivery(self):
+        # Each event alone raises the LIF potential by 7.5 mV, short of the 10 mV
+        # threshold; the cell fires only if events reach both targets.
+        class lif_recipe(arb.recipe):
+            def __init__(self, targets):
+                arb.recipe.__init__(self)
+                self.targets = targets
+
+            def num_cells(self):
+                return 1
+
+            def cell_kind(self, gid):
+                return arb.cell_kind.lif
+
+            def cell_description(self, gid):
+                return arb.lif_cell("src", "tgt")
+
+            def event_generators(self, gid):
+                sched = arb.explicit_schedule([1 * U.ms])
+                return [arb.event_generator(self.targets, sched)]
+
+            def global_properties(self, kind):
+                return None
+
+        def spike_times(targets):
+            sim = arb.simulation(lif_recipe(targets))
+            sim.record(arb.spike_recording.all)
+            sim.run(2 * U.ms, 0.025 * U.ms)
+            return [t for _, t in sim.spikes().tolist()]
+
+        self.assertEqual([], spike_times([("tgt", 150)]))
+        self.assertEqual([1.0], spike_times([("tgt", 150), ("tgt", 150)]))
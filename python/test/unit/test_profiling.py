@@ -69,24 +69,16 @@ class TestProfiling(unittest.TestCase):
         self.assertTrue("profiling" in A.config(), "profiling key not in config")
         profiling_support = A.config()["profiling"]
         self.assertEqual(bool, type(profiling_support), "profiling flag should be bool")
-        if profiling_support:
-            self.assertTrue(
-                hasattr(A, "profiler_initialize"),
-                "missing profiling interface with profiling support",
-            )
-            self.assertTrue(
-                hasattr(A, "profiler_summary"),
-                "missing profiling interface with profiling support",
-            )
-        else:
-            self.assertFalse(
-                hasattr(A, "profiler_initialize"),
-                "profiling interface without profiling support",
-            )
-            self.assertFalse(
-                hasattr(A, "profiler_summary"),
-                "profiling interface without profiling support",
-            )
+        # The profiler is always built and switched on at runtime.
+        self.assertTrue(profiling_support, "profiling should always be supported")
+        self.assertTrue(
+            hasattr(A, "profiler_initialize"),
+            "missing profiling interface with profiling support",
+        )
+        self.assertTrue(
+            hasattr(A, "profiler_summary"),
+            "missing profiling interface with profiling support",
+        )
 
     @lazy_skipIf(skipWithoutSupport, "run test only with profiling support")
     def test_summary(self):
@@ -98,3 +90,33 @@ class TestProfiling(unittest.TestCase):
         summary = A.profiler_summary()
         self.assertEqual(str, type(summary), "profiler summary must be str")
         self.assertTrue(summary, "empty summary")
+
+    @lazy_skipIf(skipWithoutSupport, "run test only with profiling support")
+    def test_trace(self):
+        import json
+
+        context = A.context()
+        A.profiler_initialize(context, trace=True)
+        recipe = a_recipe()
+        dd = A.partition_load_balance(recipe, context)
+        A.simulation(recipe, context, dd).run(1 * U.ms)
+        trace = json.loads(A.profiler_trace())
+        regions = [e for e in trace["traceEvents"] if e["ph"] == "X"]
+        self.assertTrue(regions, "empty trace")
+        for e in regions:
+            self.assertGreaterEqual(e["dur"], 0)
+
+    @lazy_skipIf(skipWithoutSupport, "run test only with profiling support")
+    def test_trace_capacity(self):
+        import json
+
+        context = A.context()
+        A.profiler_initialize(context, trace=True, trace_capacity=2)
+        recipe = a_recipe()
+        dd = A.partition_load_balance(recipe, context)
+        A.simulation(recipe, context, dd).run(1 * U.ms)
+        trace = json.loads(A.profiler_trace())
+        tids = [e["tid"] for e in trace["traceEvents"] if e["ph"] == "X"]
+        self.assertTrue(tids, "empty trace")
+        for tid in set(tids):
+            self.assertLessEqual(tids.count(tid), 2)
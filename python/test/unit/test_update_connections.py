@@ -0,0 +1,76 @@
+# -*- coding: utf-8 -*-
+#
+# test_update_connections.py
+
+import unittest
+
+import arbor as A
+from arbor import units as U
+
+"""
+Tests for changing connectivity during a run with simulation.update_connections
+"""
+
+
+class relay_recipe(A.recipe):
+    """
+    Three LIF cells; gid 0 is driven at 1 ms and 11 ms and initially connected
+    to gid 1 only. Every event makes the receiving cell fire.
+    """
+
+    def __init__(self):
+        A.recipe.__init__(self)
+
+    def num_cells(self):
+        return 3
+
+    def cell_kind(self, gid):
+        return A.cell_kind.lif
+
+    def cell_description(self, gid):
+        return A.lif_cell("src", "tgt")
+
+    def connections_on(self, gid):
+        if gid == 1:
+            return [A.connection((0, "src"), "tgt", 400, 1 * U.ms)]
+        return []
+
+    def event_generators(self, gid):
+        if gid != 0:
+            return []
+        sched = A.explicit_schedule([1 * U.ms, 11 * U.ms])
+        return [A.event_generator("tgt", 400, sched)]
+
+    def global_properties(self, kind):
+        return None
+
+
+class TestUpdateConnections(unittest.TestCase):
+    def test_rewire(self):
+        sim = A.simulation(relay_recipe())
+        sim.record(A.spike_recording.all)
+
+        sim.run(5 * U.ms, 0.025 * U.ms)
+        self.assertEqual(
+            [((0, 0), 1.0), ((1, 0), 2.0)],
+            [(tuple(s), t) for s, t in sim.spikes().tolist()],
+        )
+
+        # Move the connection from gid 1 to gid 2.
+        sim.update_connections(
+            added=[(2, A.connection((0, "src"), "tgt", 400, 1 * U.ms))],
+            removed=[(1, (0, "src"), "tgt")],
+        )
+        sim.clear_samplers()
+        sim.run(15 * U.ms, 0.025 * U.ms)
+        self.assertEqual(
+            [((0, 0), 11.0), ((2, 0), 12.0)],
+            [(tuple(s), t) for s, t in sim.spikes().tolist()],
+        )
+
+    def test_remove_only(self):
+        sim = A.simulation(relay_recipe())
+        sim.record(A.spike_recording.all)
+        sim.update_connections(removed=[(1, (0, "src"), "tgt")])
+        sim.run(15 * U.ms, 0.025 * U.ms)
+        self.assertEqual([0, 0], [s[0] for s, _ in sim.spikes().tolist()])
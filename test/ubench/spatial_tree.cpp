@@ -0,0 +1,125 @@
+// Compare query throughput of the spatial tree used for network generation.
+//
+// Sites are placed uniformly at random in a cube with constant density, as for cortical
+// columns. Each query collects all sites within a fixed radius of a random site, as done for
+// selections with a maximum distance.
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "util/spatial_tree.hpp"
+
+using point = std::array<double, 3>;
+using tree_type = arb::spatial_tree<point, 3>;
+
+// density of sites per μm³ and radius of queries in μm
+constexpr double density = 1e-4;
+constexpr double radius = 50.0;
+constexpr std::size_t num_queries = 256;
+
+point location(const point& p) { return p; }
+
+struct payload {
+    payload(std::size_t n) {
+        const double side = std::cbrt(n / density);
+        std::minstd_rand gen(42);
+        std::uniform_real_distribution<double> dist(0.0, side);
+        sites.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) sites.push_back({dist(gen), dist(gen), dist(gen)});
+        for (std::size_t i = 0; i < num_queries; ++i) centers.push_back(sites[(i * 7919) % n]);
+    }
+
+    std::vector<point> sites;
+    std::vector<point> centers;
+};
+
+bool within(const point& a, const point& b) {
+    double d2 = 0.0;
+    for (std::size_t i = 0; i < 3; ++i) d2 += (a[i] - b[i]) * (a[i] - b[i]);
+    return d2 <= radius * radius;
+}
+
+static void BM_brute_force(benchmark::State& state) {
+    const payload data(state.range(0));
+
+    for (auto _: state) {
+        std::size_t count = 0;
+        for (const auto& c: data.centers) {
+            for (const auto& p: data.sites) count += within(c, p);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+}
+
+// Fixed depth and leaf size with bounding box query and distance test, as previously used for
+// network generation.
+static void BM_fixed_bounding_box(benchmark::State& state) {
+    const payload data(state.range(0));
+    const tree_type tree(10, 100, data.sites, location);
+
+    for (auto _: state) {
+        std::size_t count = 0;
+        for (const auto& c: data.centers) {
+            tree.bounding_box_for_each({c[0] - radius, c[1] - radius, c[2] - radius},
+                {c[0] + radius, c[1] + radius, c[2] + radius},
+                [&](const point& p) { count += within(c, p); });
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+}
+
+static void BM_fixed_radius(benchmark::State& state) {
+    const payload data(state.range(0));
+    const tree_type tree(10, 100, data.sites, location);
+
+    for (auto _: state) {
+        std::size_t count = 0;
+        for (const auto& c: data.centers) {
+            tree.radius_for_each(c, radius, [&](const point&) { ++count; });
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+}
+
+static void BM_tuned_radius(benchmark::State& state) {
+    const payload data(state.range(0));
+    const auto tree = tree_type::for_radius(radius, data.sites, location);
+
+    for (auto _: state) {
+        std::size_t count = 0;
+        for (const auto& c: data.centers) {
+            tree.radius_for_each(c, radius, [&](const point&) { ++count; });
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+}
+
+static void BM_tuned_build(benchmark::State& state) {
+    const payload data(state.range(0));
+
+    for (auto _: state) {
+        auto tree = tree_type::for_radius(radius, data.sites, location);
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void run_custom_arguments(benchmark::internal::Benchmark* b) {
+    for (auto n: {10'000, 100'000, 1'000'000}) b->Arg(n);
+}
+
+BENCHMARK(BM_brute_force)->Arg(10'000)->Arg(100'000);
+BENCHMARK(BM_fixed_bounding_box)->Apply(run_custom_arguments);
+BENCHMARK(BM_fixed_radius)->Apply(run_custom_arguments);
+BENCHMARK(BM_tuned_radius)->Apply(run_custom_arguments);
+BENCHMARK(BM_tuned_build)->Apply(run_custom_arguments);
+
+BENCHMARK_MAIN();
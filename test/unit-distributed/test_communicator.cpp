@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "test.hpp"
 
+#include <algorithm>
+#include <tuple>
 #include <vector>
 
 #include <arbor/domain_decomposition.hpp>
@@ -539,6 +541,148 @@ TEST(communicator, ring)
     EXPECT_TRUE(test_ring(D, C, [](cell_gid_type g){return g%2==0;}));
     // odd-numbered cells fire
     EXPECT_TRUE(test_ring(D, C, [](cell_gid_type g){return g%2==1;}));
+
+    // resolving source labels on demand yields the same connections
+    auto C_on_demand = communicator(R, D, g_context);
+    C_on_demand.update_connections(R, D, local_sources, label_resolution_map(local_targets));
+    EXPECT_EQ(C.connections().srcs, C_on_demand.connections().srcs);
+    EXPECT_EQ(C.connections().dests, C_on_demand.connections().dests);
+    EXPECT_EQ(C.connections().idx_on_domain, C_on_demand.connections().idx_on_domain);
+}
+
+TEST(communicator, connection_delta)
+{
+    unsigned N = g_context->distributed->size();
+    unsigned n_local = 10u;
+    unsigned n_global = n_local*N;
+
+    auto R = ring_recipe(n_global);
+    const auto D = partition_load_balance(R, g_context);
+
+    std::vector<cell_gid_type> mc_gids, lif_gids;
+    for (auto g: D.groups()) {
+        auto& gids = g.kind == cell_kind::cable? mc_gids: lif_gids;
+        gids.insert(gids.end(), g.gids.begin(), g.gids.end());
+    }
+    cell_label_range mc_srcs, mc_tgts, lif_srcs, lif_tgts;
+    auto mc_group = cable_cell_group(mc_gids, R, mc_srcs, mc_tgts, make_fvm_lowered_cell(backend_kind::multicore, *g_context));
+    auto lif_group = lif_cell_group(lif_gids, R, lif_srcs, lif_tgts);
+
+    auto local_sources = cell_labels_and_gids(mc_srcs, mc_gids);
+    auto local_targets = cell_labels_and_gids(mc_tgts, mc_gids);
+    local_sources.append({lif_srcs, lif_gids});
+    local_targets.append({lif_tgts, lif_gids});
+    auto target_map = label_resolution_map(local_targets);
+
+    auto C = communicator(R, D, g_context);
+    C.update_connections(R, D, local_sources, target_map);
+    EXPECT_EQ(1.0, C.min_delay());
+
+    // Drop the ring connection of every third cell and add a shortcut from two cells back,
+    // which mostly crosses domains.
+    using con_tuple = std::tuple<cell_gid_type, cell_lid_type, cell_lid_type, float, float, cell_size_type>;
+    std::vector<con_tuple> expected;
+    connection_delta delta;
+    for (auto gid: get_gids(D)) {
+        auto iod = D.index_on_domain(gid);
+        auto shortcut = (gid + 2)%n_global;
+        if (gid%3 == 0) {
+            delta.remove(gid, {source_of(gid, n_global), "src"}, {"tgt"});
+        }
+        else {
+            expected.emplace_back(source_of(gid, n_global), 0u, 0u, float(gid), 1.0f, iod);
+        }
+        delta.add(gid, cell_connection({shortcut, "src"}, {"tgt"}, -float(gid), 0.5*U::ms));
+        expected.emplace_back(shortcut, 0u, 0u, -float(gid), 0.5f, iod);
+    }
+    C.update_connections(delta, D, local_sources, target_map);
+    EXPECT_EQ(0.5, C.min_delay());
+
+    const auto& cons = C.connections();
+    std::vector<con_tuple> actual;
+    for (auto i: util::make_span(cons.size())) {
+        actual.emplace_back(cons.srcs[i].gid, cons.srcs[i].index, cons.dests[i], cons.weights[i], cons.delays[i], cons.idx_on_domain[i]);
+    }
+    // Connections are partitioned by source domain, each sorted by source, hence sorted overall.
+    EXPECT_TRUE(std::is_sorted(cons.srcs.begin(), cons.srcs.end()));
+    util::sort(actual);
+    util::sort(expected);
+    EXPECT_EQ(expected, actual);
+
+    // an empty delta leaves the connections untouched
+    connection_delta empty;
+    C.update_connections(empty, D, local_sources, target_map);
+    EXPECT_EQ(expected.size(), C.connections().size());
+}
+
+namespace {
+    // The ring recipe with its connections given in columnar form.
+    class ring_columns_recipe: public ring_recipe {
+    public:
+        ring_columns_recipe(cell_size_type s, cell_size_type bad_label = 0): ring_recipe(s), size_(s), bad_label_(bad_label) {}
+
+        std::vector<cell_connection> connections_on(cell_gid_type gid) const override { return {}; }
+
+        std::vector<cell_tag_type> connection_label_table() const override { return {"tgt", "src"}; }
+
+        connection_columns connections_on_range(cell_gid_type gid_begin, cell_gid_type gid_end) const override {
+            connection_columns cols;
+            for (auto gid: util::make_span(gid_begin, gid_end)) {
+                cols.add(gid==0? size_-1: gid-1, 1 + bad_label_, 0, float(gid), 1.0f);
+                cols.next_cell();
+            }
+            return cols;
+        }
+
+    private:
+        cell_size_type size_;
+        cell_size_type bad_label_;
+    };
+}
+
+TEST(communicator, connection_columns)
+{
+    unsigned N = g_context->distributed->size();
+    unsigned n_local = 10u;
+    unsigned n_global = n_local*N;
+
+    auto R = ring_recipe(n_global);
+    auto R_cols = ring_columns_recipe(n_global);
+    const auto D = partition_load_balance(R, g_context);
+
+    std::vector<cell_gid_type> mc_gids, lif_gids;
+    for (auto g: D.groups()) {
+        auto& gids = g.kind == cell_kind::cable? mc_gids: lif_gids;
+        gids.insert(gids.end(), g.gids.begin(), g.gids.end());
+    }
+    cell_label_range mc_srcs, mc_tgts, lif_srcs, lif_tgts;
+    auto mc_group = cable_cell_group(mc_gids, R, mc_srcs, mc_tgts, make_fvm_lowered_cell(backend_kind::multicore, *g_context));
+    auto lif_group = lif_cell_group(lif_gids, R, lif_srcs, lif_tgts);
+
+    auto local_sources = cell_labels_and_gids(mc_srcs, mc_gids);
+    auto local_targets = cell_labels_and_gids(mc_tgts, mc_gids);
+    local_sources.append({lif_srcs, lif_gids});
+    local_targets.append({lif_tgts, lif_gids});
+    auto target_map = label_resolution_map(local_targets);
+
+    auto C = communicator(R, D, g_context);
+    C.update_connections(R, D, local_sources, target_map);
+    auto C_cols = communicator(R_cols, D, g_context);
+    C_cols.update_connections(R_cols, D, local_sources, target_map);
+    EXPECT_TRUE(test_ring(D, C_cols, [](cell_gid_type g){return true;}));
+
+    const auto& expected = C.connections();
+    const auto& actual = C_cols.connections();
+    EXPECT_EQ(expected.srcs, actual.srcs);
+    EXPECT_EQ(expected.dests, actual.dests);
+    EXPECT_EQ(expected.weights, actual.weights);
+    EXPECT_EQ(expected.delays, actual.delays);
+    EXPECT_EQ(expected.idx_on_domain, actual.idx_on_domain);
+
+    // label ids must refer to the label table
+    auto R_bad = ring_columns_recipe(n_global, 1);
+    auto C_bad = communicator(R_bad, D, g_context);
+    EXPECT_THROW(C_bad.update_connections(R_bad, D, local_sources, target_map), bad_connection_columns);
 }
 
 template <typename F>
@@ -165,3 +165,71 @@ TEST(network_generation, cable_only) {
         }
     }
 }
+
+TEST(network_generation, random_constant_probability) {
+    const auto& ctx = g_context;
+    const int num_ranks = ctx->distributed->size();
+
+    const double p = 0.5;
+    const auto selection = intersect(network_selection::random(42, p),
+        network_selection::target_cell_kind(cell_kind::cable));
+    const auto weight = 2.0;
+    const auto delay = 3.0;
+
+    const auto num_cells = 30 * num_ranks;
+
+    auto rec = network_test_recipe(num_cells, selection, weight, delay);
+
+    const auto decomp = partition_load_balance(rec, ctx);
+
+    const auto connections = generate_network_connections(rec, ctx, decomp);
+
+    // skip sampling must be reproducible
+    EXPECT_EQ(connections, generate_network_connections(rec, ctx, decomp));
+
+    for (const auto& c: connections) {
+        EXPECT_EQ(c.weight, weight);
+        EXPECT_EQ(c.delay, delay);
+        EXPECT_EQ(c.target.kind, cell_kind::cable);
+    }
+
+    // Each cell has one source and only one third of the cells a cable cell target. Expected
+    // number of connections is n*p with standard deviation sqrt(n*p*(1-p)).
+    const double n = double(num_cells) * (num_cells / 3);
+    const double sigma = std::sqrt(n * p * (1 - p));
+    const double num_connections = ctx->distributed->sum(double(connections.size()));
+    EXPECT_NEAR(num_connections, n * p, 5 * sigma);
+}
+
+TEST(network_generation, random_decomposition_independent) {
+    const auto& ctx = g_context;
+    const int num_ranks = ctx->distributed->size();
+    const int rank = ctx->distributed->id();
+
+    const auto selection = intersect(network_selection::random(42, 0.3),
+        network_selection::target_cell_kind(cell_kind::cable));
+    const auto num_cells = 30 * num_ranks;
+
+    auto rec = network_test_recipe(num_cells, selection, 2.0, 3.0);
+
+    // reference generated on a single rank
+    const auto all_connections = generate_network_connections(rec);
+
+    auto check = [&](const domain_decomposition& decomp) {
+        std::vector<network_connection_info> expected;
+        for (const auto& c: all_connections) {
+            if (decomp.gid_domain(c.target.gid) == rank) expected.push_back(c);
+        }
+        EXPECT_EQ(expected, generate_network_connections(rec, ctx, decomp));
+    };
+
+    check(partition_load_balance(rec, ctx));
+
+    // round-robin assignment of single cell groups
+    std::vector<group_description> groups;
+    for (cell_gid_type gid = rank; gid < num_cells; gid += num_ranks) {
+        groups.emplace_back(
+            rec.get_cell_kind(gid), std::vector<cell_gid_type>{gid}, backend_kind::multicore);
+    }
+    check(domain_decomposition(rec, ctx, groups));
+}
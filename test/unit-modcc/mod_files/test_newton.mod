@@ -0,0 +1,17 @@
+NEURON {
+    SUFFIX test_newton
+}
+
+STATE {
+    a b c d e f
+}
+
+BREAKPOINT {
+    SOLVE states METHOD sparse
+}
+
+KINETIC states {
+    ~ a + b <-> c (1, 2)
+    ~ c <-> d (3, 4)
+    ~ d + e <-> f (5, 6)
+}
@@ -0,0 +1,31 @@
+NEURON {
+    SUFFIX test_procedure_table
+    RANGE minf, mtau
+}
+
+STATE { m }
+
+ASSIGNED {
+    minf
+    mtau
+}
+
+INITIAL {
+    rates(v)
+    m = minf
+}
+
+DERIVATIVE states {
+    rates(v)
+    m' = (minf - m)/mtau
+}
+
+BREAKPOINT {
+    SOLVE states METHOD cnexp
+}
+
+PROCEDURE rates(v) {
+    TABLE minf, mtau DEPEND celsius FROM -100 TO 100 WITH 200
+    minf = 1/(1 + exp((-40 - v)/10))
+    mtau = exp(-v/50)
+}
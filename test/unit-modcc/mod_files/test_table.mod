@@ -0,0 +1,52 @@
+NEURON {
+    SUFFIX test_table
+    RANGE gbar
+}
+
+PARAMETER {
+    gbar = 0.1
+    q = 2.5
+    q10 = 3
+}
+
+CONSTANT {
+    vhalf = -40
+}
+
+STATE { m }
+
+INITIAL {
+    m = minf(v)*hinf(v)
+}
+
+DERIVATIVE states {
+    m' = (minf(v) - m)/(mtau(v)*htau(v))
+}
+
+BREAKPOINT {
+    SOLVE states METHOD cnexp
+}
+
+FUNCTION minf(v) {
+    TABLE DEPEND vhalf FROM -100 TO 100 WITH 200
+    minf = 1/(1 + exp((vhalf - v)/10))
+}
+
+FUNCTION mtau(v) {
+    TABLE FROM -100 TO 100 WITH 200
+    mtau = q*exp(-v/50)
+}
+
+FUNCTION hinf(v) {
+    hinf = 1/(1 + exp((v - vhalf)/5))
+}
+
+FUNCTION htau(v) {
+    TABLE FROM -100 TO 100 WITH 100
+    htau = q10*exp(-v/20)
+}
+
+FUNCTION ginf(v) {
+    TABLE FROM -100 TO 100 WITH 200
+    ginf = gbar*v
+}
@@ -1,6 +1,10 @@
+#include <cmath>
+
 #include "common.hpp"
 #include "io/bulkio.hpp"
 #include "module.hpp"
+#include "perfvisitor.hpp"
+#include "printer/printerutil.hpp"
 #include <unordered_map>
 
 TEST(Module, open) {
@@ -266,3 +270,138 @@ TEST(Module, reaction_under_conditional) {
 
     EXPECT_FALSE(m.semantic());
 }
+
+TEST(Module, procedure_table) {
+    Module m(io::read_all(DATADIR "/mod_files/test_procedure_table.mod"), "test_procedure_table.mod");
+    EXPECT_NE(m.buffer().size(), 0u);
+
+    // The TABLE is ignored with a warning, the values are computed exactly.
+    Parser p(m, false);
+    EXPECT_TRUE(p.parse());
+    EXPECT_TRUE(m.has_warning());
+    EXPECT_TRUE(m.semantic());
+    EXPECT_FALSE(m.has_error());
+    EXPECT_EQ(0u, m.table_values());
+}
+
+TEST(Module, function_table) {
+    Module m(io::read_all(DATADIR "/mod_files/test_table.mod"), "test_table.mod");
+    EXPECT_NE(m.buffer().size(), 0u);
+
+    Parser p(m, false);
+    EXPECT_TRUE(p.parse());
+    EXPECT_TRUE(m.semantic());
+
+    // ginf depends on the range parameter gbar and is computed exactly.
+    EXPECT_TRUE(m.has_warning());
+    EXPECT_FALSE(m.symbols().at("ginf")->is_function()->is_tabulated());
+
+    // mtau and htau depend on the global parameters q and q10: both are
+    // sampled by the mechanism, one after the other.
+    auto mtau = m.symbols().at("mtau")->is_function();
+    auto htau = m.symbols().at("htau")->is_function();
+    ASSERT_TRUE(mtau->is_tabulated());
+    ASSERT_TRUE(htau->is_tabulated());
+    EXPECT_TRUE(mtau->table()->runtime);
+    EXPECT_TRUE(mtau->table()->values.empty());
+    EXPECT_TRUE(htau->table()->runtime);
+    EXPECT_EQ((std::vector<FunctionExpression*>{htau, mtau}), m.runtime_tables());
+    EXPECT_EQ(0u, htau->table()->offset);
+    EXPECT_EQ(102u, mtau->table()->offset);
+    EXPECT_EQ(304u, m.table_values());
+
+    auto minf = m.symbols().at("minf")->is_function();
+    ASSERT_TRUE(minf->is_tabulated());
+    auto& values = minf->table()->values;
+    ASSERT_EQ(201u, values.size());
+    for (unsigned i = 0; i <= 200; ++i) {
+        double v = -100. + i;
+        double expected = 1/(1 + std::exp((-40 - v)/10));
+        EXPECT_NEAR(expected, values[i], 1e-12*expected);
+    }
+
+    // Functions without a TABLE are tabulated only on request.
+    EXPECT_FALSE(m.symbols().at("hinf")->is_function()->is_tabulated());
+
+    EXPECT_EQ((std::vector<FunctionExpression*>{htau, minf, mtau}), tabulated_functions(m));
+}
+
+TEST(Module, default_table) {
+    Module m(io::read_all(DATADIR "/mod_files/test_table.mod"), "test_table.mod");
+    EXPECT_NE(m.buffer().size(), 0u);
+
+    TableSpec t;
+    t.from = -50;
+    t.to = 50;
+    t.n = 10;
+    m.default_table(t);
+
+    Parser p(m, false);
+    EXPECT_TRUE(p.parse());
+    EXPECT_TRUE(m.semantic());
+
+    auto hinf = m.symbols().at("hinf")->is_function();
+    ASSERT_TRUE(hinf->is_tabulated());
+    EXPECT_EQ(11u, hinf->table()->values.size());
+    double expected = 1/(1 + std::exp((50. + 40)/5));
+    EXPECT_NEAR(expected, hinf->table()->values.back(), 1e-12*expected);
+
+    // The default does not override explicit TABLE statements.
+    auto minf = m.symbols().at("minf")->is_function();
+    ASSERT_TRUE(minf->is_tabulated());
+    EXPECT_EQ(201u, minf->table()->values.size());
+
+    EXPECT_EQ(4u, tabulated_functions(m).size());
+}
+
+TEST(Module, newton) {
+    auto flops = [](NewtonSpec newton) {
+        Module m(io::read_all(DATADIR "/mod_files/test_newton.mod"), "test_newton.mod");
+        m.newton(newton);
+
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        EXPECT_TRUE(m.semantic());
+
+        FlopVisitor visitor;
+        m.symbols().at("advance_state")->is_api_method()->accept(&visitor);
+        return visitor.flops;
+    };
+
+    auto full = flops({3, false});
+    auto reuse = flops({3, true});
+    auto once = flops({1, false});
+
+    EXPECT_LT(once.mul, full.mul);
+
+    // Reusing the Jacobian leaves one reduction of J, but all solves.
+    EXPECT_EQ(full.div, reuse.div);
+    EXPECT_LT(reuse.mul, full.mul);
+    EXPECT_LT(reuse.add, full.add);
+}
+
+TEST(Module, additive_net_receive) {
+    auto additive = [](const char* body) {
+        std::string text = std::string(
+            "NEURON { POINT_PROCESS syn NONSPECIFIC_CURRENT i RANGE k }\n"
+            "PARAMETER { k = 2 }\n"
+            "STATE { g h }\n"
+            "BREAKPOINT { i = (g + h)*v }\n"
+            "NET_RECEIVE(weight) {\n") + body + "\n}\n";
+        Module m(text, "syn.mod");
+        Parser p(m, false);
+        EXPECT_TRUE(p.parse());
+        EXPECT_TRUE(m.semantic());
+        return is_additive_net_receive(find_api_method(m, "net_rec_api"));
+    };
+
+    EXPECT_TRUE(additive("g = g + weight"));
+    EXPECT_TRUE(additive("g = g + k*weight\n h = weight/k + h"));
+
+    EXPECT_FALSE(additive("g = g + weight*weight"));
+    EXPECT_FALSE(additive("g = 2*g + weight"));
+    EXPECT_FALSE(additive("g = g + weight + 1"));
+    EXPECT_FALSE(additive("g = g + weight\n h = h + g*weight"));
+    EXPECT_FALSE(additive("g = g + weight\n g = g + weight"));
+    EXPECT_FALSE(additive("if (weight > 0) { g = g + weight }"));
+}
@@ -257,6 +257,77 @@ TEST(Parser, function) {
     }
 }
 
+TEST(Parser, function_table) {
+    {
+        char str[] =
+            "FUNCTION foo(x) {\n"
+            "  TABLE DEPEND a, b FROM -100 TO 100 WITH 200\n"
+            "  foo = 2*x\n"
+            "}";
+
+        std::unique_ptr<Symbol> sym;
+        EXPECT_TRUE(check_parse(sym, &Parser::parse_function, str));
+        auto f = sym->is_function();
+        ASSERT_TRUE(f && f->table());
+        EXPECT_EQ((std::vector<std::string>{"a", "b"}), f->table()->depend);
+        EXPECT_EQ(-100., f->table()->from);
+        EXPECT_EQ(100., f->table()->to);
+        EXPECT_EQ(200u, f->table()->n);
+        EXPECT_FALSE(f->is_tabulated());
+    }
+    {
+        char str[] =
+            "FUNCTION foo(x) {\n"
+            "  foo = 2*x\n"
+            "}";
+
+        std::unique_ptr<Symbol> sym;
+        EXPECT_TRUE(check_parse(sym, &Parser::parse_function, str));
+        EXPECT_FALSE(sym->is_function()->table());
+    }
+    {
+        // Tables in procedures are ignored.
+        char str[] =
+            "PROCEDURE rates(v) {\n"
+            "  TABLE minf FROM -100 TO 100 WITH 200\n"
+            "  minf = 2*v\n"
+            "}";
+        EXPECT_TRUE(check_parse(&Parser::parse_procedure, str));
+    }
+
+    const char* bad_tables[] = {
+        // Variable lists only make sense in procedures.
+        "FUNCTION foo(x) {\n"
+        "  TABLE foo FROM -100 TO 100 WITH 200\n"
+        "  foo = 2*x\n"
+        "}",
+        // Only functions of one argument can be tabulated.
+        "FUNCTION foo(x, y) {\n"
+        "  TABLE FROM -100 TO 100 WITH 200\n"
+        "  foo = x*y\n"
+        "}",
+        // Not in a nested scope.
+        "FUNCTION foo(x) {\n"
+        "  if (x > 0) {\n"
+        "    TABLE FROM -100 TO 100 WITH 200\n"
+        "  }\n"
+        "  foo = 2*x\n"
+        "}",
+        // Empty or reversed ranges.
+        "FUNCTION foo(x) {\n"
+        "  TABLE FROM -100 TO 100 WITH 0\n"
+        "  foo = 2*x\n"
+        "}",
+        "FUNCTION foo(x) {\n"
+        "  TABLE FROM 100 TO -100 WITH 200\n"
+        "  foo = 2*x\n"
+        "}",
+    };
+    for (auto str: bad_tables) {
+        EXPECT_TRUE(check_parse_fail(&Parser::parse_function, str));
+    }
+}
+
 TEST(Parser, parse_solve) {
     std::unique_ptr<SolveExpression> s;
 
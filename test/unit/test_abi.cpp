@@ -1,3 +1,5 @@
+#include <cstddef>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -147,6 +149,103 @@ TEST(abi, multicore_null) {
     EXPECT_NO_THROW(shared_state.instantiate(mech, 42, {}, layout, {}));
 }
 
+namespace {
+void general_kernel(arb_mechanism_ppack*) {}
+void uniform_kernel(arb_mechanism_ppack*) {}
+}
+
+TEST(abi, multicore_uniform_parameters) {
+    auto thread_pool = std::make_shared<arb::threading::task_system>();
+
+    std::vector<arb_field_info> params  = {{ "P0", "lm", -123.0,     0.0, 2000.0},
+                                           { "P1", "lm",    1.0,     0.0, 2000.0}};
+
+    arb_mechanism_type type{};
+    type.abi_version = ARB_MECH_ABI_VERSION;
+    type.name       = "dummy";
+    type.parameters = params.data();  type.n_parameters = params.size();
+
+    arb_mechanism_interface iface{};
+    iface.backend = arb_backend_kind_cpu;
+    iface.partition_width = 1;
+    iface.alignment = 1;
+    iface.compute_currents = general_kernel;
+    iface.advance_state = general_kernel;
+    iface.compute_currents_uniform = uniform_kernel;
+    iface.advance_state_uniform = uniform_kernel;
+
+    arb_size_type ncell = 1;
+    arb_size_type ncv = 5;
+    std::vector<arb_index_type> cv_to_cell(ncv, 0);
+    std::vector<arb_value_type> temp(ncv, 23);
+    std::vector<arb_value_type> diam(ncv, 1.);
+    std::vector<arb_value_type> area(ncv, 10.);
+    std::vector<arb_value_type> vinit(ncv, -65);
+    std::vector<arb_index_type> src_to_spike = {};
+
+    arb::multicore::shared_state shared_state(thread_pool, ncell, ncv, cv_to_cell,
+                                              vinit, temp, diam, area, src_to_spike,
+                                              arb::fvm_detector_info{},
+                                              1);
+
+    arb::mechanism_layout layout;
+    layout.weight.assign(ncv, 1.);
+    for (arb_size_type i = 0; i<ncv; ++i) layout.cv.push_back(i);
+
+    using param_values = std::vector<std::pair<std::string, std::vector<arb_value_type>>>;
+
+    // Defaults and explicit values that are the same everywhere.
+    {
+        auto mech = arb::mechanism(type, iface);
+        param_values values = {{"P1", std::vector<arb_value_type>(ncv, 2.)}};
+        shared_state.instantiate(mech, 0, {}, layout, values);
+        EXPECT_EQ(uniform_kernel, mech.iface_.compute_currents);
+        EXPECT_EQ(uniform_kernel, mech.iface_.advance_state);
+    }
+    // One differing value.
+    {
+        auto mech = arb::mechanism(type, iface);
+        param_values values = {{"P1", {2., 2., 2., 3., 2.}}};
+        shared_state.instantiate(mech, 1, {}, layout, values);
+        EXPECT_EQ(general_kernel, mech.iface_.compute_currents);
+        EXPECT_EQ(general_kernel, mech.iface_.advance_state);
+    }
+    // No variants provided.
+    {
+        auto plain = iface;
+        plain.compute_currents_uniform = nullptr;
+        plain.advance_state_uniform = nullptr;
+        auto mech = arb::mechanism(type, plain);
+        shared_state.instantiate(mech, 2, {}, layout, {});
+        EXPECT_EQ(general_kernel, mech.iface_.compute_currents);
+        EXPECT_EQ(general_kernel, mech.iface_.advance_state);
+    }
+}
+
+TEST(abi, version) {
+    // Each component of the version enters the combined value.
+    EXPECT_EQ(ARB_MECH_ABI_VERSION_MAJOR*100000000L + ARB_MECH_ABI_VERSION_MINOR*10000L + ARB_MECH_ABI_VERSION_PATCH,
+              ARB_MECH_ABI_VERSION);
+    EXPECT_NE(ARB_MECH_ABI_VERSION_MAJOR*100000000L + (ARB_MECH_ABI_VERSION_MINOR-1)*10000L + ARB_MECH_ABI_VERSION_PATCH,
+              ARB_MECH_ABI_VERSION);
+}
+
+TEST(abi, reject_previous_minor) {
+    // A catalogue built against ABI 0.6 hands out an interface that ends
+    // before the uniform kernels. It must be rejected without reading the
+    // missing fields; allocate exactly the old size so that an overread is
+    // caught by the sanitizers.
+    arb_mechanism_type type{};
+    type.abi_version = ARB_MECH_ABI_VERSION_MAJOR*10000L*10000L + (ARB_MECH_ABI_VERSION_MINOR-1)*10000L;
+    type.name = "old";
+
+    auto old_size = offsetof(arb_mechanism_interface, compute_currents_uniform);
+    std::unique_ptr<char[]> bytes(new char[old_size]());
+    const auto& old_iface = *reinterpret_cast<const arb_mechanism_interface*>(bytes.get());
+
+    EXPECT_THROW(arb::mechanism(type, old_iface), arb::unsupported_abi_error);
+}
+
 #ifdef ARB_GPU_ENABLED
 
 namespace {
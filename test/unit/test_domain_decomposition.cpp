@@ -163,6 +163,9 @@ struct dummy_context {
     cell_label_range gather_cell_label_range(const cell_label_range& local_ranges) const { throw unimplemented{__FUNCTION__}; }
     cell_labels_and_gids gather_cell_labels_and_gids(const cell_labels_and_gids& local_labels_and_gids) const { throw unimplemented{__FUNCTION__}; }
     template <typename T> std::vector<T> gather(T value, int) const { throw unimplemented{__FUNCTION__}; }
+    std::vector<label_resolution_map::entry>
+    exchange_label_requests(const std::vector<label_resolution_map::entry>&,
+                            const std::vector<std::vector<label_resolution_map::key_type>>&) const { throw unimplemented{__FUNCTION__}; }
     distributed_request send_recv_nonblocking(std::size_t dest_count,
         void* dest_data,
         int dest,
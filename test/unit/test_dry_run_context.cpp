@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 
 #include <distributed_context.hpp>
+#include <arbor/context.hpp>
 #include <arbor/spike.hpp>
 
 // Test that there are no errors constructing a distributed_context from a dry_run_context
@@ -117,3 +118,65 @@ TEST(dry_run_context, gather_gids)
     EXPECT_EQ(part[3], gids.size()*3);
     EXPECT_EQ(part[4], gids.size()*4);
 }
+
+TEST(dry_run_context, rate_spikes)
+{
+    // Rank r fires at 1 kHz per cell, in total 4 kHz; rank 2 is silent.
+    arb::dry_run_info info(4, 4);
+    info.rate = [](arb::cell_gid_type gid) { return gid/4==2? 0.: 1000.; };
+    auto report = std::make_shared<arb::dry_run_report>();
+    distributed_context_handle ctx = arb::make_dry_run_context(info, report);
+
+    std::vector<arb::spike> local = {{{1u, 0u}, 1.5}};
+    std::size_t total = 0;
+    for (int k = 0; k<100; ++k) {
+        ctx->remote_ctrl_send_continue(arb::epoch(k, k, k+1.));
+        auto s = ctx->gather_spikes(local);
+        auto& part = s.partition();
+        ASSERT_EQ(5u, part.size());
+        EXPECT_EQ(1u, s.count(0));
+        EXPECT_EQ(0u, s.count(2));
+        for (unsigned r = 1; r<4; ++r) {
+            for (auto i = part[r]; i<part[r+1]; ++i) {
+                const auto& spike = s.values()[i];
+                EXPECT_EQ(r, spike.source.gid/4);
+                EXPECT_LE(k, spike.time);
+                EXPECT_GT(k+1., spike.time);
+                if (i>part[r]) EXPECT_LE(s.values()[i-1].source, spike.source);
+            }
+        }
+        total += s.size() - 1;
+    }
+
+    // Expect about 2*4*100 spikes from ranks 1 and 3.
+    EXPECT_NEAR(800., double(total), 150.);
+    EXPECT_EQ(4u, report->num_ranks);
+    EXPECT_EQ(100u, report->num_exchanges);
+    EXPECT_EQ(total + 100u, report->num_spikes);
+    EXPECT_LT(0., report->exchange_time);
+    EXPECT_LE(report->max_exchange_time, report->exchange_time);
+}
+
+TEST(dry_run_context, trace_spikes)
+{
+    // The trace covers two ranks' worth of cells.
+    arb::dry_run_info info(4, 2);
+    info.trace = {
+        {{0u, 0u}, 0.5},
+        {{3u, 1u}, 0.25},
+        {{2u, 0u}, 1.5},
+    };
+    distributed_context_handle ctx = arb::make_dry_run_context(info);
+
+    ctx->remote_ctrl_send_continue(arb::epoch(0, 0., 1.));
+    auto s = ctx->gather_spikes({});
+
+    // Ranks 1 and 3 replay the second range, rank 2 the first one.
+    std::vector<arb::spike> expected = {
+        {{3u, 1u}, 0.25},
+        {{4u, 0u}, 0.5},
+        {{7u, 1u}, 0.25},
+    };
+    EXPECT_EQ(expected, s.values());
+    EXPECT_EQ((std::vector<unsigned>{0, 0, 1, 2, 3}), s.partition());
+}
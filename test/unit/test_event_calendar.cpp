@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <arbor/spike_event.hpp>
+
+#include "event_calendar.hpp"
+
+using namespace arb;
+
+TEST(event_calendar, take) {
+    event_calendar cal(0.5);
+    EXPECT_TRUE(cal.empty());
+
+    cal.insert(pse_vector{{2u, 1.2, 1.f}, {0u, 0.1, 1.f}, {1u, 1.2, 1.f}, {0u, 0.6, 2.f}, {0u, 0.6, 1.f}});
+    EXPECT_EQ(5u, cal.size());
+
+    // Events due in [0, 0.6): the partly due bucket keeps the rest.
+    pse_vector out;
+    cal.take(0.6, out);
+    EXPECT_EQ((pse_vector{{0u, 0.1, 1.f}}), out);
+    EXPECT_EQ(4u, cal.size());
+
+    // Taken events are appended in full key order.
+    cal.take(1.25, out);
+    EXPECT_EQ((pse_vector{{0u, 0.1, 1.f}, {0u, 0.6, 1.f}, {0u, 0.6, 2.f}, {1u, 1.2, 1.f}, {2u, 1.2, 1.f}}), out);
+    EXPECT_TRUE(cal.empty());
+
+    // Late events are delivered with the next take.
+    cal.insert({3u, 0.2, 1.f});
+    out.clear();
+    cal.take(1.5, out);
+    EXPECT_EQ((pse_vector{{3u, 0.2, 1.f}}), out);
+}
+
+TEST(event_calendar, far_events) {
+    // Exercise the ring, its growth, and the heap beyond it with delays of
+    // up to several hundred buckets, taken in epochs of varying length.
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> delay(0, 200);
+
+    const time_type width = 0.25;
+    event_calendar cal(width);
+    pse_vector all, taken, out;
+
+    time_type t = 0;
+    while (t<300) {
+        for (int i = 0; i<20; ++i) {
+            spike_event ev{cell_lid_type(i%3), t+delay(rng), float(i%2)};
+            cal.insert(ev);
+            all.push_back(ev);
+        }
+        // Change the width midway, as after a change of connections.
+        if (t>100 && cal.width()==width) cal.set_width(2*width);
+
+        auto t_next = t + (rng()%3+1)*width;
+        out.clear();
+        cal.take(t_next, out);
+        EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+        for (auto& ev: out) {
+            EXPECT_GE(ev.time, t);
+            EXPECT_LT(ev.time, t_next);
+        }
+        taken.insert(taken.end(), out.begin(), out.end());
+        t = t_next;
+    }
+    cal.take(1e9, taken);
+    EXPECT_TRUE(cal.empty());
+
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(all, taken);
+
+    cal.insert(all);
+    cal.clear();
+    EXPECT_TRUE(cal.empty());
+}
@@ -76,6 +76,23 @@ TEST(event_generators, regular) {
     EXPECT_EQ(expected({12, 12.5}), as_vector(gen.events(12, 12.7)));
 }
 
+TEST(event_generators, multiple_targets) {
+    // One schedule delivered to three targets; events at the same time are
+    // ordered by target, then weight, regardless of the order given.
+    event_generator gen({{{"b"}, 2.f}, {{"a"}, 1.f}, {{"b"}, 0.5f}},
+                        explicit_schedule_from_milliseconds(std::vector<time_type>{1., 3.}));
+    EXPECT_THROW(gen.events(0, 5), arbor_internal_error);
+    gen.resolve_label([](const cell_local_label_type& l) { return l.tag=="a"? 4: 7; });
+
+    pse_vector expected = {
+        {4, 1., 1.f}, {7, 1., 0.5f}, {7, 1., 2.f},
+        {4, 3., 1.f}, {7, 3., 0.5f}, {7, 3., 2.f}};
+    EXPECT_EQ(expected, as_vector(gen.events(0, 5)));
+
+    gen.reset();
+    EXPECT_EQ(pse_vector(expected.begin()+3, expected.end()), as_vector(gen.events(2, 5)));
+}
+
 using lse_vector = std::vector<std::tuple<cell_local_label_type, time_type, float>>;
 
 TEST(event_generators, seq) {
@@ -1,6 +1,8 @@
+#include <string>
 #include <vector>
 
 #include <arbor/mechanism.hpp>
+#include <arbor/mechcat.hpp>
 #include <arbor/version.hpp>
 
 #include "backends/multicore/fvm.hpp"
@@ -38,17 +40,23 @@ ACCESS_BIND(std::unique_ptr<shared_state> fvm_cell::*, private_state_ptr, &fvm_c
 //      expected value of each variable after the time step
 //  dt
 //      size of the time step
+//  n_steps
+//      number of time steps taken before checking t1_values
+//  cat
+//      catalogue providing the mechanism
+//
+// Returns the values of the state variables after the last step.
 template <typename backend>
-void run_test(std::string mech_name,
+std::vector<arb_value_type> run_test(std::string mech_name,
         std::vector<std::string> state_variables,
         std::vector<arb_value_type> t0_values,
         std::vector<arb_value_type> t1_values,
-        arb_value_type dt) {
+        arb_value_type dt,
+        unsigned n_steps = 1,
+        const mechanism_catalogue& cat = make_unit_test_catalogue()) {
 
     auto thread_pool = std::make_shared<arb::threading::task_system>();
 
-    auto cat = make_unit_test_catalogue();
-
     // Create a single compartment cell
     arb_size_type ncell = 1;
     arb_size_type ncv = 1;
@@ -93,11 +101,13 @@ void run_test(std::string mech_name,
     }
 
     // TODO: here is the gotcha!
-    // Perform time step
-    shared_state->update_time_to(timestep_range(dt, dt)[0]);
-    mech->set_dt(shared_state->dt);
+    // Perform time steps
+    for (auto ts: timestep_range(n_steps*dt, dt)) {
+        shared_state->update_time_to(ts);
+        mech->set_dt(shared_state->dt);
 
-    mech->update_state();
+        mech->update_state();
+    }
 
     // Test the values of state variables
     if (!t1_values.empty()) {
@@ -107,6 +117,12 @@ void run_test(std::string mech_name,
             }
         }
     }
+
+    std::vector<arb_value_type> values;
+    for (const auto& var: state_variables) {
+        values.push_back(mechanism_field(mech.get(), var).at(0));
+    }
+    return values;
 }
 
 TEST(mech_kinetic, kinetic_linear_scaled) {
@@ -179,6 +195,50 @@ TEST(mech_kinetic, kinetic_nonlinear_scaled) {
     run_test<multicore::backend>("test4_kin_compartment", state_variables, t0_values, t1_values, 0.1);
 }
 
+#if defined(MODCC) && defined(JIT_INCLUDE_DIRS)
+// Fast binding followed by slow conversion: with the Jacobian taken at the
+// start of each step, the three Newton iterations converge more slowly than
+// full Newton, but the trajectories must agree.
+TEST(mech_kinetic, nonlinear_reuse_jacobian) {
+    const char* stiff = R"(
+        NEURON { SUFFIX jit_stiff }
+        STATE { a b c d }
+        INITIAL {
+            a = 1
+            b = 0.5
+            c = 0
+            d = 0
+        }
+        BREAKPOINT {
+            SOLVE states METHOD sparse
+        }
+        KINETIC states {
+            ~ a + b <-> c (1000, 1)
+            ~ c <-> d (2, 0.5)
+        }
+    )";
+
+    compile_catalogue_options opt;
+    opt.modcc = MODCC;
+    opt.include_dirs = {JIT_INCLUDE_DIRS};
+    opt.cache_dir = LIBDIR "/jit-cache";
+    auto full = compile_catalogue({stiff}, opt);
+    opt.modcc_flags.push_back("--reuse-jacobian");
+    auto reuse = compile_catalogue({stiff}, opt);
+
+    std::vector<std::string> state_variables = {"a", "b", "c", "d"};
+    auto expected = run_test<multicore::backend>("jit_stiff", state_variables, {}, {}, 0.025, 40, full);
+    auto values = run_test<multicore::backend>("jit_stiff", state_variables, {}, {}, 0.025, 40, reuse);
+
+    // The reused Jacobian still conserves a - b and a + c + d.
+    EXPECT_NEAR(0.5, values[0] - values[1], 1e-9);
+    EXPECT_NEAR(1.0, values[0] + values[2] + values[3], 1e-9);
+    for (unsigned i = 0; i<state_variables.size(); ++i) {
+        EXPECT_NEAR(expected[i], values[i], 1e-3);
+    }
+}
+#endif
+
 TEST(mech_linear, linear_system) {
     std::vector<std::string> state_variables = {"h", "s", "d"};
     std::vector<arb_value_type> values = {0.5, 0.2, 0.3};
@@ -5,6 +5,7 @@
 
 #include <arbor/arbexcept.hpp>
 
+#include "distributed_context.hpp"
 #include "label_resolution.hpp"
 
 using namespace arb;
@@ -326,3 +327,85 @@ TEST(test_label_resolution, policies) {
     }
 }
 
+
+TEST(test_label_resolution, entries) {
+    using vec = std::vector<cell_lid_type>;
+    using entry = label_resolution_map::entry;
+
+    // Ranges of one label keep their order, regardless of interleaving with other labels and cells.
+    std::vector<entry> entries = {{3, hash_value("b"), {4, 6}},
+                                  {1, hash_value("a"), {0, 2}},
+                                  {3, hash_value("a"), {1, 2}},
+                                  {3, hash_value("b"), {0, 1}},
+                                  {1, hash_value("a"), {7, 8}}};
+    auto res_map = label_resolution_map(entries);
+    EXPECT_EQ(3u, res_map.size());
+
+    EXPECT_EQ(1u, res_map.count(1, "a"));
+    EXPECT_EQ(0u, res_map.count(1, "b"));
+    EXPECT_EQ(0u, res_map.count(2, "a"));
+    EXPECT_EQ(nullptr, res_map.find(2, hash_value("a")));
+
+    auto rset = res_map.at(1, "a");
+    EXPECT_EQ(lid_range(0, 2), rset.ranges.at(0));
+    EXPECT_EQ(lid_range(7, 8), rset.ranges.at(1));
+    EXPECT_EQ((vec{0u, 2u, 3u}), rset.ranges_partition);
+
+    rset = res_map.at(3, "b");
+    EXPECT_EQ(lid_range(4, 6), rset.ranges.at(0));
+    EXPECT_EQ(lid_range(0, 1), rset.ranges.at(1));
+    EXPECT_EQ((vec{0u, 2u, 3u}), rset.ranges_partition);
+
+    auto lid_resolver = arb::resolver(&res_map);
+    EXPECT_EQ(4u, lid_resolver.resolve({3, "b", lid_selection_policy::round_robin}));
+    EXPECT_EQ(5u, lid_resolver.resolve({3, "b", lid_selection_policy::round_robin}));
+    EXPECT_EQ(0u, lid_resolver.resolve({3, "b", lid_selection_policy::round_robin}));
+
+    entries.push_back({2, hash_value("c"), {3, 1}});
+    EXPECT_THROW(label_resolution_map{entries}, arb::arbor_internal_error);
+
+    // Duplicate gids are only rejected for labels of cells.
+    std::vector<cell_gid_type> gids = {0, 0};
+    std::vector<cell_size_type> sizes = {1, 1};
+    std::vector<cell_tag_type> labels = {"a", "b"};
+    std::vector<lid_range> ranges = {{0, 1}, {0, 1}};
+    EXPECT_THROW(label_resolution_map(cell_labels_and_gids({sizes, labels, ranges}, gids)), arb::arbor_internal_error);
+}
+
+TEST(test_label_resolution, on_demand) {
+    std::vector<cell_gid_type> gids = {0, 1, 2};
+    std::vector<cell_size_type> sizes = {2, 1, 2};
+    std::vector<cell_tag_type> labels = {"l0_0", "l0_1", "l1_0", "l2_0", "l2_0"};
+    std::vector<lid_range> ranges = {{0, 1}, {1, 3}, {0, 2}, {4, 5}, {0, 1}};
+    auto local = cell_labels_and_gids({sizes, labels, ranges}, gids);
+
+    // Only requested pairs are stored, unknown pairs are skipped.
+    std::vector<label_resolution_map::key_type> required = {{2, hash_value("l2_0")},
+                                                            {0, hash_value("l0_1")},
+                                                            {2, hash_value("l2_0")},
+                                                            {7, hash_value("l7_0")}};
+    {
+        auto res_map = make_resolution_map(local, required, [](cell_gid_type) { return 0; }, distributed_context{});
+        EXPECT_EQ(2u, res_map.size());
+        EXPECT_EQ(0u, res_map.count(0, "l0_0"));
+        EXPECT_EQ(0u, res_map.count(1, "l1_0"));
+        EXPECT_EQ(0u, res_map.count(7, "l7_0"));
+
+        auto full_map = label_resolution_map(local);
+        for (const auto& [gid, tag]: {std::pair<cell_gid_type, cell_tag_type>{0, "l0_1"}, {2, "l2_0"}}) {
+            EXPECT_EQ(1u, res_map.count(gid, tag));
+            EXPECT_EQ(full_map.at(gid, tag).ranges, res_map.at(gid, tag).ranges);
+            EXPECT_EQ(full_map.at(gid, tag).ranges_partition, res_map.at(gid, tag).ranges_partition);
+        }
+    }
+    // The dry run context emulates further ranks holding the same cells, offset by the tile size.
+    {
+        auto ctx = make_dry_run_context(3, 10);
+        required.push_back({21, hash_value("l1_0")});
+        auto res_map = make_resolution_map(local, required, [](cell_gid_type gid) { return int(gid/10); }, *ctx);
+        EXPECT_EQ(3u, res_map.size());
+        EXPECT_EQ(1u, res_map.count(21, "l1_0"));
+        EXPECT_EQ(0u, res_map.count(1, "l1_0"));
+        EXPECT_EQ(lid_range(0, 2), res_map.at(21, "l1_0").ranges.front());
+    }
+}
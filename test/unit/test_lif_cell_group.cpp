@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 #include "common.hpp"
 
 #include <arbor/arbexcept.hpp>
@@ -193,6 +195,45 @@ TEST(lif_cell_group, spikes) {
     EXPECT_EQ(4u, sim.num_spikes());
 }
 
+// Path recipe answering queries for cell descriptions in batches only.
+class batched_path_recipe: public path_recipe {
+public:
+    batched_path_recipe(cell_size_type n, float weight, float delay, std::size_t extra = 0):
+        path_recipe(n, weight, delay), extra_(extra) {}
+
+    util::unique_any get_cell_description(cell_gid_type gid) const override {
+        throw std::logic_error("descriptions must be queried in batches");
+    }
+
+    std::vector<util::unique_any> get_cell_descriptions(const std::vector<cell_gid_type>& gids) const override {
+        std::vector<util::unique_any> cells;
+        for (std::size_t i = 0; i < gids.size() + extra_; ++i) cells.emplace_back(lif_cell("src", "tgt"));
+        ++num_batches;
+        return cells;
+    }
+
+    // groups are constructed in parallel
+    mutable std::atomic<std::size_t> num_batches = 0;
+
+private:
+    std::size_t extra_;
+};
+
+TEST(lif_cell_group, batched_descriptions) {
+    batched_path_recipe recipe(4, 1000, 0.1);
+    auto context = make_context();
+    auto decomp = partition_load_balance(recipe, context);
+    simulation sim(recipe, context, decomp);
+    EXPECT_EQ(decomp.num_groups(), recipe.num_batches.load());
+
+    sim.run(100*U::ms, 0.01*U::ms);
+    // two spikes per neuron, as for the path recipe
+    EXPECT_EQ(8u, sim.num_spikes());
+
+    batched_path_recipe bad_recipe(4, 1000, 0.1, 1);
+    EXPECT_THROW(simulation(bad_recipe, context, decomp), bad_cell_description_count);
+}
+
 TEST(lif_cell_group, ring)
 {
     // Total number of LIF cells.
@@ -1,3 +1,4 @@
+#include <utility>
 #include <vector>
 
 #include <arbor/mechanism.hpp>
@@ -121,14 +122,64 @@ void run_diam_test() {
     EXPECT_EQ(area, mechanism_field(mech, "a"));
 }
 
+// The table of a function of a global parameter is sampled when the
+// mechanism is initialised, with the values of its globals.
+template <typename backend>
+void run_table_test() {
+    auto thread_pool = std::make_shared<arb::threading::task_system>();
+
+    auto cat = make_unit_test_catalogue();
+    cat.derive("table_test_q3", "table_test", {{"q", 3.}});
+
+    arb_size_type ncell = 1;
+    arb_size_type ncv = 3;
+    std::vector<arb_index_type> cv_to_cell(ncv, 0);
+    std::vector<arb_value_type> temp(ncv, 300.);
+    std::vector<arb_value_type> diam(ncv, 1.);
+    std::vector<arb_value_type> area(ncv, 10.);
+    std::vector<arb_value_type> vinit(ncv, -65);
+    std::vector<arb_index_type> src_to_spike = {};
+
+    for (auto [name, q]: {std::pair{"table_test", 2.}, std::pair{"table_test_q3", 3.}}) {
+        auto instance = cat.instance(backend::kind, name);
+        auto& mech = instance.mech;
+        auto shared_state = std::make_unique<typename backend::shared_state>(thread_pool, ncell, ncv, cv_to_cell,
+                                                                             vinit, temp, diam, area,
+                                                                             src_to_spike,
+                                                                             fvm_detector_info{},
+                                                                             mech->data_alignment());
+
+        mechanism_layout layout;
+        layout.weight.assign(ncv, 1.);
+        for (arb_size_type i = 0; i<ncv; ++i) {
+            layout.cv.push_back(i);
+        }
+
+        shared_state->instantiate(*mech, 0, instance.overrides, layout, {});
+        shared_state->reset();
+        mech->initialize();
+
+        std::vector<arb_value_type> expected(ncv, q*-65);
+        EXPECT_EQ(expected, mechanism_field(mech.get(), "s"));
+    }
+}
+
 TEST(mech_temperature, celsius) {
     run_celsius_test<multicore::backend>();
     run_diam_test<multicore::backend>();
 }
 
+TEST(mech_table, global) {
+    run_table_test<multicore::backend>();
+}
+
 #ifdef ARB_GPU_ENABLED
 TEST(mech_temperature_gpu, celsius) {
     run_celsius_test<gpu::backend>();
     run_diam_test<gpu::backend>();
 }
+
+TEST(mech_table_gpu, global) {
+    run_table_test<gpu::backend>();
+}
 #endif
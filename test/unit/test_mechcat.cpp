@@ -1,3 +1,5 @@
+#include <filesystem>
+#include <iterator>
 #include <string>
 
 #include <arbor/arbexcept.hpp>
@@ -294,6 +296,39 @@ TEST(mechcat, loading) {
 #endif
 }
 
+#if defined(MODCC) && defined(JIT_INCLUDE_DIRS)
+TEST(mechcat, compiling) {
+    const char* pas = R"(
+        NEURON { SUFFIX jit_pas NONSPECIFIC_CURRENT i RANGE g }
+        PARAMETER { g = 0.001 e = -70 }
+        BREAKPOINT { i = g*(v - e) }
+    )";
+
+    compile_catalogue_options opt;
+    opt.modcc = MODCC;
+    opt.include_dirs = {JIT_INCLUDE_DIRS};
+    opt.cache_dir = LIBDIR "/jit-cache";
+    std::filesystem::remove_all(opt.cache_dir);
+
+    auto cat = compile_catalogue({pas}, opt);
+    EXPECT_EQ(std::vector<std::string>{"jit_pas"}, cat.mechanism_names());
+    EXPECT_EQ(1u, cat["jit_pas"].parameters.count("g"));
+
+    // The second request is served from the cache.
+    auto n_cached = [&] {
+        auto it = std::filesystem::directory_iterator(opt.cache_dir);
+        return std::distance(begin(it), end(it));
+    };
+    EXPECT_EQ(1, n_cached());
+    EXPECT_EQ(std::vector<std::string>{"jit_pas"}, compile_catalogue({pas}, opt).mechanism_names());
+    EXPECT_EQ(1, n_cached());
+
+    EXPECT_THROW(compile_catalogue({"NEURON { SUFFIX"}, opt), catalogue_compile_error);
+    // A failed build leaves nothing behind in the cache.
+    EXPECT_EQ(1, n_cached());
+}
+#endif
+
 TEST(mechcat, derived_info) {
     auto cat = build_fake_catalogue();
 
@@ -5,6 +5,8 @@
 
 #include "network_impl.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <tuple>
 #include <vector>
 
@@ -445,6 +447,50 @@ TEST(network_selection, random_reproducibility) {
     };
 }
 
+TEST(network_selection, random_bernoulli) {
+    // constant probability intersected with other selections can be skip sampled
+    const auto s1 = thingify(intersect(network_selection::random(42, 0.1),
+                                 network_selection::source_cell_kind(cell_kind::cable),
+                                 network_selection::inter_cell()),
+        network_label_dict());
+    const auto b1 = s1->bernoulli();
+    ASSERT_TRUE(b1.has_value());
+    EXPECT_EQ(42u, b1->seed);
+    EXPECT_DOUBLE_EQ(0.1, b1->probability);
+    EXPECT_EQ(2u, b1->predicates.size());
+
+    // probability depending on source or target requires evaluation per pair
+    const auto s2 =
+        thingify(network_selection::random(42, network_value::distance(0.1)), network_label_dict());
+    EXPECT_FALSE(s2->bernoulli().has_value());
+
+    const auto s3 = thingify(join(network_selection::random(42, 0.1), network_selection::all()),
+        network_label_dict());
+    EXPECT_FALSE(s3->bernoulli().has_value());
+}
+
+TEST(network_selection, skip_sampler) {
+    const double p = 0.05;
+    const std::uint64_t n = 100000;
+
+    auto count_selected = [&](cell_gid_type gid, std::uint64_t block) {
+        network_skip_sampler sampler(42, p, gid, 0, block);
+        std::vector<std::uint64_t> selected;
+        for (auto idx = sampler.next(); idx < n; idx += 1 + sampler.next()) selected.push_back(idx);
+        return selected;
+    };
+
+    // reproducible for identical source and block
+    const auto a = count_selected(3, 7);
+    EXPECT_EQ(a, count_selected(3, 7));
+    EXPECT_NE(a, count_selected(4, 7));
+    EXPECT_NE(a, count_selected(3, 8));
+
+    // expected number of selected indices is n*p with standard deviation sqrt(n*p*(1-p))
+    const double sigma = std::sqrt(n * p * (1 - p));
+    EXPECT_NEAR(double(a.size()), n * p, 5 * sigma);
+}
+
 TEST(network_selection, custom) {
     auto inter_cell_func = [](const network_site_info& source, const network_site_info& target) {
         return source.gid != target.gid;
@@ -1156,6 +1156,157 @@ void run_total_current_probe_test(context ctx) {
 }
 
 
+template <typename Backend>
+void run_extracellular_probe_test(context ctx) {
+    // The extracellular potential is the line source transfer applied to the
+    // total membrane currents; the probe folds both into one matrix over the
+    // raw data, which must agree with applying the transfer to the samples of
+    // cable_probe_total_current_cell.
+
+    auto m = make_y_morphology();
+    decor d;
+    d.place(mlocation{0, 0}, i_clamp(0.3*U::nA), "clamp0");
+    d.paint(reg::all(), density("ca_linear", {{"g", 0.01}})); // [S/cm²]
+    d.set_default(membrane_capacitance{0.01*U::F/U::m2}); // [F/m²]
+    d.set_default(cv_policy_fixed_per_branch(3, cv_policy_flag::interior_forks));
+    std::vector<cable_cell> cells = {{m, d}};
+
+    std::vector<mpoint> electrodes = {{10, 20, 0, 0}, {-30, 5, 12, 0}, {200, -50, 0, 0}};
+    const double sigma = 0.5; // [S/m]
+    auto t_end = 2.5*U::ms;
+
+    auto currents = run_simple_sampler<std::vector<double>, mcable_list>(ctx, t_end, cells,
+                                                                         {0, "Itotal"},
+                                                                         cable_probe_total_current_cell{},
+                                                                         {0.1*U::ms, 2*U::ms}).at(0);
+
+    auto potentials = run_simple_sampler<std::vector<double>, std::vector<mpoint>>(ctx, t_end, cells,
+                                                                                   {0, "phi"},
+                                                                                   cable_probe_extracellular_potential{electrodes, sigma},
+                                                                                   {0.1*U::ms, 2*U::ms}).at(0);
+
+    ASSERT_EQ(electrodes, potentials.meta);
+    ASSERT_EQ(2u, currents.size());
+    ASSERT_EQ(2u, potentials.size());
+
+    auto n_cable = currents.meta.size();
+    auto transfer = fvm_line_source_transfer(cells[0], currents.meta, electrodes, sigma);
+    for (unsigned j: {0u, 1u}) {
+        ASSERT_EQ(electrodes.size(), potentials[j].v.size());
+        for (auto e: util::count_along(electrodes)) {
+            // Membrane currents sum to (almost) zero: compare relative to
+            // the magnitude of the individual contributions.
+            double expected = 0, scale = 0;
+            for (auto c: util::make_span(n_cable)) {
+                double contrib = transfer[e*n_cable+c]*currents[j].v[c];
+                expected += contrib;
+                scale += std::abs(contrib);
+            }
+
+            EXPECT_NE(0., expected);
+            EXPECT_NEAR(expected, potentials[j].v[e], 1e-9*scale);
+        }
+    }
+
+    // With a cutoff, the currents of CVs with a small transfer are ignored,
+    // so the error is bounded by the cutoff times the largest transfer and
+    // the total magnitude of the currents.
+    const double cutoff = 0.2;
+    auto approx = run_simple_sampler<std::vector<double>, std::vector<mpoint>>(ctx, t_end, cells,
+                                                                               {0, "phi"},
+                                                                               cable_probe_extracellular_potential{electrodes, sigma, cutoff},
+                                                                               {0.1*U::ms, 2*U::ms}).at(0);
+    ASSERT_EQ(2u, approx.size());
+    for (unsigned j: {0u, 1u}) {
+        ASSERT_EQ(electrodes.size(), approx[j].v.size());
+        for (auto e: util::count_along(electrodes)) {
+            double T_max = 0, I_sum = 0;
+            for (auto c: util::make_span(n_cable)) {
+                T_max = std::max(T_max, std::abs(transfer[e*n_cable+c]));
+                I_sum += std::abs(currents[j].v[c]);
+            }
+            EXPECT_NEAR(potentials[j].v[e], approx[j].v[e], cutoff*T_max*I_sum);
+        }
+    }
+}
+
+template <typename Backend>
+void run_reduction_probe_test(context ctx) {
+    // Reductions computed by the back-end should agree with the reduction
+    // of the corresponding per-cable samples.
+
+    auto m = make_y_morphology();
+    decor d;
+    d.place(mlocation{0, 0}, i_clamp(0.3*U::nA), "clamp0");
+    d.place(mlocation{1, 0.5}, synapse("expsyn"), "syn0");
+    d.place(mlocation{2, 0.5}, synapse("expsyn"), "syn1");
+    d.paint(reg::all(), density("ca_linear", {{"g", 0.01}})); // [S/cm²]
+    d.set_default(membrane_capacitance{0.01*U::F/U::m2}); // [F/m²]
+    d.set_default(cv_policy_fixed_per_branch(3));
+    std::vector<cable_cell> cells = {{m, d}};
+
+    auto t_end = 2.5*U::ms;
+    std::vector<U::quantity> when = {0.1*U::ms, 2*U::ms};
+    region reg = reg::branch(0);
+
+    // Reductions are only implemented by the multicore back-end.
+    if constexpr (!std::is_same_v<Backend, multicore::backend>) {
+        EXPECT_THROW((run_simple_sampler<double, cable_probe_reduction_info>(ctx, t_end, cells, {0, "v-mean"},
+                                                                             cable_probe_membrane_voltage_mean{reg}, when)),
+                     arbor_exception);
+        return;
+    }
+
+    auto voltages = run_simple_sampler<std::vector<double>, mcable_list>(ctx, t_end, cells, {0, "v"},
+                                                                         cable_probe_membrane_voltage_cell{}, when).at(0);
+    auto currents = run_simple_sampler<std::vector<double>, mcable_list>(ctx, t_end, cells, {0, "i"},
+                                                                         cable_probe_total_ion_current_cell{}, when).at(0);
+    auto states = run_simple_sampler<std::vector<double>, std::vector<cable_probe_point_info>>(ctx, t_end, cells, {0, "g"},
+                                                                                               cable_probe_point_state_cell{"expsyn", "g"}, when).at(0);
+
+    auto v_mean = run_simple_sampler<double, cable_probe_reduction_info>(ctx, t_end, cells, {0, "v-mean"},
+                                                                         cable_probe_membrane_voltage_mean{reg}, when).at(0);
+    auto i_sum = run_simple_sampler<double, cable_probe_reduction_info>(ctx, t_end, cells, {0, "i-sum"},
+                                                                        cable_probe_total_ion_current_sum{reg::all()}, when).at(0);
+    auto g_sum = run_simple_sampler<double, cable_probe_reduction_info>(ctx, t_end, cells, {0, "g-sum"},
+                                                                        cable_probe_point_state_sum{"expsyn", "g"}, when).at(0);
+
+    // Bin edges straddle the mean voltage over the region at the first sample.
+    ASSERT_EQ(2u, v_mean.size());
+    std::vector<double> edges = {-1000, v_mean[0].v, 1000};
+    auto v_hist = run_simple_sampler<std::vector<double>, cable_probe_reduction_info>(ctx, t_end, cells, {0, "v-hist"},
+                                                                                      cable_probe_membrane_voltage_histogram{reg, edges}, when).at(0);
+
+    ASSERT_FALSE(v_mean.meta.cables.empty());
+    for (auto c: v_mean.meta.cables) EXPECT_EQ(0u, c.branch);
+    EXPECT_TRUE(v_mean.meta.edges.empty());
+    EXPECT_EQ(edges, v_hist.meta.edges);
+    EXPECT_EQ(2u, g_sum.meta.points.size());
+
+    const auto& embedding = cells[0].embedding();
+    for (unsigned j: {0u, 1u}) {
+        double v_area = 0, area = 0, below = 0;
+        for (auto k: util::count_along(voltages.meta)) {
+            auto cable = voltages.meta[k];
+            if (cable.branch!=0) continue;
+            double a = embedding.integrate_area(cable);
+            area += a;
+            v_area += a*voltages[j].v[k];
+            if (voltages[j].v[k]<edges[1]) below += a;
+        }
+        EXPECT_TRUE(testing::near_relative(v_area/area, v_mean[j].v, 1e-9));
+
+        ASSERT_EQ(2u, v_hist[j].v.size());
+        EXPECT_TRUE(testing::near_relative(below/area, v_hist[j].v[0], 1e-12));
+        EXPECT_TRUE(testing::near_relative(1., v_hist[j].v[0]+v_hist[j].v[1], 1e-12));
+
+        double i_total = util::sum(currents[j].v), i_scale = util::sum_by(currents[j].v, [](double i) { return std::abs(i); });
+        EXPECT_NEAR(i_total, i_sum[j].v, 1e-9*i_scale);
+
+        EXPECT_DOUBLE_EQ(util::sum(states[j].v), g_sum[j].v);
+    }
+}
+
 template <typename Backend>
 void run_stimulus_probe_test(context ctx) {
     // Model two simple stick cable cells, 3 CVs each, and stimuli on cell 0, cv 1
@@ -1338,7 +1489,9 @@ void run_exact_sampling_probe_test(context ctx) {
     axial_and_ion_current_sampled, \
     partial_density, \
     multi, \
-    total_current
+    total_current, \
+    extracellular, \
+    reduction
 
 #undef RUN_MULTICORE
 #define RUN_MULTICORE(x) \
@@ -1414,3 +1567,53 @@ TEST(probe, get_probe_metadata) {
     EXPECT_EQ((mlocation{2, 1.}), locs[1]);
     EXPECT_EQ((mlocation{5, 1.}), locs[2]);
 }
+
+TEST(probe, take_samples) {
+    // Sample events copy runs of registered handles into the sample buffer;
+    // reductions are evaluated first, so that their results can be sampled.
+    using shared_state = multicore::backend::shared_state;
+
+    auto thread_pool = std::make_shared<threading::task_system>(1);
+    std::vector<arb_value_type> v = {-60, -50, -40, -30};
+    shared_state state(thread_pool, 1, v.size(),
+                       std::vector<arb_index_type>(v.size(), 0), // cv -> cell
+                       v,                                        // U_m
+                       std::vector<arb_value_type>(v.size(), 300), // T
+                       std::vector<arb_value_type>(v.size(), 1.),  // diameter
+                       {1, 2, 3, 4},                               // area
+                       {},                                         // src -> spike
+                       fvm_detector_info{},
+                       1);
+    state.reset();
+
+    const arb_value_type* V = state.voltage.data();
+    auto mean = state.add_reduction({V, V+1, V+2, V+3}, {0.1, 0.2, 0.3, 0.4});
+    auto hist = state.add_reduction({V, V+1, V+2, V+3}, {0.1, 0.2, 0.3, 0.4}, {-100, -45, 0});
+
+    std::vector<probe_handle> handles = {V+2, nullptr, mean, hist, hist+1};
+    EXPECT_EQ(0u, state.add_sample_handles(handles.data(), handles.data()+handles.size()));
+
+    std::vector<std::vector<sample_event>> events = {{
+        sample_event{0., {0, 5, 0}},
+        sample_event{0., {2, 1, 5}}
+    }};
+    state.begin_epoch({}, events, timestep_range(0.1, 0.1));
+    state.take_samples();
+
+    std::vector<arb_value_type> expected = {-40, 0, -40, 0.3, 0.7, -40};
+    for (auto i: util::count_along(expected)) {
+        EXPECT_DOUBLE_EQ(expected[i], state.sample_value[i]);
+        EXPECT_EQ(0., state.sample_time[i]);
+    }
+
+    // Only the reductions read by the marked events are evaluated: the
+    // histogram keeps its results when only the mean is sampled.
+    state.voltage[0] = 0;
+    events = {{sample_event{0., {2, 1, 0}}}};
+    state.begin_epoch({}, events, timestep_range(0.1, 0.1));
+    state.take_samples();
+    EXPECT_DOUBLE_EQ(-34, state.sample_value[0]);
+    EXPECT_DOUBLE_EQ(-34, mean[0]);
+    EXPECT_DOUBLE_EQ(0.3, hist[0]);
+    EXPECT_DOUBLE_EQ(0.7, hist[1]);
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arbor/context.hpp>
+#include <arbor/profile/profiler.hpp>
+
+#include "profile/profiler_macro.hpp"
+
+using namespace arb;
+
+namespace {
+context make_serial_context() {
+    proc_allocation resources;
+    resources.num_threads = 1;
+    resources.gpu_id = -1;
+    return make_context(resources);
+}
+
+std::size_t count_of(const profile::profile& p, const std::string& name) {
+    auto it = std::find(p.names.begin(), p.names.end(), name);
+    return it==p.names.end()? 0: p.counts[it - p.names.begin()];
+}
+
+std::size_t count_substr(const std::string& s, const std::string& sub) {
+    std::size_t n = 0;
+    for (auto pos = s.find(sub); pos!=std::string::npos; pos = s.find(sub, pos+1)) ++n;
+    return n;
+}
+}
+
+TEST(profiler, switch) {
+    auto ctx = make_serial_context();
+
+    profile::profiler_initialize(ctx);
+    EXPECT_TRUE(profile::profiler_enabled());
+    for (int i = 0; i<3; ++i) {
+        PE(test:switch:a);
+        PL();
+    }
+    PE(test:switch:b);
+    PL();
+
+    profile::profiler_finalize();
+    EXPECT_FALSE(profile::profiler_enabled());
+    PE(test:switch:a);
+    PL();
+    PE(test:switch:c);
+    PL();
+
+    auto p = profile::profiler_summary();
+    EXPECT_EQ(3u, count_of(p, "test:switch:a"));
+    EXPECT_EQ(1u, count_of(p, "test:switch:b"));
+    EXPECT_EQ(0u, count_of(p, "test:switch:c"));
+    EXPECT_TRUE(p.counter_names.empty());
+
+    // Initialization starts a new recording.
+    profile::profiler_initialize(ctx);
+    PE(test:switch:b);
+    PL();
+    profile::profiler_finalize();
+    p = profile::profiler_summary();
+    EXPECT_EQ(0u, count_of(p, "test:switch:a"));
+    EXPECT_EQ(1u, count_of(p, "test:switch:b"));
+}
+
+TEST(profiler, switch_inside_region) {
+    auto ctx = make_serial_context();
+
+    // Regions are only recorded if entered and left in the same recording.
+    PE(test:toggle:a);
+    profile::profiler_initialize(ctx);
+    PL();
+    PE(test:toggle:b);
+    profile::profiler_finalize();
+    PL();
+    profile::profiler_initialize(ctx);
+    PE(test:toggle:c);
+    PL();
+    profile::profiler_finalize();
+
+    auto p = profile::profiler_summary();
+    EXPECT_EQ(0u, count_of(p, "test:toggle:a"));
+    EXPECT_EQ(0u, count_of(p, "test:toggle:b"));
+    EXPECT_EQ(1u, count_of(p, "test:toggle:c"));
+}
+
+TEST(profiler, switch_concurrent) {
+    auto ctx = make_serial_context();
+
+    // Other threads may enter and leave regions while the profiler is
+    // initialized and finalized.
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i<4; ++i) {
+        threads.emplace_back([&done] {
+            while (!done) {
+                PE(test:concurrent);
+                PL();
+            }
+        });
+    }
+    for (int i = 0; i<100; ++i) {
+        profile::profiler_initialize(ctx);
+        PE(test:concurrent);
+        PL();
+        profile::profiler_finalize();
+    }
+    done = true;
+    for (auto& t: threads) t.join();
+
+    // Only the thread of the context is recorded.
+    EXPECT_EQ(1u, count_of(profile::profiler_summary(), "test:concurrent"));
+}
+
+TEST(profiler, trace_capacity) {
+    auto ctx = make_serial_context();
+
+    profile::profiler_options opts;
+    opts.trace = true;
+    opts.trace_capacity = 4;
+    profile::profiler_initialize(ctx, opts);
+    for (int i = 0; i<10; ++i) {
+        profile::profiler_enter(profile::profiler_region_id("test:trace:r"+std::to_string(i)));
+        profile::profiler_leave();
+    }
+    profile::profiler_finalize();
+
+    std::stringstream out;
+    profile::write_profiler_trace(out);
+    const auto trace = out.str();
+
+    // Only the last four regions are kept, oldest first.
+    EXPECT_EQ(4u, count_substr(trace, "\"ph\": \"X\""));
+    EXPECT_EQ(std::string::npos, trace.find("test:trace:r5\""));
+    auto first = trace.find("test:trace:r6\"");
+    auto last = trace.find("test:trace:r9\"");
+    ASSERT_NE(std::string::npos, first);
+    ASSERT_NE(std::string::npos, last);
+    EXPECT_LT(first, last);
+
+    // Without trace, nothing is recorded.
+    profile::profiler_initialize(ctx);
+    PE(test:trace:none);
+    PL();
+    profile::profiler_finalize();
+    out.str("");
+    profile::write_profiler_trace(out);
+    EXPECT_EQ(0u, count_substr(out.str(), "\"ph\": \"X\""));
+}
+
+TEST(profiler, counters) {
+    auto ctx = make_serial_context();
+
+    profile::profiler_options opts;
+    opts.counters = true;
+    profile::profiler_initialize(ctx, opts);
+    volatile double x = 0;
+    PE(test:counters:work);
+    for (int i = 0; i<100000; ++i) x = x + i;
+    PL();
+    profile::profiler_finalize();
+
+    auto p = profile::profiler_summary();
+    if (p.counter_names.empty()) {
+        GTEST_SKIP() << "hardware counters not readable from user space";
+    }
+    auto it = std::find(p.names.begin(), p.names.end(), "test:counters:work");
+    ASSERT_NE(p.names.end(), it);
+    auto instr = std::find(p.counter_names.begin(), p.counter_names.end(), "INSTR") - p.counter_names.begin();
+    EXPECT_GT(p.counters[it - p.names.begin()][instr], 100000u);
+}
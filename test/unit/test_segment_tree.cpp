@@ -63,6 +63,36 @@ TEST(segment_tree, invalid_append) {
     EXPECT_THROW(tree.append(2, mp{0,0,1,1}, 1), arb::invalid_segment_parent);
 }
 
+TEST(segment_tree, bulk_append) {
+    using mp = arb::mpoint;
+    using arb::mnpos;
+
+    std::vector<arb::msize_t> parents = {mnpos, 0, 1, 1};
+    std::vector<mp> prox = {{0,0,0,1}, {0,0,1,1}, {0,0,2,1}, {0,0,2,1}};
+    std::vector<mp> dist = {{0,0,1,1}, {0,0,2,1}, {1,0,2,1}, {-1,0,2,1}};
+    std::vector<int> tags = {1, 3, 3, 2};
+
+    arb::segment_tree expected;
+    for (auto i: {0, 1, 2, 3}) expected.append(parents[i], prox[i], dist[i], tags[i]);
+
+    arb::segment_tree tree;
+    EXPECT_EQ(3u, tree.append(4, parents.data(), prox.data(), dist.data(), tags.data()));
+    EXPECT_EQ(expected, tree);
+    EXPECT_TRUE(tree.is_fork(1));
+    EXPECT_TRUE(tree.is_terminal(3));
+
+    // Parents refer to the segments already in the tree, too.
+    std::vector<arb::msize_t> more = {3, 4};
+    EXPECT_EQ(5u, tree.append(2, more.data(), prox.data(), dist.data(), tags.data()));
+    EXPECT_EQ(3u, tree.parents()[4]);
+    EXPECT_EQ(4u, tree.parents()[5]);
+
+    // An invalid parent appends nothing.
+    std::vector<arb::msize_t> bad = {0, 7};
+    EXPECT_THROW(tree.append(2, bad.data(), prox.data(), dist.data(), tags.data()), arb::invalid_segment_parent);
+    EXPECT_EQ(6u, tree.size());
+}
+
 // Generate some random morphologies of different sizes, and verify that
 // the correct tree is constructed.
 TEST(segment_tree, fuzz) {
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 
-#include <vector>
 #include <any>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
 
+#include <arbor/arbexcept.hpp>
 #include <arbor/cable_cell.hpp>
 #include <arbor/common_types.hpp>
 #include <arbor/context.hpp>
@@ -202,3 +208,112 @@ TEST(simulation, restart) {
         }
     }
 }
+
+TEST(simulation, update_connections) {
+    double delay = 10;
+    unsigned n = 5;
+    lif_chain rec(n, delay, explicit_schedule_from_milliseconds(std::vector<double>{1.}));
+
+    auto ctx = n_thread_context(4);
+    simulation sim(rec, ctx, partition_load_balance(rec, ctx));
+    EXPECT_EQ(delay, sim.min_delay());
+
+    // Bypass cell 2: cell 3 is driven directly by cell 0 with a shorter delay.
+    double short_delay = 4;
+    connection_delta delta;
+    delta.remove(3, {2, "src"}, {"tgt"});
+    delta.add(3, cell_connection({0, "src"}, {"tgt"}, lif_chain::weight_, short_delay*U::ms));
+    sim.update_connections(delta);
+    EXPECT_EQ(short_delay, sim.min_delay());
+
+    std::vector<spike> collected;
+    sim.set_global_spike_callback([&](const std::vector<spike>& spikes) {
+        collected.insert(collected.end(), spikes.begin(), spikes.end());
+    });
+    sim.run(40*U::ms, 0.01*U::ms);
+
+    std::vector<double> expected_times = {1., 1.+delay, 1.+2*delay, 1.+short_delay, 1.+short_delay+delay};
+    ASSERT_EQ(n, collected.size());
+    util::sort_by(collected, [](const spike& s) { return s.source; });
+    for (unsigned i = 0; i<n; ++i) {
+        EXPECT_EQ(i, collected[i].source.gid);
+        EXPECT_DOUBLE_EQ(expected_times[i], collected[i].time);
+    }
+
+    // Removing the last connection with the minimum delay restores the original minimum.
+    connection_delta undo;
+    undo.remove(3, {0, "src"}, {"tgt"});
+    undo.add(3, cell_connection({2, "src"}, {"tgt"}, lif_chain::weight_, delay*U::ms));
+    sim.update_connections(undo);
+    EXPECT_EQ(delay, sim.min_delay());
+
+    connection_delta bad_target;
+    bad_target.add(n, cell_connection({0, "src"}, {"tgt"}, 1.0, delay*U::ms));
+    EXPECT_THROW(sim.update_connections(bad_target), bad_connection_target_gid);
+
+    connection_delta bad_label;
+    bad_label.remove(1, {0, "nope"}, {"tgt"});
+    EXPECT_THROW(sim.update_connections(bad_label), bad_connection_label);
+}
+
+// A lif_chain that identifies its connectivity by the delay and counts queries of its connections.
+struct cached_lif_chain: public lif_chain {
+    using lif_chain::lif_chain;
+
+    std::vector<cell_connection> connections_on(cell_gid_type target) const override {
+        ++num_queries;
+        return lif_chain::connections_on(target);
+    }
+
+    std::optional<std::uint64_t> connectivity_fingerprint() const override {
+        return std::hash<double>{}(delay_);
+    }
+
+    mutable std::size_t num_queries = 0;
+};
+
+TEST(simulation, connection_cache) {
+    auto cache = std::filesystem::temp_directory_path()/"arbor-test-simulation-connection-cache";
+    auto cache_file = cache;
+    cache_file += ".0";
+    std::filesystem::remove(cache_file);
+
+    auto ctx = make_context();
+    auto spikes_of = [&](const recipe& rec) {
+        simulation sim(rec, ctx, partition_load_balance(rec, ctx), 0, cache);
+        std::vector<spike> collected;
+        sim.set_global_spike_callback([&](const std::vector<spike>& spikes) {
+            collected.insert(collected.end(), spikes.begin(), spikes.end());
+        });
+        sim.run(50*U::ms, 0.01*U::ms);
+        util::sort_by(collected, [](const spike& s) { return s.source; });
+        return std::make_pair(sim.min_delay(), collected);
+    };
+
+    auto triggers = explicit_schedule_from_milliseconds(std::vector<double>{1.});
+    cached_lif_chain cold(4, 10, triggers);
+    auto built = spikes_of(cold);
+    EXPECT_LT(0u, cold.num_queries);
+    EXPECT_TRUE(std::filesystem::exists(cache_file));
+
+    // A warm cache does not query the connections.
+    cached_lif_chain warm(4, 10, triggers);
+    auto loaded = spikes_of(warm);
+    EXPECT_EQ(0u, warm.num_queries);
+    EXPECT_EQ(built, loaded);
+    EXPECT_EQ(10, loaded.first);
+    EXPECT_EQ(4u, loaded.second.size());
+
+    // A change of the fingerprint invalidates the cache.
+    cached_lif_chain faster(4, 5, triggers);
+    auto rebuilt = spikes_of(faster);
+    EXPECT_LT(0u, faster.num_queries);
+    EXPECT_EQ(5, rebuilt.first);
+    EXPECT_DOUBLE_EQ(1+3*5, rebuilt.second.back().time);
+
+    // Without a fingerprint, the cache is not used.
+    std::filesystem::remove(cache_file);
+    lif_chain plain(4, 10, triggers);
+    EXPECT_EQ(built, spikes_of(plain));
+    EXPECT_FALSE(std::filesystem::exists(cache_file));
+}
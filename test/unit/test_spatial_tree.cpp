@@ -111,6 +111,32 @@ private:
             }
         }
 
+        // check radius queries against brute force
+        for (const double radius: {0.0, 1.0, 5.0, 30.0}) {
+            for (const auto& center: {std::array<double, DIM>{}, box_min, box_max}) {
+                std::vector<data_point<DIM>> ref;
+                for (const auto& d: data) {
+                    double dist2 = 0.0;
+                    for (std::size_t i = 0; i < DIM; ++i) {
+                        dist2 += (d.point[i] - center[i]) * (d.point[i] - center[i]);
+                    }
+                    if (dist2 <= radius * radius) ref.emplace_back(d);
+                }
+
+                std::vector<data_point<DIM>> tree_data;
+                tree.radius_for_each(
+                    center, radius, [&](const data_point<DIM>& d) { tree_data.emplace_back(d); });
+                ASSERT_EQ(ref.size(), tree_data.size());
+
+                std::sort(ref.begin(), ref.end());
+                std::sort(tree_data.begin(), tree_data.end());
+                for (std::size_t i = 0; i < ref.size(); ++i) {
+                    ASSERT_EQ(ref[i].id, tree_data[i].id);
+                    ASSERT_EQ(ref[i].point, tree_data[i].point);
+                }
+            }
+        }
+
         // check contents within each box
         for (auto& box: boxes) {
             std::vector<data_point<DIM>> tree_data;
@@ -146,6 +172,30 @@ std::string param_type_names(
 
 TEST_P(st_test, param) { test_spatial_tree(); }
 
+TEST(spatial_tree, for_radius) {
+    using tree_type = spatial_tree<data_point<3>, 3>;
+
+    bounding_box_data<3> box(1, 2000, {0.0, 0.0, 0.0}, {100.0, 100.0, 100.0});
+    auto location = [](const data_point<3>& d) { return d.point; };
+
+    // nodes are not split below the radius
+    const auto coarse = tree_type::for_radius(1000.0, box.data, location);
+    EXPECT_EQ(1u, coarse.num_nodes());
+    EXPECT_EQ(box.data.size(), coarse.size());
+
+    const auto fine = tree_type::for_radius(5.0, box.data, location);
+    EXPECT_LT(1u, fine.num_nodes());
+
+    std::size_t count = 0;
+    fine.radius_for_each({50.0, 50.0, 50.0}, 200.0, [&](const data_point<3>&) { ++count; });
+    EXPECT_EQ(box.data.size(), count);
+
+    // identical points must not be split indefinitely
+    std::vector<data_point<3>> same(100, data_point<3>{0, {1.0, 2.0, 3.0}});
+    const auto degenerate = tree_type::for_radius(0.0, same, location);
+    EXPECT_EQ(1u, degenerate.num_nodes());
+}
+
 INSTANTIATE_TEST_SUITE_P(spatial_tree,
     st_test,
     ::testing::Combine(::testing::Values(1, 2, 3),
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <arbor/arbexcept.hpp>
+#include <arbor/spike.hpp>
+
+#include "communication/gathered_vector.hpp"
+#include "communication/spike_packing.hpp"
+
+using namespace arb;
+
+TEST(spike_packing, round_trip) {
+    const time_type res = 1e-6;
+    std::vector<spike> spikes = {
+        {{0, 0}, 10.25},
+        {{0, 3}, 10.0},
+        {{7, 0}, 10.4999993},
+        {{7, 0}, 10.125},
+        {{200000, 1}, 10.3},
+    };
+
+    auto packed = pack_spikes(spikes, res);
+    // Substantially smaller than the raw 16 bytes per spike.
+    EXPECT_LT(packed.size(), spikes.size()*sizeof(spike)/2);
+
+    std::vector<spike> out;
+    unpack_spikes(packed.data(), packed.data()+packed.size(), res, out);
+    ASSERT_EQ(spikes.size(), out.size());
+    for (std::size_t i = 0; i<spikes.size(); ++i) {
+        EXPECT_EQ(spikes[i].source, out[i].source);
+        EXPECT_NEAR(spikes[i].time, out[i].time, res);
+    }
+}
+
+TEST(spike_packing, unsorted) {
+    std::vector<spike> spikes = {{{5, 2}, 1.}, {{1, 0}, 2.}, {{5, 0}, 3.}};
+
+    auto packed = pack_spikes(spikes, 1e-3);
+    std::vector<spike> out;
+    unpack_spikes(packed.data(), packed.data()+packed.size(), 1e-3, out);
+
+    std::vector<spike> expected = {{{1, 0}, 2.}, {{5, 0}, 3.}, {{5, 2}, 1.}};
+    EXPECT_EQ(expected, out);
+}
+
+TEST(spike_packing, full_times) {
+    // Disabled or overflowing offsets keep times exact.
+    std::vector<spike> spikes = {{{1, 0}, 0.1}, {{2, 0}, 1e7 + 1./3}};
+    for (auto res: {0., 1e-6}) {
+        auto packed = pack_spikes(spikes, res);
+        std::vector<spike> out;
+        unpack_spikes(packed.data(), packed.data()+packed.size(), res, out);
+        EXPECT_EQ(spikes, out);
+    }
+}
+
+TEST(spike_packing, gathered) {
+    const time_type res = 1e-3;
+    std::vector<std::vector<spike>> ranks = {
+        {{{0, 0}, 1.}, {{1, 0}, 1.5}},
+        {},
+        {{{9, 4}, 1.25}},
+    };
+
+    std::vector<char> bytes;
+    std::vector<unsigned> partition = {0};
+    for (const auto& r: ranks) {
+        auto p = pack_spikes(r, res);
+        bytes.insert(bytes.end(), p.begin(), p.end());
+        partition.push_back(bytes.size());
+    }
+
+    auto g = unpack_spikes(gathered_vector<char>(std::move(bytes), std::move(partition)), res);
+    EXPECT_EQ((std::vector<unsigned>{0, 2, 2, 3}), g.partition());
+    std::vector<spike> expected = {{{0, 0}, 1.}, {{1, 0}, 1.5}, {{9, 4}, 1.25}};
+    EXPECT_EQ(expected, g.values());
+}
+
+TEST(spike_packing, truncated) {
+    std::vector<spike> spikes = {{{3, 1}, 2.}};
+    auto packed = pack_spikes(spikes, 1e-3);
+    std::vector<spike> out;
+    EXPECT_THROW(unpack_spikes(packed.data(), packed.data()+packed.size()-1, 1e-3, out), arbor_internal_error);
+}
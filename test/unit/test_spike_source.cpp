@@ -142,3 +142,51 @@ TEST(spike_source, multiple) {
                      explicit_schedule_from_milliseconds(std::vector{0.3, 2.3, 4.7})};
     test_seq(seqs);
 }
+
+// Test that the Poisson trains generated in bulk depend neither on the epochs
+// nor on the other cells of the group, and that they are reproduced by reset.
+TEST(spike_source, poisson_source) {
+    auto src = poisson_source{2*arb::units::kHz, 42, 1*arb::units::ms, 90*arb::units::ms};
+    ss_recipe rec(3u, spike_source_cell("src", std::vector{src}));
+    cell_label_range srcs, tgts;
+
+    auto train = [](const std::vector<spike>& spikes, cell_gid_type gid) {
+        std::vector<time_type> ts;
+        for (auto& s: spikes) {
+            if (s.source.gid==gid) ts.push_back(s.time);
+        }
+        return ts;
+    };
+
+    spike_source_cell_group all({0, 1, 2}, rec, srcs, tgts);
+    epoch ep(0, 0., 100.);
+    all.advance(ep, 1, {});
+    auto spikes = all.spikes();
+
+    spike_source_cell_group one({1}, rec, srcs, tgts);
+    std::vector<time_type> split;
+    time_type t0 = 0;
+    for (auto t1: {10., 37., 100.}) {
+        one.advance(epoch(0, t0, t1), 1, {});
+        t0 = t1;
+        auto ts = spike_times(one.spikes());
+        split.insert(split.end(), ts.begin(), ts.end());
+        one.clear_spikes();
+    }
+    EXPECT_EQ(train(spikes, 1), split);
+
+    for (cell_gid_type gid: {0, 1, 2}) {
+        auto ts = train(spikes, gid);
+        // Expect 178 spikes per cell.
+        EXPECT_LT(100u, ts.size());
+        EXPECT_GT(260u, ts.size());
+        EXPECT_TRUE(std::is_sorted(ts.begin(), ts.end()));
+        EXPECT_LE(1., ts.front());
+        EXPECT_GT(90., ts.back());
+    }
+    EXPECT_NE(train(spikes, 0), train(spikes, 1));
+
+    all.reset();
+    all.advance(ep, 1, {});
+    EXPECT_EQ(spikes, all.spikes());
+}
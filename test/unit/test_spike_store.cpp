@@ -1,31 +1,35 @@
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <arbor/spike.hpp>
 #include <arborenv/default_env.hpp>
 
 #include "execution_context.hpp"
-#include "thread_private_spike_store.hpp"
+#include "group_spike_store.hpp"
 
 using arb::spike;
 
-TEST(spike_store, insert)
+TEST(group_spike_store, set)
 {
-    using store_type = arb::thread_private_spike_store;
+    using store_type = arb::group_spike_store;
 
     arb::execution_context context({arbenv::default_concurrency(), -1});
-    store_type store(context.thread_pool);
+    store_type store(2, context.thread_pool);
 
-    // insert 3 spike events and check that they were inserted correctly
-    store.insert({
+    // Spikes of a group are sorted by source, then time.
+    store.set(0, {
+        {{2,4}, 1.0f},
         {{0,0}, 0.0f},
-        {{1,2}, 0.5f},
-        {{2,4}, 1.0f}
+        {{1,2}, 0.5f}
     });
 
     {
-        EXPECT_EQ(store.get().size(), 3u);
+        auto spikes = store.gather();
+        EXPECT_EQ(spikes.size(), 3u);
         auto i = 0u;
-        for (auto& spike : store.get()) {
+        for (auto& spike : spikes) {
             EXPECT_EQ(spike.source.gid,   i);
             EXPECT_EQ(spike.source.index, 2*i);
             EXPECT_EQ(spike.time, float(i)/2.f);
@@ -33,60 +37,70 @@ TEST(spike_store, insert)
         }
     }
 
-    // insert another 3 events, then check that they were appended to the
-    // original three events correctly
-    store.insert({
+    // Setting a group again replaces its spikes, leaving the others.
+    store.set(1, {
         {{3,6},  1.5f},
         {{4,8},  2.0f},
         {{5,10}, 2.5f}
     });
+    store.set(0, {{{0,0}, 0.0f}});
 
     {
-        EXPECT_EQ(store.get().size(), 6u);
-        auto i = 0u;
-        for (auto& spike : store.get()) {
-            EXPECT_EQ(spike.source.gid,   i);
-            EXPECT_EQ(spike.source.index, 2*i);
-            EXPECT_EQ(spike.time, float(i)/2.f);
-            ++i;
+        auto spikes = store.gather();
+        EXPECT_EQ(spikes.size(), 4u);
+        EXPECT_EQ(spikes[0].source.gid, 0u);
+        for (auto i = 1u; i<spikes.size(); ++i) {
+            EXPECT_EQ(spikes[i].source.gid,   i+2);
+            EXPECT_EQ(spikes[i].source.index, 2*(i+2));
+            EXPECT_EQ(spikes[i].time, float(i+2)/2.f);
         }
     }
 }
 
-TEST(spike_store, clear)
+TEST(group_spike_store, clear)
 {
-    using store_type = arb::thread_private_spike_store;
+    using store_type = arb::group_spike_store;
 
     arb::execution_context context({arbenv::default_concurrency(), -1});
-    store_type store(context.thread_pool);
+    store_type store(2, context.thread_pool);
 
-    // insert 3 spike events
-    store.insert({
-        {{0,0}, 0.0f}, {{1,2}, 0.5f}, {{2,4}, 1.0f}
-    });
-    EXPECT_EQ(store.get().size(), 3u);
+    store.set(0, {{{0,0}, 0.0f}, {{1,2}, 0.5f}});
+    store.set(1, {{{2,4}, 1.0f}});
+    EXPECT_EQ(store.gather().size(), 3u);
     store.clear();
-    EXPECT_EQ(store.get().size(), 0u);
+    EXPECT_EQ(store.gather().size(), 0u);
+    EXPECT_EQ(store.num_groups(), 2u);
 }
 
-TEST(spike_store, gather)
+TEST(group_spike_store, gather)
 {
-    using store_type = arb::thread_private_spike_store;
-
-    arb::execution_context context({arbenv::default_concurrency(), -1});
-    store_type store(context.thread_pool);
-
-    std::vector<spike> spikes =
-        { {{0,0}, 0.0f}, {{1,2}, 0.5f}, {{2,4}, 1.0f} };
-
-    store.insert(spikes);
-    auto gathered_spikes = store.gather();
-
-    EXPECT_EQ(gathered_spikes.size(), spikes.size());
-
-    for(auto i=0u; i<spikes.size(); ++i) {
-        EXPECT_EQ(spikes[i].source.gid, gathered_spikes[i].source.gid);
-        EXPECT_EQ(spikes[i].source.index, gathered_spikes[i].source.index);
-        EXPECT_EQ(spikes[i].time, gathered_spikes[i].time);
+    using store_type = arb::group_spike_store;
+
+    // Interleaved gids across groups, unsorted within some groups.
+    std::vector<std::vector<spike>> spikes = {
+        { {{0,0}, 1.0}, {{3,0}, 0.5}, {{0,0}, 0.5} },
+        {},
+        { {{1,0}, 2.0}, {{4,1}, 0.0}, {{4,0}, 3.0} },
+        { {{2,0}, 0.25} },
+        { {{5,0}, 0.0}, {{6,0}, 1.0} },
+    };
+
+    std::vector<spike> expected;
+    for (auto& s: spikes) expected.insert(expected.end(), s.begin(), s.end());
+    std::sort(expected.begin(), expected.end());
+
+    for (int n_thread: {1, 4}) {
+        arb::execution_context context({n_thread, -1});
+        store_type store(spikes.size(), context.thread_pool);
+        EXPECT_EQ(spikes.size(), store.num_groups());
+
+        // Fill in reverse order, as threads might.
+        for (auto i = spikes.size(); i--;) store.set(i, spikes[i]);
+        EXPECT_EQ(expected, store.gather());
+        // Gather leaves the buffers intact.
+        EXPECT_EQ(expected, store.gather());
+
+        store.clear();
+        EXPECT_TRUE(store.gather().empty());
     }
 }
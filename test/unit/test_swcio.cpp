@@ -1,4 +1,7 @@
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -7,6 +10,7 @@
 #include <arbor/morph/morphology.hpp>
 #include <arbor/morph/primitives.hpp>
 
+#include <arborio/morphology_cache.hpp>
 #include <arborio/swcio.hpp>
 
 #include <gtest/gtest.h>
@@ -796,6 +800,97 @@ TEST(swc_parser, not_neuron_compliant) {
     }
 }
 
+TEST(swc_parser, number_formats) {
+    // Numbers are read as by stream extraction, including those not parsed on the fast path.
+    std::string text =
+        "1 1 -0.5 +2.25e2 1.5E-3 0.30000000000000004 -1\n"
+        "2\t1 12345678901234567890 1e-30 .5 7 1\r\n"
+        "+3 1 0 0 0 1 2";
+    auto expected = std::vector<swc_record>{
+        {1, 1, -0.5, 225, 1.5e-3, 0.30000000000000004, -1},
+        {2, 1, 12345678901234567890., 1e-30, 0.5, 7, 1},
+        {3, 1, 0, 0, 0, 1, 2}};
+
+    EXPECT_EQ(expected, parse_swc(text).records());
+    std::istringstream is(text);
+    EXPECT_EQ(expected, parse_swc(is).records());
+}
+
+TEST(segment_tree_cache, round_trip) {
+    std::string text =
+        "1 1 0.1 0.2 0.3 0.4 -1\n"
+        "2 1 0.3 0.4 0.5 0.3 1\n"
+        "3 3 0.2 0.6 0.8 0.2 2\n"
+        "4 2 0.2 0.8 0.6 0.3 2\n";
+    auto tree = load_swc_arbor(parse_swc(text)).segment_tree;
+
+    std::stringstream ss;
+    write_segment_tree(ss, tree);
+    EXPECT_EQ(tree, read_segment_tree(ss));
+
+    std::stringstream empty;
+    write_segment_tree(empty, arb::segment_tree{});
+    EXPECT_TRUE(read_segment_tree(empty).empty());
+
+    std::stringstream truncated(ss.str().substr(0, 100));
+    EXPECT_THROW(read_segment_tree(truncated), segment_tree_cache_error);
+    std::stringstream garbage(std::string(256, 'x'));
+    EXPECT_THROW(read_segment_tree(garbage), segment_tree_cache_error);
+
+    // A corrupt segment count is rejected before allocating for it.
+    std::string huge = ss.str();
+    const std::uint64_t n_huge = std::uint64_t(1) << 60;
+    std::memcpy(&huge[16], &n_huge, sizeof n_huge);
+    std::stringstream corrupt(huge);
+    EXPECT_THROW(read_segment_tree(corrupt), segment_tree_cache_error);
+
+    // Invalid trees are reported as cache errors, too: the parent of the
+    // first segment is found at offset 64.
+    std::string orphan = ss.str();
+    const arb::msize_t bad_parent = 3;
+    std::memcpy(&orphan[64], &bad_parent, sizeof bad_parent);
+    std::stringstream invalid(orphan);
+    EXPECT_THROW(read_segment_tree(invalid), segment_tree_cache_error);
+}
+
+TEST(segment_tree_cache, files) {
+    auto dir = std::filesystem::temp_directory_path()/"arbor-test-segment-tree-cache";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    std::string text =
+        "1 1 0.1 0.2 0.3 0.4 -1\n"
+        "2 1 0.3 0.4 0.5 0.3 1\n"
+        "3 3 0.2 0.6 0.8 0.2 2\n";
+    std::ofstream(dir/"a.swc") << text;
+    std::ofstream(dir/"b.swc") << text << "4 2 0.2 0.8 0.6 0.3 2\n";
+    std::ofstream(dir/"bad.swc") << text << "4 2 0.2 0.8 0.6 0.3 7\n";
+
+    auto morphs = load_swc_arbor_files({dir/"a.swc", dir/"b.swc"}, 2);
+    ASSERT_EQ(2u, morphs.size());
+    EXPECT_EQ(load_swc_arbor(parse_swc(text)).segment_tree, morphs[0].segment_tree);
+    EXPECT_EQ(3u, morphs[1].segment_tree.size());
+
+    // Trees are restored from memory mapped files, one at a time or in bulk.
+    std::vector<std::filesystem::path> caches;
+    for (auto i: {0u, 1u}) {
+        caches.push_back(dir/("tree" + std::to_string(i) + ".arbmorph"));
+        save_segment_tree(caches.back(), morphs[i].segment_tree);
+        EXPECT_EQ(morphs[i].segment_tree, load_segment_tree(caches.back()));
+    }
+    auto trees = load_segment_trees(caches);
+    ASSERT_EQ(2u, trees.size());
+    EXPECT_EQ(morphs[0].segment_tree, trees[0]);
+    EXPECT_EQ(morphs[1].segment_tree, trees[1]);
+
+    // Failures are reported for the first failing file in the list.
+    EXPECT_THROW(load_swc_arbor_files({dir/"a.swc", dir/"bad.swc", dir/"none.swc"}), swc_error);
+    EXPECT_THROW(load_segment_trees({caches[0], dir/"none.arbmorph", dir/"a.swc"}), arb::file_not_found_error);
+    EXPECT_THROW(load_segment_tree(dir/"a.swc"), segment_tree_cache_error);
+
+    std::filesystem::remove_all(dir);
+}
+
 // hipcc bug in reading DATADIR
 #ifndef ARB_HIP
 TEST(swc_parser, from_neuromorpho)
@@ -810,5 +905,8 @@ TEST(swc_parser, from_neuromorpho)
 
     auto data = parse_swc(fid);
     EXPECT_EQ(5799u, data.records().size());
+
+    // Loading from the path parses the text without a stream.
+    EXPECT_EQ(load_swc_neuron(data).segment_tree, load_swc_neuron(fname).segment_tree);
 }
 #endif
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <arbor/context.hpp>
+#include <arbor/lif_cell.hpp>
+#include <arbor/load_balance.hpp>
+#include <arbor/recipe.hpp>
+#include <arbor/schedule.hpp>
+#include <arbor/simulation.hpp>
+#include <arbor/spike.hpp>
+#include <arbor/spike_source_cell.hpp>
+
+#include "distributed_context.hpp"
+#include "execution_context.hpp"
+#include "label_resolution.hpp"
+
+using namespace arb;
+
+namespace U = arb::units;
+using namespace U::literals;
+
+namespace {
+// Run f(rank, context) concurrently on all ranks.
+template <typename Context, typename F>
+void run_ranks(const std::vector<Context>& contexts, F&& f) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i<(int)contexts.size(); ++i) {
+        threads.emplace_back([&, i] { f(i, contexts[i]); });
+    }
+    for (auto& t: threads) t.join();
+}
+}
+
+TEST(thread_context, size_rank) {
+    auto ctxs = make_thread_distributed_contexts(3);
+    ASSERT_EQ(3u, ctxs.size());
+    for (int i = 0; i<3; ++i) {
+        EXPECT_EQ(3, ctxs[i]->size());
+        EXPECT_EQ(i, ctxs[i]->id());
+        EXPECT_EQ("threads", ctxs[i]->name());
+    }
+}
+
+TEST(thread_context, collectives) {
+    const int n = 4;
+    auto ctxs = make_thread_distributed_contexts(n);
+
+    run_ranks(ctxs, [&](int r, const distributed_context_handle& ctx) {
+        for (int k = 0; k<10; ++k) {
+            EXPECT_EQ(0, ctx->min(r));
+            EXPECT_EQ(n-1, ctx->max(r));
+            EXPECT_EQ(n*(n-1)/2, ctx->sum(r));
+            EXPECT_EQ(1.5*n, ctx->sum(1.5));
+
+            auto g = ctx->gather(std::to_string(r), 1);
+            if (r==1) EXPECT_EQ((std::vector<std::string>{"0", "1", "2", "3"}), g);
+            else EXPECT_TRUE(g.empty());
+        }
+    });
+}
+
+TEST(thread_context, gather_spikes) {
+    const int n = 3;
+    auto ctxs = make_thread_distributed_contexts(n);
+
+    run_ranks(ctxs, [&](int r, const distributed_context_handle& ctx) {
+        // Rank r contributes r spikes.
+        std::vector<spike> local;
+        for (int i = 0; i<r; ++i) local.emplace_back(cell_member_type{cell_gid_type(10*r+i), 0u}, 0.5*r);
+
+        auto g = ctx->gather_spikes(local);
+        EXPECT_EQ((std::vector<unsigned>{0, 0, 1, 3}), g.partition());
+        ASSERT_EQ(3u, g.size());
+        EXPECT_EQ(10u, g.values()[0].source.gid);
+        EXPECT_EQ(21u, g.values()[2].source.gid);
+        EXPECT_EQ(1.0, g.values()[2].time);
+
+        auto gids = ctx->gather_gids({cell_gid_type(r)});
+        EXPECT_EQ((std::vector<cell_gid_type>{0, 1, 2}), gids.values());
+    });
+}
+
+TEST(thread_context, send_recv) {
+    const int n = 4;
+    auto ctxs = make_thread_distributed_contexts(n);
+
+    run_ranks(ctxs, [&](int r, const distributed_context_handle& ctx) {
+        // Pass values around the ring.
+        int value = 100+r, received = -1;
+        auto req = ctx->send_recv_nonblocking(1, &received, (r+n-1)%n, 1, &value, (r+1)%n, 7);
+        req.finalize();
+        EXPECT_EQ(100+(r+n-1)%n, received);
+    });
+}
+
+TEST(thread_context, label_requests) {
+    const int n = 3;
+    auto ctxs = make_thread_distributed_contexts(n);
+
+    run_ranks(ctxs, [&](int r, const distributed_context_handle& ctx) {
+        // Rank r holds cells 10r and 10r+1, with labels "a" and "b".
+        cell_gid_type g = 10*r;
+        cell_labels_and_gids local({{2, 1}, {"a", "b", "a"}, {{0, 1}, {1, 3}, {0, 2}}}, {g, g+1});
+
+        // Request label "b" of cell 0 and label "a" of the first cell of the next
+        // rank, as well as an unknown label.
+        cell_gid_type next = 10*((r+1)%n);
+        std::vector<label_resolution_map::key_type> required = {{0, hash_value("b")},
+                                                                {next, hash_value("a")},
+                                                                {next, hash_value("c")}};
+        auto map = make_resolution_map(local, required, [](cell_gid_type gid) { return int(gid/10); }, *ctx);
+
+        EXPECT_EQ(2u, map.size());
+        EXPECT_EQ((std::vector<lid_range>{{1, 3}}), map.at(0, "b").ranges);
+        EXPECT_EQ((std::vector<lid_range>{{0, 1}}), map.at(next, "a").ranges);
+        EXPECT_EQ(0u, map.count(next, "c"));
+        EXPECT_EQ(0u, map.count(next+1, "a"));
+    });
+}
+
+namespace {
+// Ring of LIF cells, driven by a spike source.
+struct lif_ring_recipe: recipe {
+    explicit lif_ring_recipe(cell_size_type n): n_(n) {}
+
+    cell_size_type num_cells() const override { return n_+1; }
+
+    cell_kind get_cell_kind(cell_gid_type gid) const override {
+        return gid? cell_kind::lif: cell_kind::spike_source;
+    }
+
+    std::vector<cell_connection> connections_on(cell_gid_type gid) const override {
+        if (!gid) return {};
+        std::vector<cell_connection> conns = {{{gid-1, "src"}, {"tgt"}, 1000, 1*U::ms}};
+        if (gid==1) conns.push_back({{n_, "src"}, {"tgt"}, 1000, 1*U::ms});
+        return conns;
+    }
+
+    util::unique_any get_cell_description(cell_gid_type gid) const override {
+        if (!gid) return spike_source_cell("src", explicit_schedule_from_milliseconds({0.}));
+        return lif_cell("src", "tgt");
+    }
+
+    cell_size_type n_;
+};
+}
+
+TEST(thread_context, simulation) {
+    lif_ring_recipe rec(12);
+
+    auto run = [&](const context& ctx) {
+        std::vector<spike> spikes;
+        simulation sim(rec, ctx, partition_load_balance(rec, ctx));
+        sim.set_global_spike_callback([&](const std::vector<spike>& s) { spikes.insert(spikes.end(), s.begin(), s.end()); });
+        sim.run(30*U::ms, 0.01*U::ms);
+        std::sort(spikes.begin(), spikes.end());
+        return spikes;
+    };
+
+    auto expected = run(make_context());
+    ASSERT_FALSE(expected.empty());
+
+    auto ctxs = make_thread_contexts(proc_allocation{}, 3);
+    std::vector<std::vector<spike>> result(ctxs.size());
+    run_ranks(ctxs, [&](int r, const context& ctx) {
+        EXPECT_EQ(3u, num_ranks(ctx));
+        result[r] = run(ctx);
+    });
+    for (const auto& spikes: result) EXPECT_EQ(expected, spikes);
+}
@@ -0,0 +1,28 @@
+NEURON {
+    SUFFIX table_test
+}
+
+PARAMETER {
+    q = 2
+}
+
+STATE {
+    s
+}
+
+BREAKPOINT {
+    SOLVE states
+}
+
+DERIVATIVE states {
+    s = rate(v)
+}
+
+INITIAL {
+    s = rate(v)
+}
+
+FUNCTION rate(v) {
+    TABLE FROM -100 TO 100 WITH 200
+    rate = q*v
+}